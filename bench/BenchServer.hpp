@@ -0,0 +1,158 @@
+#pragma once
+
+#include <array>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libmcstatus/McPacket.hpp"
+
+// Fake Minecraft server for benchmarks, built to be as cheap per query as possible, so the benchmark measures the
+// client. The status response frame is encoded once up front, and requests are parsed in place
+class BenchServer {
+public:
+	explicit BenchServer(const std::string& status_json, std::size_t threads = 1)
+	    : status_frame{encode_status(status_json)}, acceptor{io_context, {boost::asio::ip::address_v4::loopback(), 0}} {
+		acceptor.listen(boost::asio::socket_base::max_listen_connections);
+		boost::asio::co_spawn(io_context, accept_loop(), boost::asio::detached);
+
+		for (std::size_t i = 0; i < threads; ++i) {
+			io_threads.emplace_back([this] { io_context.run(); });
+		}
+	}
+
+	~BenchServer() {
+		io_context.stop();
+
+		for (std::thread& thread : io_threads) {
+			thread.join();
+		}
+	}
+
+	BenchServer(const BenchServer&) = delete;
+	BenchServer& operator=(const BenchServer&) = delete;
+
+	[[nodiscard]] boost::asio::ip::tcp::endpoint endpoint() const {
+		return acceptor.local_endpoint();
+	}
+
+	[[nodiscard]] std::size_t status_size() const {
+		return status_frame.size();
+	}
+
+private:
+	const libmcstatus::McPacket::buffer_t status_frame;
+	boost::asio::io_context io_context;
+	boost::asio::ip::tcp::acceptor acceptor;
+	std::vector<std::thread> io_threads;
+
+	static libmcstatus::McPacket::buffer_t encode_status(const std::string& status_json) {
+		libmcstatus::McPacket packet;
+		packet.write_varint(0);
+		packet.write_utf(status_json);
+		return packet.write_to_buffer();
+	}
+
+	// Decodes the frame at the start of data. Returns the frame size (length prefix included) and packet id, or a size
+	// of 0 if the frame is incomplete
+	static std::pair<std::size_t, std::uint8_t> peek_frame(const std::uint8_t* data, std::size_t size) {
+		std::uint32_t length = 0;
+
+		for (std::size_t i = 0; (i < 3) && (i < size); ++i) {
+			length |= static_cast<std::uint32_t>(data[i] & 0x7F) << (7 * i);
+
+			if ((data[i] & 0x80) == 0) {
+				const std::size_t frame_size = i + 1 + length;
+				if ((length == 0) || (frame_size > size)) {
+					return {0, 0};
+				}
+
+				// All packet ids used here fit into a single byte
+				return {frame_size, data[i + 1]};
+			}
+		}
+
+		return {0, 0};
+	}
+
+	boost::asio::awaitable<void> accept_loop() {
+		while (true) {
+			boost::system::error_code error_code;
+			boost::asio::ip::tcp::socket socket = co_await acceptor.async_accept(
+			    io_context, boost::asio::redirect_error(boost::asio::use_awaitable, error_code));
+
+			if (!error_code) {
+				boost::asio::co_spawn(io_context, session(std::move(socket)), boost::asio::detached);
+			}
+		}
+	}
+
+	boost::asio::awaitable<void> session(boost::asio::ip::tcp::socket socket) {
+		std::array<std::uint8_t, 1024> buffer;
+		std::size_t filled = 0;
+		bool handshake_done = false;
+
+		while (true) {
+			boost::system::error_code error_code;
+			const auto free_space = boost::asio::buffer(buffer.data() + filled, buffer.size() - filled);
+			filled += co_await socket.async_read_some(
+			    free_space, boost::asio::redirect_error(boost::asio::use_awaitable, error_code));
+
+			if (error_code) {
+				co_return;
+			}
+
+			std::size_t offset = 0;
+
+			while (true) {
+				const auto [frame_size, packet_id] = peek_frame(buffer.data() + offset, filled - offset);
+
+				if (frame_size == 0) {
+					break;
+				}
+
+				if (!handshake_done) {
+					handshake_done = true;
+				} else if (packet_id == 0) {
+					co_await boost::asio::async_write(
+					    socket, boost::asio::buffer(status_frame),
+					    boost::asio::redirect_error(boost::asio::use_awaitable, error_code));
+				} else if ((packet_id == 1) && (frame_size == 10)) {
+					// The ping response is the request itself
+					co_await boost::asio::async_write(
+					    socket, boost::asio::buffer(buffer.data() + offset, frame_size),
+					    boost::asio::redirect_error(boost::asio::use_awaitable, error_code));
+				} else {
+					co_return;
+				}
+
+				if (error_code) {
+					co_return;
+				}
+
+				offset += frame_size;
+			}
+
+			// Keep the start of an incomplete frame around. Requests are tiny, so this is rare and cheap
+			std::memmove(buffer.data(), buffer.data() + offset, filled - offset);
+			filled -= offset;
+
+			if (filled == buffer.size()) {
+				co_return;  // Nothing this large is ever sent by a client
+			}
+		}
+	}
+};
@@ -0,0 +1,158 @@
+// Benchmark for parsing status responses. Parses every payload of the corpus over and over and reports the throughput
+// in MB/s of JSON and parsed results/s, per payload and for the corpus as a whole. --parser=view measures
+// JavaStatusView instead of the regular parser, including the copy of the JSON into the buffer the view owns.
+//
+// Usage: libmcstatus_parse_status [--corpus=<directory>] [--duration=<seconds per payload>] [--parser=json|view]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/JavaStatusView.hpp"
+
+using namespace libmcstatus;
+
+namespace {
+
+// Parsing is internal to JavaServer, so reach it the way a subclass would
+class StatusParser : public JavaServer {
+public:
+	using JavaServer::try_parse_status;
+};
+
+struct Payload {
+	std::string name;
+	std::string json;
+};
+
+struct Options {
+	std::filesystem::path corpus{LIBMCSTATUS_CORPUS_DIR};
+	std::chrono::duration<double> duration{1.0};
+	bool view{false};
+};
+
+Options parse_options(int argc, char** argv) {
+	Options options;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+		const std::size_t equals = arg.find('=');
+		const std::string_view name = arg.substr(0, equals);
+		const std::string_view value = (equals == std::string_view::npos) ? "" : arg.substr(equals + 1);
+
+		if (name == "--corpus") {
+			options.corpus = value;
+		} else if (name == "--duration") {
+			options.duration = std::chrono::duration<double>{std::stod(std::string{value})};
+		} else if ((name == "--parser") && ((value == "json") || (value == "view"))) {
+			options.view = value == "view";
+		} else {
+			std::cerr << "Unknown option " << arg << "\n";
+			std::exit(1);
+		}
+	}
+
+	return options;
+}
+
+std::vector<Payload> load_corpus(const std::filesystem::path& directory) {
+	std::vector<Payload> corpus;
+
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{directory}) {
+		if (entry.is_regular_file() && (entry.path().extension() == ".json")) {
+			std::ifstream file{entry.path(), std::ios::binary};
+			corpus.push_back({entry.path().stem().string(),
+			                  std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}}});
+		}
+	}
+
+	std::ranges::sort(corpus, {}, &Payload::name);
+	return corpus;
+}
+
+// Returns the number of online players, or -1 if the payload doesn't parse
+std::int64_t parse(const Payload& payload, bool view) {
+	if (view) {
+		const auto status = JavaStatusView::try_parse(payload.json);
+		return status ? status->online : -1;
+	}
+
+	const auto status = StatusParser::try_parse_status({}, payload.json);
+	return status ? (*status)->players->online : -1;
+}
+
+// Written after every batch, so the parsed results stay observable and can't be optimized away
+volatile std::int64_t sink = 0;
+
+// Returns the average time it takes to parse the payload once. Parses in batches, so reading the clock doesn't show up
+// in the results of the small payloads
+std::chrono::duration<double> run(const Payload& payload, const Options& options) {
+	static constexpr std::uint64_t BATCH{64};
+	std::uint64_t iterations = 0;
+	std::chrono::duration<double> elapsed{};
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while (elapsed < options.duration) {
+		std::int64_t online = 0;
+		for (std::uint64_t i = 0; i < BATCH; ++i) {
+			online += parse(payload, options.view);
+		}
+
+		sink = online;
+		iterations += BATCH;
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	return elapsed / static_cast<double>(iterations);
+}
+
+void print(std::string_view name, std::size_t bytes, std::size_t results, std::chrono::duration<double> time) {
+	const double seconds = time.count();
+
+	std::cout << std::left << std::setw(32) << name << std::right << " bytes=" << std::setw(8) << bytes << std::fixed
+	          << std::setprecision(1) << " MB/s=" << std::setw(8) << (static_cast<double>(bytes) / seconds / 1e6)
+	          << std::setprecision(0) << " results/s=" << std::setw(9) << (static_cast<double>(results) / seconds)
+	          << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	const Options options = parse_options(argc, argv);
+	const std::vector<Payload> corpus = load_corpus(options.corpus);
+
+	if (corpus.empty()) {
+		std::cerr << "No payloads found in " << options.corpus << "\n";
+		return 1;
+	}
+
+	std::size_t total_bytes = 0;
+	std::chrono::duration<double> total_time{};
+
+	for (const Payload& payload : corpus) {
+		if (parse(payload, options.view) < 0) {
+			std::cerr << "Failed to parse " << payload.name << "\n";
+			return 1;
+		}
+
+		const std::chrono::duration<double> time = run(payload, options);
+		print(payload.name, payload.json.size(), 1, time);
+
+		total_bytes += payload.json.size();
+		total_time += time;
+	}
+
+	// One pass over the corpus, every payload parsed once
+	print("corpus", total_bytes, corpus.size(), total_time);
+	return 0;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// Synthetic status payloads of typical shapes and sizes. They are generated deterministically, so results stay
+// comparable between runs
+namespace payloads {
+
+inline std::string base64_filler(std::size_t size) {
+	static constexpr std::string_view ALPHABET{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
+	std::string data;
+	data.reserve(size);
+
+	for (std::size_t i = 0; i < size; ++i) {
+		data.push_back(ALPHABET[(i * 7 + i / 64) % ALPHABET.size()]);
+	}
+
+	return data;
+}
+
+inline std::string favicon(std::size_t size) {
+	return R"("favicon":"data:image/png;base64,)" + base64_filler(size) + "\"";
+}
+
+inline std::string player_sample(std::size_t players) {
+	std::string sample{R"("sample":[)"};
+
+	for (std::size_t i = 0; i < players; ++i) {
+		char uuid[37];
+		std::snprintf(uuid, sizeof(uuid), "%08x-1234-4abc-9def-%012llx", static_cast<std::uint32_t>(i),
+		              (static_cast<unsigned long long>(i) * 0x9E3779B9u) & 0xFFFFFFFFFFFFu);
+
+		sample += (i == 0) ? "" : ",";
+		sample += R"({"name":"Player_)" + std::to_string(i) + R"(","id":")" + uuid + "\"}";
+	}
+
+	return sample + "]";
+}
+
+// Smallest valid response, like a freshly installed vanilla server
+inline std::string minimal() {
+	return R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":0},)"
+	       R"("description":"A Minecraft Server"})";
+}
+
+// Busy server with a player sample, a formatted MOTD and a regular sized icon
+inline std::string typical() {
+	return R"({"version":{"name":"Paper 1.20.4","protocol":765},"players":{"max":500,"online":137,)" +
+	       player_sample(12) +
+	       R"(},"description":{"text":"","extra":[{"text":"Welcome to ","color":"gray"},)"
+	       R"({"text":"Example Network","color":"gold","bold":true},{"text":"\n"},)"
+	       R"({"text":"Survival | Skyblock | Minigames","color":"aqua"}]},"enforcesSecureChat":true,)" +
+	       favicon(6 * 1024) + "}";
+}
+
+// Typical response with an unusually large (64 KiB) icon
+inline std::string large_favicon() {
+	return R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":100,"online":12},)"
+	       R"("description":{"text":"Look at my icon"},)" +
+	       favicon(64 * 1024) + "}";
+}
+
+// Heavily modded Forge server, listing hundreds of mods and network channels
+inline std::string forge_modlist(std::size_t mods = 400) {
+	std::string mod_list;
+	std::string channels;
+
+	for (std::size_t i = 0; i < mods; ++i) {
+		const std::string mod_id = "examplemod" + std::to_string(i);
+
+		mod_list += (i == 0) ? "" : ",";
+		mod_list += R"({"modId":")" + mod_id + R"(","modmarker":"1.20.1-)" + std::to_string(i % 10) + ".0." +
+		            std::to_string(i % 97) + "\"}";
+		channels += (i == 0) ? "" : ",";
+		channels += R"({"res":")" + mod_id + R"(:main","version":"1","required":false})";
+	}
+
+	return R"({"version":{"name":"1.20.1","protocol":763},"players":{"max":64,"online":9},)"
+	       R"("description":{"text":"All the Mods"},"forgeData":{"channels":[)" +
+	       channels + R"(],"mods":[)" + mod_list + R"(],"fmlNetworkVersion":3,"truncated":false},)" +
+	       favicon(4 * 1024) + "}";
+}
+
+inline std::optional<std::string> by_name(std::string_view name) {
+	if (name == "minimal") {
+		return minimal();
+	} else if (name == "typical") {
+		return typical();
+	} else if (name == "large_favicon") {
+		return large_favicon();
+	} else if (name == "forge_modlist") {
+		return forge_modlist();
+	}
+
+	return std::nullopt;
+}
+
+}  // namespace payloads
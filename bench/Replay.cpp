@@ -0,0 +1,73 @@
+// Replays a traffic log recorded with a RecordingTransport through the whole decode pipeline (packet framing and status
+// parsing), without touching the network, and reports the throughput. Profile this to see how the decoder performs on
+// real traffic.
+//
+// Usage: libmcstatus_replay <log file> [--duration=<seconds>]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/TrafficLog.hpp"
+
+using namespace libmcstatus;
+
+int main(int argc, char** argv) {
+	std::string path;
+	std::chrono::duration<double> duration{3.0};
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+
+		if (arg.starts_with("--duration=")) {
+			duration = std::chrono::duration<double>{std::stod(std::string{arg.substr(11)})};
+		} else {
+			path = arg;
+		}
+	}
+
+	std::expected<std::vector<TrafficRecord>, McError> records = TrafficLog::try_read(path);
+	if (path.empty() || !records || records->empty()) {
+		std::cerr << "Usage: libmcstatus_replay <log file> [--duration=<seconds>]\n";
+		return 1;
+	}
+
+	std::uint64_t bytes_per_pass = 0;
+	for (const TrafficRecord& record : *records) {
+		bytes_per_pass += record.received.size();
+	}
+
+	const std::size_t record_count = records->size();
+	const JavaServer server{std::make_shared<ReplayTransport>(std::move(*records))};
+	const RetryPolicy no_retries{.max_attempts = 1};
+	std::uint64_t queries = 0;
+	std::uint64_t failures = 0;
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::chrono::duration<double> elapsed{};
+
+	// Whole passes only, so every record counts equally
+	while (elapsed < duration) {
+		for (std::size_t i = 0; i < record_count; ++i) {
+			failures += server.try_status(std::chrono::seconds{5}, no_retries).has_value() ? 0 : 1;
+		}
+
+		queries += record_count;
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	const double passes = static_cast<double>(queries / record_count);
+	std::cout << "records=" << record_count << std::fixed << std::setprecision(1)
+	          << " MB/s=" << (static_cast<double>(bytes_per_pass) * passes / elapsed.count() / 1e6)
+	          << std::setprecision(0) << " results/s=" << (static_cast<double>(queries) / elapsed.count())
+	          << " failures=" << failures << std::endl;
+
+	return 0;
+}
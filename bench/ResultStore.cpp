@@ -0,0 +1,97 @@
+// Writes a synthetic scan snapshot into a ResultStore file, maps it and times single column queries over it, like
+// "all servers with more than 100 players".
+//
+// Usage: libmcstatus_result_store [--rows=<count>] [--path=<file>]
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/ResultStore.hpp"
+
+using namespace libmcstatus;
+
+namespace {
+
+constexpr std::string_view VERSIONS[] = {"Paper 1.20.4", "Velocity 3.3.0", "1.20.4", "Purpur 1.20.1", "BungeeCord"};
+
+template <typename Func>
+double milliseconds(Func func) {
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	func();
+	return std::chrono::duration<double, std::milli>{std::chrono::steady_clock::now() - start}.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	std::size_t rows = 5'000'000;
+	std::filesystem::path path =
+	    std::filesystem::temp_directory_path() / ("libmcstatus-bench-" + std::to_string(getpid()) + ".store");
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+
+		if (arg.starts_with("--rows=")) {
+			rows = std::stoull(std::string{arg.substr(7)});
+		} else if (arg.starts_with("--path=")) {
+			path = arg.substr(7);
+		} else {
+			std::cerr << "Usage: libmcstatus_result_store [--rows=<count>] [--path=<file>]\n";
+			return 1;
+		}
+	}
+
+	std::minstd_rand rng{42};
+	std::geometric_distribution<std::int64_t> players{0.05};
+	ResultStoreWriter writer;
+	const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+	const double write_ms = milliseconds([&] {
+		JavaServer::JavaServerResponse status;
+		status.players->max = 500;
+		status.version->protocol = 765;
+
+		for (std::size_t row = 0; row < rows; ++row) {
+			status.version->name = VERSIONS[row % std::size(VERSIONS)];
+			status.motd = "Server " + std::to_string(row % 1000);
+			status.players->online = players(rng);
+			writer.append("198.51." + std::to_string(row % 65536) + ":25565", now, status);
+		}
+		writer.write(path);
+	});
+
+	std::expected<ResultStore, McError> store = std::unexpected{McError::bad_frame};
+	const double open_ms = milliseconds([&] { store = ResultStore::try_open(path); });
+	std::filesystem::remove(path);
+
+	if (!store) {
+		std::cerr << "Failed to read back " << path << '\n';
+		return 1;
+	}
+
+	std::size_t busy = 0;
+	const double online_ms = milliseconds([&] {
+		busy = ResultStore::filter(store->online(), [](std::int64_t online) { return online > 100; }).size();
+	});
+
+	std::size_t paper = 0;
+	const double version_ms = milliseconds([&] {
+		const std::optional<std::uint32_t> id = store->find_version("Paper 1.20.4");
+		paper = ResultStore::filter(store->version_ids(), [&](std::uint32_t version) { return version == id; }).size();
+	});
+
+	std::cout << "rows=" << store->size() << std::fixed << std::setprecision(1) << " write_ms=" << write_ms
+	          << " open_ms=" << open_ms << " online>100: rows=" << busy << " ms=" << online_ms
+	          << " version=Paper 1.20.4: rows=" << paper << " ms=" << version_ms << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,303 @@
+// End-to-end loopback throughput benchmark. Starts an in-process fake server and hammers it with an increasing number
+// of concurrent queries, reporting the throughput per client core and the latency distribution. The queries are made
+// by as many threads calling the blocking API (blocking), by one thread calling try_status_raw_batch() with that
+// concurrency (batch), or by as many coroutines on one thread calling the async API (async). Batch and async parse
+// every status as well, so all three do the same work.
+//
+// Usage: libmcstatus_throughput [--payload=minimal|typical|large_favicon|forge_modlist|all] [--mode=status|ping]
+//                               [--client=blocking|batch|async|all] [--concurrency=1,2,4,8] [--duration=<seconds>]
+//                               [--server-threads=<n>]
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "BenchServer.hpp"
+#include "libmcstatus/Histogram.hpp"
+#include "libmcstatus/JavaServer.hpp"
+#include "Payloads.hpp"
+
+using namespace libmcstatus;
+
+namespace {
+
+enum class Mode { status, ping };
+enum class Client { blocking, batch, async };
+
+struct Options {
+	std::vector<std::string> payloads{"minimal", "typical", "large_favicon", "forge_modlist"};
+	Mode mode{Mode::status};
+	std::vector<Client> clients{Client::blocking, Client::batch, Client::async};
+	std::vector<std::size_t> concurrency{1, 2, 4, 8};
+	std::chrono::duration<double> duration{3.0};
+	std::size_t server_threads{1};
+};
+
+struct ClientResult {
+	Histogram latencies{};
+	std::uint64_t failures{0};
+	std::chrono::duration<double> cpu_time{};
+};
+
+std::chrono::duration<double> thread_cpu_time() {
+	rusage usage{};
+	getrusage(RUSAGE_THREAD, &usage);
+
+	return std::chrono::seconds{usage.ru_utime.tv_sec + usage.ru_stime.tv_sec} +
+	       std::chrono::microseconds{usage.ru_utime.tv_usec + usage.ru_stime.tv_usec};
+}
+
+std::vector<std::size_t> parse_list(std::string_view list) {
+	std::vector<std::size_t> values;
+
+	while (!list.empty()) {
+		const std::size_t comma = list.find(',');
+		const std::string_view item = list.substr(0, comma);
+		std::size_t value = 0;
+
+		if ((std::from_chars(item.begin(), item.end(), value).ec == std::errc{}) && (value > 0)) {
+			values.push_back(value);
+		}
+
+		list = (comma == std::string_view::npos) ? std::string_view{} : list.substr(comma + 1);
+	}
+
+	return values;
+}
+
+Options parse_options(int argc, char** argv) {
+	Options options;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+		const std::size_t equals = arg.find('=');
+		const std::string_view name = arg.substr(0, equals);
+		const std::string_view value = (equals == std::string_view::npos) ? "" : arg.substr(equals + 1);
+
+		if ((name == "--payload") && (value != "all")) {
+			options.payloads = {std::string{value}};
+		} else if (name == "--mode") {
+			options.mode = (value == "ping") ? Mode::ping : Mode::status;
+		} else if ((name == "--client") && (value != "all")) {
+			if (value == "blocking") {
+				options.clients = {Client::blocking};
+			} else if (value == "batch") {
+				options.clients = {Client::batch};
+			} else if (value == "async") {
+				options.clients = {Client::async};
+			} else {
+				std::cerr << "Unknown client " << value << "\n";
+				std::exit(1);
+			}
+		} else if (name == "--concurrency") {
+			options.concurrency = parse_list(value);
+		} else if (name == "--duration") {
+			options.duration = std::chrono::duration<double>{std::stod(std::string{value})};
+		} else if (name == "--server-threads") {
+			const std::vector<std::size_t> threads = parse_list(value);
+			options.server_threads = threads.empty() ? 1 : threads.front();
+		} else if ((name != "--payload") && (name != "--client")) {
+			std::cerr << "Unknown option " << arg << "\n";
+			std::exit(1);
+		}
+	}
+
+	return options;
+}
+
+ClientResult run_blocking_client(const JavaServer& server, Mode mode, std::chrono::steady_clock::time_point end) {
+	const RetryPolicy no_retries{.max_attempts = 1};
+	const std::chrono::duration<double> cpu_start = thread_cpu_time();
+	ClientResult result;
+
+	while (std::chrono::steady_clock::now() < end) {
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const bool success = (mode == Mode::ping) ? server.try_ping(std::chrono::seconds{5}, no_retries).has_value()
+		                                          : server.try_status(std::chrono::seconds{5}, no_retries).has_value();
+
+		if (success) {
+			result.latencies.record(std::chrono::steady_clock::now() - start);
+		} else {
+			++result.failures;
+		}
+	}
+
+	result.cpu_time = thread_cpu_time() - cpu_start;
+	return result;
+}
+
+// Batches can't be timed per query from the outside, so their latencies are the ones the library measured
+ClientResult run_batch_client(const JavaServer& server, std::size_t concurrency,
+                              std::chrono::steady_clock::time_point end) {
+	const RetryPolicy no_retries{.max_attempts = 1};
+	const std::vector<JavaServer> servers(concurrency, server);
+	const std::chrono::duration<double> cpu_start = thread_cpu_time();
+	ClientResult result;
+
+	while (std::chrono::steady_clock::now() < end) {
+		for (const McServer::result_t<JavaServer::RawStatus>& raw_status :
+		     JavaServer::try_status_raw_batch(servers, std::chrono::seconds{5}, no_retries, concurrency)) {
+			if (raw_status && JavaServer::try_parse_status(*raw_status).has_value()) {
+				const McServer::McTimings timings = raw_status->timings.value_or(McServer::McTimings{});
+				result.latencies.record(timings.connect + timings.handshake + timings.response);
+			} else {
+				++result.failures;
+			}
+		}
+	}
+
+	result.cpu_time = thread_cpu_time() - cpu_start;
+	return result;
+}
+
+boost::asio::awaitable<void> run_async_query_loop(const JavaServer& server, Mode mode,
+                                                  std::chrono::steady_clock::time_point end, ClientResult& result) {
+	const RetryPolicy no_retries{.max_attempts = 1};
+
+	while (std::chrono::steady_clock::now() < end) {
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		bool success = false;
+
+		if (mode == Mode::ping) {
+			success = (co_await server.async_try_ping(std::chrono::seconds{5}, no_retries)).has_value();
+		} else {
+			const McServer::result_t<JavaServer::RawStatus> raw_status =
+			    co_await server.async_try_status_raw(std::chrono::seconds{5}, no_retries);
+			success = raw_status && JavaServer::try_parse_status(*raw_status).has_value();
+		}
+
+		if (success) {
+			result.latencies.record(std::chrono::steady_clock::now() - start);
+		} else {
+			++result.failures;
+		}
+	}
+}
+
+// All coroutines share the io_context of one thread, so they can share the result as well
+ClientResult run_async_client(const JavaServer& server, Mode mode, std::size_t concurrency,
+                              std::chrono::steady_clock::time_point end) {
+	boost::asio::io_context io_context{1};
+	const std::chrono::duration<double> cpu_start = thread_cpu_time();
+	ClientResult result;
+
+	for (std::size_t i = 0; i < concurrency; ++i) {
+		boost::asio::co_spawn(io_context, run_async_query_loop(server, mode, end, result), boost::asio::detached);
+	}
+	io_context.run();
+
+	result.cpu_time = thread_cpu_time() - cpu_start;
+	return result;
+}
+
+std::string_view client_name(Client client) {
+	switch (client) {
+		case Client::blocking:
+			return "blocking";
+		case Client::batch:
+			return "batch";
+		case Client::async:
+			return "async";
+	}
+
+	return "";
+}
+
+std::string format_latency(Histogram::duration_t latency) {
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::micro>{latency}.count() << "us";
+	return out.str();
+}
+
+void run(const std::string& payload_name, const std::string& payload, Client client, const Options& options) {
+	const BenchServer bench_server{payload, options.server_threads};
+	const JavaServer server{bench_server.endpoint()};
+
+	for (const std::size_t clients : options.concurrency) {
+		std::vector<ClientResult> results((client == Client::blocking) ? clients : 1);
+		std::vector<std::thread> threads;
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(options.duration);
+
+		if (client == Client::batch) {
+			results.front() = run_batch_client(server, clients, end);
+		} else if (client == Client::async) {
+			results.front() = run_async_client(server, options.mode, clients, end);
+		} else {
+			for (std::size_t i = 0; i < clients; ++i) {
+				threads.emplace_back([&, i] { results[i] = run_blocking_client(server, options.mode, end); });
+			}
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+		}
+
+		const std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - start;
+		Histogram latencies;
+		std::uint64_t failures = 0;
+		std::chrono::duration<double> cpu_time{};
+
+		for (const ClientResult& result : results) {
+			latencies.merge(result.latencies);
+			failures += result.failures;
+			cpu_time += result.cpu_time;
+		}
+
+		const double qps = static_cast<double>(latencies.count) / wall_time.count();
+		const double qps_per_core = static_cast<double>(latencies.count) / std::max(cpu_time.count(), 1e-9);
+
+		std::cout << std::left << std::setw(14) << payload_name << std::right << " bytes=" << std::setw(6)
+		          << bench_server.status_size() << " mode=" << ((options.mode == Mode::ping) ? "ping  " : "status")
+		          << " client=" << std::left << std::setw(8) << client_name(client) << std::right
+		          << " clients=" << std::setw(3) << clients << std::fixed << std::setprecision(0)
+		          << " qps=" << std::setw(8) << qps << " qps/core=" << std::setw(8) << qps_per_core
+		          << " p50=" << std::setw(9) << format_latency(latencies.percentile(0.5))
+		          << " p99=" << std::setw(9) << format_latency(latencies.percentile(0.99))
+		          << " p999=" << std::setw(9) << format_latency(latencies.percentile(0.999))
+		          << " failures=" << failures << std::endl;
+	}
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	const Options options = parse_options(argc, argv);
+
+	std::cout << "# qps/core is measured against the CPU time of the client threads only, the server runs on "
+	          << options.server_threads << " separate thread(s)\n";
+
+	for (const std::string& payload_name : options.payloads) {
+		const std::optional<std::string> payload = payloads::by_name(payload_name);
+
+		if (!payload) {
+			std::cerr << "Unknown payload " << payload_name << "\n";
+			return 1;
+		}
+
+		for (const Client client : options.clients) {
+			// There's no batch API for pings
+			if ((client == Client::batch) && (options.mode == Mode::ping)) {
+				continue;
+			}
+
+			run(payload_name, *payload, client, options);
+		}
+	}
+
+	return 0;
+}
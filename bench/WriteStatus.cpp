@@ -0,0 +1,102 @@
+// Benchmark for writing statuses as NDJSON. Parses every payload of the corpus once, then writes all of them with a
+// StatusWriter over and over and reports the output throughput in MB/s and lines/s. --input=view writes JavaStatusViews
+// instead of parsed responses.
+//
+// Usage: libmcstatus_write_status [--corpus=<directory>] [--duration=<seconds>] [--input=response|view]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/JavaStatusView.hpp"
+#include "libmcstatus/StatusWriter.hpp"
+
+using namespace libmcstatus;
+
+int main(int argc, char** argv) {
+	std::filesystem::path corpus_directory{LIBMCSTATUS_CORPUS_DIR};
+	std::chrono::duration<double> duration{3.0};
+	bool views = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+
+		if (arg.starts_with("--corpus=")) {
+			corpus_directory = arg.substr(9);
+		} else if (arg.starts_with("--duration=")) {
+			duration = std::chrono::duration<double>{std::stod(std::string{arg.substr(11)})};
+		} else if ((arg == "--input=response") || (arg == "--input=view")) {
+			views = arg == "--input=view";
+		} else {
+			std::cerr << "Unknown option " << arg << "\n";
+			return 1;
+		}
+	}
+
+	std::vector<std::unique_ptr<JavaServer::JavaServerResponse>> responses;
+	std::vector<JavaStatusView> status_views;
+
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{corpus_directory}) {
+		if (!entry.is_regular_file() || (entry.path().extension() != ".json")) {
+			continue;
+		}
+
+		std::ifstream file{entry.path(), std::ios::binary};
+		const std::string json{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+		auto response = JavaServer::try_parse_status(JavaServer::RawStatus{
+		    .buffer = {json.begin(), json.end()}, .size = json.size()});
+		auto view = JavaStatusView::try_parse(json);
+
+		if (!response || !view) {
+			std::cerr << "Failed to parse " << entry.path() << "\n";
+			return 1;
+		}
+		responses.push_back(std::move(*response));
+		status_views.push_back(std::move(*view));
+	}
+
+	if (responses.empty()) {
+		std::cerr << "No payloads found in " << corpus_directory << "\n";
+		return 1;
+	}
+
+	std::string output;
+	std::uint64_t bytes = 0;
+	std::uint64_t lines = 0;
+	std::chrono::duration<double> elapsed{};
+
+	// Whole passes over the corpus, into a string that is reused, so only the writer itself is measured
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	while (elapsed < duration) {
+		output.clear();
+		StatusWriter writer{output};
+
+		for (std::size_t i = 0; i < responses.size(); ++i) {
+			if (views) {
+				writer.write("203.0.113.7:25565", status_views[i]);
+			} else {
+				writer.write("203.0.113.7:25565", *responses[i]);
+			}
+		}
+
+		bytes += output.size();
+		lines += responses.size();
+		elapsed = std::chrono::steady_clock::now() - start;
+	}
+
+	std::cout << "payloads=" << responses.size() << std::fixed << std::setprecision(1)
+	          << " MB/s=" << (static_cast<double>(bytes) / elapsed.count() / 1e6) << std::setprecision(0)
+	          << " lines/s=" << (static_cast<double>(lines) / elapsed.count()) << std::endl;
+
+	return 0;
+}
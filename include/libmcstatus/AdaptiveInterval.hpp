@@ -0,0 +1,58 @@
+#ifndef LIBMCSTATUS_ADAPTIVEINTERVAL_HPP
+#define LIBMCSTATUS_ADAPTIVEINTERVAL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <optional>
+
+namespace libmcstatus {
+
+// How the poll interval of a server follows the rate at which it changes
+struct AdaptivePolicy {
+	std::chrono::milliseconds min_interval{std::chrono::seconds{5}};
+	std::chrono::milliseconds max_interval{std::chrono::minutes{10}};
+	// Fraction of polls (0.0 - 1.0) that should see a change. Servers that change more often than that are polled more
+	// often, the others less
+	double target_change_rate{0.5};
+	// Weight of the latest poll in the moving average of the change rate
+	double smoothing{0.2};
+	// Most the interval grows or shrinks by after a single poll
+	double max_step{2.0};
+	// Failed polls in a row multiply the interval by this each, up to max_interval
+	double error_backoff{2.0};
+};
+
+// Adapts a poll interval to the observed change rate of a server. The interval settles where about target_change_rate
+// of the polls see a change: servers that never change end up at max_interval, busy ones at min_interval. Not
+// thread-safe
+class AdaptiveInterval {
+public:
+	// The initial interval is clamped into the bounds of the policy
+	AdaptiveInterval(const AdaptivePolicy& policy, std::chrono::milliseconds initial);
+
+	// After a successful poll, whether it saw a change. std::nullopt if it can't tell, like for the first status of a
+	// server or for pings, which only ends the error backoff
+	void success(std::optional<bool> changed);
+	void failure();
+
+	// Until the next poll, including the error backoff
+	[[nodiscard]] std::chrono::milliseconds next() const;
+	// Without the error backoff
+	[[nodiscard]] std::chrono::milliseconds interval() const;
+	[[nodiscard]] double change_rate() const {
+		return rate;
+	}
+	[[nodiscard]] std::size_t failures() const {
+		return failed;
+	}
+
+private:
+	AdaptivePolicy policy;
+	double interval_ms;
+	double rate;
+	std::size_t failed{0};
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_ADAPTIVEINTERVAL_HPP
@@ -0,0 +1,65 @@
+#ifndef LIBMCSTATUS_CHANGEDETECTOR_HPP
+#define LIBMCSTATUS_CHANGEDETECTOR_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+
+#include "impl/ShardedMap.hpp"
+#include "JavaServer.hpp"
+#include "RetryPolicy.hpp"
+
+namespace libmcstatus {
+
+// Remembers the last status of every endpoint, so repeated polls only pay for parsing what actually changed. Payloads
+// that are byte for byte the same as last time aren't parsed at all, and if nothing but players.online changed, only
+// that number is read. Can be shared between any number of threads
+class ChangeDetector {
+public:
+	enum class Change : std::uint8_t {
+		unchanged,    // The very same payload as last time, status is the previous one
+		online_only,  // Only players.online changed
+		changed,      // Anything else, including the first status of an endpoint. Parsed from scratch
+	};
+
+	struct Update {
+		Change change{Change::changed};
+		// Shared with the detector and with earlier updates, so never modified once handed out. Its latency and
+		// timings are those of the poll that produced it, which for unchanged statuses is an earlier one
+		std::shared_ptr<const JavaServer::JavaServerResponse> status{};
+	};
+
+	// Compares the status against the previous one of the same endpoint (any key that identifies a server, like
+	// JavaServer::to_string()) and remembers it for the next call. Returns McError::bad_json if the status has to be
+	// parsed and is malformed, in which case the endpoint is forgotten
+	[[nodiscard]] McServer::result_t<Update> update(std::string_view endpoint, const JavaServer::RawStatus& raw_status);
+
+	// Queries the server with JavaServer::try_status_raw() and passes the result to update(), keyed by to_string()
+	[[nodiscard]] McServer::result_t<Update> try_poll(const JavaServer& server, std::chrono::milliseconds timeout,
+	                                                  const RetryPolicy& retry_policy);
+
+	// Forgets the previous status, so the next one gets parsed from scratch
+	void forget(std::string_view endpoint);
+	// Number of endpoints with a remembered status
+	[[nodiscard]] std::size_t size() const;
+
+private:
+	struct Entry {
+		std::uint64_t hash{0};  // Of the whole payload
+		// Where players.online starts. Together with hashes of everything before and after the number, this finds
+		// payloads that differ in nothing else
+		std::optional<std::size_t> online_offset{};
+		std::uint64_t prefix_hash{0};
+		std::uint64_t suffix_hash{0};
+		std::shared_ptr<const JavaServer::JavaServerResponse> status{};
+	};
+
+	_impl::ShardedMap<Entry> entries{};
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_CHANGEDETECTOR_HPP
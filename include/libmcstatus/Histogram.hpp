@@ -0,0 +1,71 @@
+#ifndef LIBMCSTATUS_HISTOGRAM_HPP
+#define LIBMCSTATUS_HISTOGRAM_HPP
+
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace libmcstatus {
+
+// HDR-style log-linear latency histogram with nanosecond resolution. Values below SUB_BUCKETS get an exact bucket each,
+// above that every power of two is split into SUB_BUCKETS linear buckets, which bounds the relative error to 1 /
+// SUB_BUCKETS (~6%). Values of MAX_MAGNITUDE bits and more (~18 minutes) all end up in the last bucket
+class Histogram {
+public:
+	using duration_t = std::chrono::steady_clock::duration;
+
+	static constexpr std::size_t SUB_BUCKET_BITS{4};
+	static constexpr std::size_t SUB_BUCKETS{std::size_t{1} << SUB_BUCKET_BITS};
+	static constexpr std::size_t MAX_MAGNITUDE{40};
+	static constexpr std::size_t BUCKETS{(MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKETS};
+
+	[[nodiscard]] static constexpr std::size_t bucket_index(std::uint64_t value) {
+		if (value < SUB_BUCKETS) {
+			return static_cast<std::size_t>(value);
+		}
+
+		const auto magnitude = static_cast<std::size_t>(std::bit_width(value) - 1);
+		if (magnitude >= MAX_MAGNITUDE) {
+			return BUCKETS - 1;
+		}
+
+		const std::size_t shift = magnitude - SUB_BUCKET_BITS;
+		return ((shift + 1) * SUB_BUCKETS) + static_cast<std::size_t>((value >> shift) & (SUB_BUCKETS - 1));
+	}
+	// Smallest value that ends up in the bucket after the given one
+	[[nodiscard]] static constexpr std::uint64_t bucket_limit(std::size_t index) {
+		if (index < SUB_BUCKETS) {
+			return index + 1;
+		}
+
+		const std::size_t shift = (index / SUB_BUCKETS) - 1;
+		return ((SUB_BUCKETS + (index % SUB_BUCKETS)) + 1) << shift;
+	}
+
+	std::array<std::uint64_t, BUCKETS> counts{};
+	std::uint64_t count{0};
+	std::uint64_t sum{0};  // In nanoseconds
+
+	void record(duration_t value);
+	void merge(const Histogram& other);
+
+	// Returns the (upper bound of the bucket of the) given percentile (0.0 - 1.0), or zero if the histogram is empty
+	[[nodiscard]] duration_t percentile(double percentile) const;
+	[[nodiscard]] duration_t mean() const;
+	// Number of values below the given limit. Only exact for limits that fall on bucket boundaries
+	[[nodiscard]] std::uint64_t count_below(duration_t limit) const;
+
+	struct CumulativeCount {
+		duration_t limit{};  // The upper end of the bucket the requested limit falls into
+		std::uint64_t count{0};
+	};
+	// Number of values of at most the given limit, after rounding it up to the upper end of its bucket. Always exact,
+	// for the limit that is returned alongside
+	[[nodiscard]] CumulativeCount count_up_to(duration_t limit) const;
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_HISTOGRAM_HPP
@@ -0,0 +1,98 @@
+#ifndef LIBMCSTATUS_INTERNPOOL_HPP
+#define LIBMCSTATUS_INTERNPOOL_HPP
+
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "impl/ShardedMap.hpp"
+#include "JavaServer.hpp"
+#include "JavaStatusView.hpp"
+#include "McError.hpp"
+
+namespace libmcstatus {
+
+// Hands out one shared copy of every distinct string, so the same version names, MOTDs and favicons of millions of
+// statuses are only stored once and can be compared by pointer. Strings stay in the pool until prune() finds that
+// nobody else uses them anymore. Can be shared between any number of threads
+class InternPool {
+public:
+	using string_t = std::shared_ptr<const std::string>;
+
+	// The pool's copy of value, never nullptr
+	[[nodiscard]] string_t intern(std::string_view value);
+
+	// Drops all strings only the pool itself still holds, returns how many
+	std::size_t prune();
+	// Number of distinct strings
+	[[nodiscard]] std::size_t size() const;
+	// Bytes held by the strings themselves
+	[[nodiscard]] std::size_t memory_usage() const;
+
+private:
+	struct Hash {
+		using is_transparent = void;
+
+		[[nodiscard]] std::size_t operator()(std::string_view value) const;
+		[[nodiscard]] std::size_t operator()(const string_t& value) const {
+			return (*this)(std::string_view{*value});
+		}
+	};
+
+	struct Equal {
+		using is_transparent = void;
+
+		[[nodiscard]] bool operator()(const string_t& lhs, const string_t& rhs) const {
+			return *lhs == *rhs;
+		}
+		[[nodiscard]] bool operator()(std::string_view lhs, const string_t& rhs) const {
+			return lhs == *rhs;
+		}
+		[[nodiscard]] bool operator()(const string_t& lhs, std::string_view rhs) const {
+			return *lhs == rhs;
+		}
+	};
+
+	using set_t = std::unordered_set<string_t, Hash, Equal>;
+
+	_impl::Sharded<set_t> strings{};
+};
+
+// Compact copy of a status for keeping lots of them around, with all strings shared through an InternPool. Strings
+// that are the same have the same pointer, so comparing those is enough
+struct InternedStatus {
+	struct Player {
+		InternPool::string_t name{};
+		boost::uuids::uuid id{};
+	};
+
+	McServer::latency_t latency{-1};
+	InternPool::string_t version_name{};
+	McServer::response_int_t protocol{-1};
+	McServer::response_int_t online{-1};
+	McServer::response_int_t max{-1};
+	std::optional<std::vector<Player>> sample{};
+	InternPool::string_t motd{};  // Like JavaServerResponse::motd, empty if the status has none
+	std::optional<bool> enforces_secure_chat{};
+	InternPool::string_t icon{};        // nullptr if the status has none
+	InternPool::string_t forge_data{};  // nullptr if the status has none
+
+	[[nodiscard]] static InternedStatus from(const JavaServer::JavaServerResponse& status, InternPool& pool);
+	// Doesn't need any intermediate copies of the strings. Chat component descriptions are kept as the JSON text the
+	// server sent
+	[[nodiscard]] static InternedStatus from(const JavaStatusView& status, InternPool& pool);
+
+	// Parses a status queried by JavaServer::status_raw() straight into interned strings. Returns McError::bad_json
+	// under the same conditions as JavaServer::try_parse_status()
+	[[nodiscard]] static std::expected<InternedStatus, McError> try_parse(JavaServer::RawStatus raw_status,
+	                                                                      InternPool& pool);
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_INTERNPOOL_HPP
@@ -1,15 +1,22 @@
 #ifndef LIBMCSTATUS_JAVASERVER_HPP
 #define LIBMCSTATUS_JAVASERVER_HPP
 
+#include <boost/asio/awaitable.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/uuid/uuid.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "JavaStatusView.hpp"
+#include "McPacket.hpp"
 #include "McServer.hpp"
+#include "Transport.hpp"
 
 namespace libmcstatus {
 
@@ -42,19 +49,49 @@ public:
 		std::optional<std::string> forge_data{};  // TODO: own class?
 	};
 
-protected:
-	boost::asio::ip::tcp::endpoint server_address;
+	// Status response whose JSON hasn't been parsed yet, for storing it as it is or parsing it later on, for example on
+	// another thread. The frame has been validated, the JSON itself hasn't been looked at
+	struct RawStatus {
+		latency_t latency{-1};
+		std::optional<McTimings> timings{};  // parse is always zero
+
+		McPacket::buffer_t buffer{};  // The whole packet, the JSON is buffer[offset, offset + size)
+		std::size_t offset{0};
+		std::size_t size{0};
+
+		[[nodiscard]] std::string_view json() const {
+			return {reinterpret_cast<const char*>(buffer.data()) + offset, size};
+		}
+	};
 
-	void handshake(boost::asio::ip::tcp::socket& socket) const;
+protected:
+	std::shared_ptr<const Transport> transport;
+	std::optional<latency_t> resolve_time{};  // How long lookup() took to find the server address
+
+	[[nodiscard]] boost::asio::awaitable<result_t<void>> handshake(Transport::Connection& connection) const;
+	[[nodiscard]] boost::asio::awaitable<result_t<latency_t>> ping_exchange(Transport::Connection& connection) const;
+	// Sends the status request and returns the response packet, positioned at the status JSON. Fills in all timings
+	// except for parse
+	[[nodiscard]] boost::asio::awaitable<result_t<McPacket>> status_request(Transport::Connection& connection,
+	                                                                        McTimings& timings) const;
+	[[nodiscard]] boost::asio::awaitable<result_t<std::unique_ptr<JavaServerResponse>>> status_exchange(
+	    Transport::Connection& connection, McTimings& timings) const;
+	[[nodiscard]] boost::asio::awaitable<result_t<JavaStatusView>> status_view_exchange(
+	    Transport::Connection& connection, McTimings& timings) const;
+	[[nodiscard]] boost::asio::awaitable<result_t<RawStatus>> status_raw_exchange(Transport::Connection& connection,
+	                                                                              McTimings& timings) const;
 
 public:
 	static constexpr boost::asio::ip::port_type DEFAULT_PORT{25565};
 
+	// Queries the server over any transport, for example a MemoryTransport in tests
+	explicit JavaServer(std::shared_ptr<const Transport> transport);
 	explicit JavaServer(boost::asio::ip::tcp::endpoint server_address);
 	JavaServer(const boost::asio::ip::address& ip_address, boost::asio::ip::port_type port);
 
-	using McServer::ping;
-	[[nodiscard]] latency_t ping(std::chrono::milliseconds timeout) const override;
+	using McServer::try_ping;
+	[[nodiscard]] result_t<latency_t> try_ping(std::chrono::milliseconds timeout,
+	                                           const RetryPolicy& retry_policy) const override;
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "HidingNonVirtualFunction"
@@ -62,16 +99,119 @@ public:
 		return status(DEFAULT_TIMEOUT);
 	}
 	[[nodiscard]] inline std::unique_ptr<JavaServerResponse> status(std::chrono::milliseconds timeout) const {
-		return std::unique_ptr<JavaServerResponse>{status_impl(timeout)};
+		return status(timeout, default_retry_policy());
+	}
+	[[nodiscard]] inline std::unique_ptr<JavaServerResponse> status(std::chrono::milliseconds timeout,
+	                                                                const RetryPolicy& retry_policy) const {
+		return std::unique_ptr<JavaServerResponse>{status_impl(timeout, retry_policy)};
+	}
+
+	[[nodiscard]] inline result_t<std::unique_ptr<JavaServerResponse>> try_status() const {
+		return try_status(DEFAULT_TIMEOUT);
 	}
+	[[nodiscard]] inline result_t<std::unique_ptr<JavaServerResponse>> try_status(
+	    std::chrono::milliseconds timeout) const {
+		return try_status(timeout, default_retry_policy());
+	}
+	[[nodiscard]] result_t<std::unique_ptr<JavaServerResponse>> try_status(std::chrono::milliseconds timeout,
+	                                                                       const RetryPolicy& retry_policy) const;
 #pragma clang diagnostic pop
 
+	// Same query as status(), but the result points into the received packet instead of copying every field out of it
+	[[nodiscard]] inline JavaStatusView status_view() const {
+		return status_view(DEFAULT_TIMEOUT);
+	}
+	[[nodiscard]] inline JavaStatusView status_view(std::chrono::milliseconds timeout) const {
+		return status_view(timeout, default_retry_policy());
+	}
+	[[nodiscard]] JavaStatusView status_view(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const;
+
+	[[nodiscard]] inline result_t<JavaStatusView> try_status_view() const {
+		return try_status_view(DEFAULT_TIMEOUT);
+	}
+	[[nodiscard]] inline result_t<JavaStatusView> try_status_view(std::chrono::milliseconds timeout) const {
+		return try_status_view(timeout, default_retry_policy());
+	}
+	[[nodiscard]] result_t<JavaStatusView> try_status_view(std::chrono::milliseconds timeout,
+	                                                       const RetryPolicy& retry_policy) const;
+
+	// Same query as status(), but without parsing the JSON. Hand the result to parse_status() (or
+	// JavaStatusView::try_parse()) whenever it is needed
+	[[nodiscard]] inline RawStatus status_raw() const {
+		return status_raw(DEFAULT_TIMEOUT);
+	}
+	[[nodiscard]] inline RawStatus status_raw(std::chrono::milliseconds timeout) const {
+		return status_raw(timeout, default_retry_policy());
+	}
+	[[nodiscard]] RawStatus status_raw(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const;
+
+	[[nodiscard]] inline result_t<RawStatus> try_status_raw() const {
+		return try_status_raw(DEFAULT_TIMEOUT);
+	}
+	[[nodiscard]] inline result_t<RawStatus> try_status_raw(std::chrono::milliseconds timeout) const {
+		return try_status_raw(timeout, default_retry_policy());
+	}
+	[[nodiscard]] result_t<RawStatus> try_status_raw(std::chrono::milliseconds timeout,
+	                                                 const RetryPolicy& retry_policy) const;
+
+	// Runs the query on the executor of the calling coroutine instead of an io_context of its own. That executor must
+	// not run handlers concurrently (use a strand on multi-threaded io_contexts), and the server has to outlive the
+	// query
+	[[nodiscard]] inline boost::asio::awaitable<result_t<RawStatus>> async_try_status_raw() const {
+		return async_try_status_raw(DEFAULT_TIMEOUT);
+	}
+	[[nodiscard]] inline boost::asio::awaitable<result_t<RawStatus>> async_try_status_raw(
+	    std::chrono::milliseconds timeout) const {
+		return async_try_status_raw(timeout, default_retry_policy());
+	}
+	[[nodiscard]] boost::asio::awaitable<result_t<RawStatus>> async_try_status_raw(std::chrono::milliseconds timeout,
+	                                                                              RetryPolicy retry_policy) const;
+
+	// Same as async_try_status_raw(), for try_ping()
+	[[nodiscard]] inline boost::asio::awaitable<result_t<latency_t>> async_try_ping() const {
+		return async_try_ping(DEFAULT_TIMEOUT);
+	}
+	[[nodiscard]] inline boost::asio::awaitable<result_t<latency_t>> async_try_ping(
+	    std::chrono::milliseconds timeout) const {
+		return async_try_ping(timeout, default_retry_policy());
+	}
+	[[nodiscard]] boost::asio::awaitable<result_t<latency_t>> async_try_ping(std::chrono::milliseconds timeout,
+	                                                                        RetryPolicy retry_policy) const;
+
+	static constexpr std::size_t DEFAULT_BATCH_CONCURRENCY{64};
+
+	// Queries all servers on one io_context, at most concurrency of them at a time. Results are in the order of servers
+	[[nodiscard]] static inline std::vector<result_t<RawStatus>> try_status_raw_batch(
+	    std::span<const JavaServer> servers, std::chrono::milliseconds timeout) {
+		return try_status_raw_batch(servers, timeout, default_retry_policy(), DEFAULT_BATCH_CONCURRENCY);
+	}
+	[[nodiscard]] static std::vector<result_t<RawStatus>> try_status_raw_batch(std::span<const JavaServer> servers,
+	                                                                           std::chrono::milliseconds timeout,
+	                                                                           const RetryPolicy& retry_policy,
+	                                                                           std::size_t concurrency);
+
+	// Parses a status queried by status_raw(), on any thread. Latency and timings are taken over from raw_status
+	[[nodiscard]] static std::unique_ptr<JavaServerResponse> parse_status(const RawStatus& raw_status);
+	// Returns McError::bad_json if the status is malformed or misses any of the required fields
+	[[nodiscard]] static result_t<std::unique_ptr<JavaServerResponse>> try_parse_status(const RawStatus& raw_status);
+
 protected:
-	[[nodiscard]] JavaServerResponse* status_impl(std::chrono::milliseconds timeout) const override;
+	[[nodiscard]] JavaServerResponse* status_impl(std::chrono::milliseconds timeout,
+	                                              const RetryPolicy& retry_policy) const override;
+	[[nodiscard]] result_t<McStatusResponse*> try_status_impl(std::chrono::milliseconds timeout,
+	                                                          const RetryPolicy& retry_policy) const override;
 	[[nodiscard]] static JavaServerResponse* parse_status(latency_t latency, std::string_view status_response);
+	// Returns McError::bad_json if the status is malformed or misses any of the required fields
+	[[nodiscard]] static result_t<std::unique_ptr<JavaServerResponse>> try_parse_status(
+	    latency_t latency, std::string_view status_response);
 
 public:
 	static JavaServer lookup(std::string_view host_address);
+	// Returns McError::resolve_failed instead of throwing if the host can't be resolved
+	static result_t<JavaServer> try_lookup(std::string_view host_address);
+
+	// For example to wrap the transport of a looked up server into a RecordingTransport
+	[[nodiscard]] const std::shared_ptr<const Transport>& get_transport() const;
 
 	[[nodiscard]] std::string to_string() const override;
 };
@@ -0,0 +1,65 @@
+#ifndef LIBMCSTATUS_JAVASTATUSVIEW_HPP
+#define LIBMCSTATUS_JAVASTATUSVIEW_HPP
+
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "McError.hpp"
+#include "McPacket.hpp"
+#include "McServer.hpp"
+
+namespace libmcstatus {
+
+// Status of a Java server that owns the received packet and points into it, instead of copying every string into its
+// own allocation like JavaServer::JavaServerResponse does. Strings are unescaped in place, description and forge_data
+// are the raw JSON text of those values. Views stay valid as long as the JavaStatusView lives (moving it keeps them
+// valid as well), so copy out whatever has to outlive it. Can be moved, but not copied
+class JavaStatusView {
+public:
+	struct Player {
+		std::string_view name{};
+		boost::uuids::uuid id{};
+	};
+
+	McServer::latency_t latency{-1};
+	std::optional<McServer::McTimings> timings{};
+
+	std::string_view version_name{};
+	McServer::response_int_t protocol{-1};
+	McServer::response_int_t online{-1};
+	McServer::response_int_t max{-1};
+	std::optional<std::vector<Player>> sample{};
+
+	std::optional<std::string_view> description{};  // Raw JSON, either a string or a chat component
+	std::optional<bool> enforces_secure_chat{};
+	std::optional<std::string_view> icon{};
+	std::optional<std::string_view> forge_data{};  // Raw JSON of forgeData, or of the legacy modinfo
+
+	// Empty status without any fields, only there to be assigned to later
+	JavaStatusView() = default;
+	JavaStatusView(JavaStatusView&&) noexcept = default;
+	JavaStatusView& operator=(JavaStatusView&&) noexcept = default;
+	JavaStatusView(const JavaStatusView&) = delete;
+	JavaStatusView& operator=(const JavaStatusView&) = delete;
+
+	// Parses the status JSON in buffer[offset, offset + size) and takes ownership of the buffer. Returns
+	// McError::bad_json under the same conditions as JavaServer's own parsing
+	[[nodiscard]] static std::expected<JavaStatusView, McError> try_parse(McPacket::buffer_t buffer, std::size_t offset,
+	                                                                      std::size_t size);
+	// Copies the JSON into a buffer of its own
+	[[nodiscard]] static std::expected<JavaStatusView, McError> try_parse(std::string_view json);
+
+	// Bytes held by this status, the packet plus the player sample
+	[[nodiscard]] std::size_t memory_usage() const;
+
+private:
+	McPacket::buffer_t buffer;
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_JAVASTATUSVIEW_HPP
@@ -0,0 +1,44 @@
+#ifndef LIBMCSTATUS_MCERROR_HPP
+#define LIBMCSTATUS_MCERROR_HPP
+
+#include <boost/system/error_code.hpp>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "impl/EnumSet.hpp"
+
+namespace libmcstatus {
+
+// Compact classification of everything that can go wrong while querying a server
+enum class McError : std::uint8_t {
+	// 0 is reserved for "no error", so McError can be used as a boost::system::error_code
+	timeout = 1,
+	connection_refused,
+	connection_reset,
+	host_unreachable,
+	network_error,
+	resolve_failed,
+	bad_frame,     // The response couldn't be decoded into a packet
+	bad_response,  // The packet was decoded, but isn't what we asked for
+	bad_json,      // The status JSON is malformed or misses required fields
+	unknown,
+};
+
+// Small set of McError values, for example to select which errors are retryable
+using McErrorSet = _impl::EnumSet<McError>;
+
+[[nodiscard]] std::string_view to_string(McError error);
+
+[[nodiscard]] const boost::system::error_category& mc_error_category() noexcept;
+[[nodiscard]] boost::system::error_code make_error_code(McError error) noexcept;
+
+// Maps an error code (from Boost.Asio, the OS or libmcstatus itself) to the matching McError
+[[nodiscard]] McError classify_error(const boost::system::error_code& error_code) noexcept;
+
+}  // namespace libmcstatus
+
+template <>
+struct boost::system::is_error_code_enum<libmcstatus::McError> : std::true_type {};
+
+#endif  // LIBMCSTATUS_MCERROR_HPP
@@ -1,14 +1,22 @@
 #ifndef LIBMCSTATUS_MCPACKET_HPP
 #define LIBMCSTATUS_MCPACKET_HPP
 
+#include <boost/asio/awaitable.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/ip/udp.hpp>
+#include <chrono>
+#include <concepts>
 #include <cstdint>
+#include <expected>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "McError.hpp"
+#include "Transport.hpp"
+
 namespace libmcstatus {
 
 class McPacket {
@@ -17,6 +25,9 @@ public:
 	using buffer_iterator_t = buffer_t::const_iterator;
 	using head_offset_t = buffer_iterator_t::difference_type;
 
+	// Largest packet the protocol allows (the length prefix may be at most 3 bytes long)
+	static constexpr std::int32_t MAX_PACKET_SIZE{2097151};
+
 	class PacketError : public std::runtime_error {
 	public:
 		using std::runtime_error::runtime_error;
@@ -43,6 +54,9 @@ protected:
 	buffer_iterator_t get_head();
 	buffer_iterator_t advance_head();
 
+	template <std::integral T>
+	T read_int_be_or_throw();
+
 public:
 	// Public Constructors
 	McPacket();
@@ -69,8 +83,12 @@ public:
 	void write_bool(bool value);
 
 	buffer_t write_to_buffer();
+	// Hands over the packet's buffer without copying it, the packet is empty afterwards
+	[[nodiscard]] buffer_t release() &&;
 	void write_to_socket(boost::asio::ip::tcp::socket& socket);
 	void write_to_socket(boost::asio::ip::udp::socket& socket);
+	[[nodiscard]] boost::asio::awaitable<std::expected<void, McError>> async_try_write(
+	    Transport::Connection& connection);
 
 	// Read Functions
 	[[nodiscard]] bool eof() const;
@@ -95,6 +113,24 @@ public:
 	[[nodiscard]] static McPacket read_from_buffer(const buffer_t& buffer);
 	[[nodiscard]] static McPacket read_from_socket(boost::asio::ip::tcp::socket& socket);
 	[[nodiscard]] static McPacket read_from_socket(boost::asio::ip::udp::socket& socket);
+
+	// Non-throwing read functions, which report any decoding failure as McError::bad_frame (or the error of the
+	// connection) instead of throwing. Use these where failures are common, as exceptions are costly
+	[[nodiscard]] std::expected<std::int32_t, McError> try_read_varint();
+	[[nodiscard]] std::expected<std::int64_t, McError> try_read_varlong();
+	[[nodiscard]] std::expected<std::string, McError> try_read_utf();
+	// Like try_read_utf(), but points into the packet instead of copying. Stays valid as long as the buffer does, which
+	// includes the buffer returned by release()
+	[[nodiscard]] std::expected<std::string_view, McError> try_read_utf_view();
+	[[nodiscard]] std::expected<std::int64_t, McError> try_read_long();
+
+	[[nodiscard]] static std::expected<McPacket, McError> try_read_from_buffer(const buffer_t& buffer);
+	// Size of the first packet in data, length prefix included. Returns 0 while the packet is incomplete and
+	// McError::bad_frame if its length is invalid. Use this to split a byte stream into packets
+	[[nodiscard]] static std::expected<std::size_t, McError> try_frame_size(std::span<const std::uint8_t> data);
+	// If given, first_byte is set to the time the first part of the packet arrived
+	[[nodiscard]] static boost::asio::awaitable<std::expected<McPacket, McError>> async_try_read(
+	    Transport::Connection& connection, std::chrono::steady_clock::time_point* first_byte = nullptr);
 };
 
 }  // namespace libmcstatus
@@ -1,19 +1,43 @@
 #ifndef LIBMCSTATUS_MCSERVER_HPP
 #define LIBMCSTATUS_MCSERVER_HPP
 
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <expected>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
 
+#include "McError.hpp"
+#include "RetryPolicy.hpp"
+
 namespace libmcstatus {
 
+// Thread safety: ping(), status() and lookup() may be called concurrently from any number of threads, including on the
+// same server object. Each call uses its own io_context and socket, random numbers come from per-thread generators and
+// all per-call settings are passed as arguments. RETRIES is only read once at the start of a call, so changing it while
+// queries are in flight is safe, but only affects calls started afterwards. A RetryPolicy may be shared between threads
+// as well.
 class McServer {
 public:
-	using latency_t = std::chrono::high_resolution_clock::duration;
+	using latency_t = std::chrono::steady_clock::duration;
 	using response_int_t = std::int64_t;
+	template <typename T>
+	using result_t = std::expected<T, McError>;
+
+	// Breakdown of where the time of a query went, all measured on steady_clock. Everything from connecting on is
+	// measured on the attempt that produced the response
+	struct McTimings {
+		std::optional<latency_t> resolve{};  // Only set for servers created by lookup()
+		latency_t connect{};
+		latency_t handshake{};   // Writing the handshake
+		latency_t first_byte{};  // From sending the request until the first byte of the response arrives
+		latency_t response{};    // From sending the request until the full response arrived
+		latency_t parse{};       // Parsing the JSON
+	};
 
 	struct McStatusResponse {
 		struct McStatusPlayers {
@@ -38,27 +62,83 @@ public:
 		std::shared_ptr<McStatusVersion> version;
 		std::string motd{};  // TODO: Own class?
 		latency_t latency{-1};
+		std::optional<McTimings> timings{};
 	};
 
 	static constexpr std::chrono::seconds DEFAULT_TIMEOUT{3};
-	static std::size_t RETRIES;  // 3
+	// Default number of attempts for calls that don't specify their own retry policy
+	static std::atomic_size_t RETRIES;  // 3
+
+	[[nodiscard]] static inline RetryPolicy default_retry_policy() {
+		return RetryPolicy{.max_attempts = RETRIES.load(std::memory_order_relaxed)};
+	}
 
 	virtual ~McServer() = default;
 
+	// The throwing functions throw boost::system::system_error with an McError code if the server can't be reached or
+	// its response can't be understood. The try_ variants return the McError instead, which is a lot cheaper when
+	// failures are common, like in mass scans. The timeout applies to each attempt separately
 	[[nodiscard]] inline virtual latency_t ping() const final {
 		return ping(DEFAULT_TIMEOUT);
 	}
-	[[nodiscard]] virtual latency_t ping(std::chrono::milliseconds timeout) const = 0;
+	[[nodiscard]] inline latency_t ping(std::chrono::milliseconds timeout) const {
+		return ping(timeout, default_retry_policy());
+	}
+	[[nodiscard]] inline latency_t ping(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const {
+		const result_t<latency_t> result = try_ping(timeout, retry_policy);
+
+		if (!result) {
+			throw_error(result.error());
+		}
+
+		return *result;
+	}
+
+	[[nodiscard]] inline result_t<latency_t> try_ping() const {
+		return try_ping(DEFAULT_TIMEOUT);
+	}
+	[[nodiscard]] inline result_t<latency_t> try_ping(std::chrono::milliseconds timeout) const {
+		return try_ping(timeout, default_retry_policy());
+	}
+	[[nodiscard]] virtual result_t<latency_t> try_ping(std::chrono::milliseconds timeout,
+	                                                   const RetryPolicy& retry_policy) const = 0;
 
 	[[nodiscard]] inline std::unique_ptr<McStatusResponse> status() const {
 		return status(DEFAULT_TIMEOUT);
 	}
 	[[nodiscard]] inline std::unique_ptr<McStatusResponse> status(std::chrono::milliseconds timeout) const {
-		return std::unique_ptr<McStatusResponse>{status_impl(timeout)};
+		return status(timeout, default_retry_policy());
+	}
+	[[nodiscard]] inline std::unique_ptr<McStatusResponse> status(std::chrono::milliseconds timeout,
+	                                                              const RetryPolicy& retry_policy) const {
+		return std::unique_ptr<McStatusResponse>{status_impl(timeout, retry_policy)};
+	}
+
+	[[nodiscard]] inline result_t<std::unique_ptr<McStatusResponse>> try_status() const {
+		return try_status(DEFAULT_TIMEOUT);
+	}
+	[[nodiscard]] inline result_t<std::unique_ptr<McStatusResponse>> try_status(
+	    std::chrono::milliseconds timeout) const {
+		return try_status(timeout, default_retry_policy());
+	}
+	[[nodiscard]] inline result_t<std::unique_ptr<McStatusResponse>> try_status(std::chrono::milliseconds timeout,
+	                                                                            const RetryPolicy& retry_policy) const {
+		const result_t<McStatusResponse*> result = try_status_impl(timeout, retry_policy);
+
+		if (!result) {
+			return std::unexpected{result.error()};
+		}
+
+		return std::unique_ptr<McStatusResponse>{*result};
 	}
 
 protected:
-	[[nodiscard]] virtual McStatusResponse* status_impl(std::chrono::milliseconds timeout) const = 0;
+	[[nodiscard]] virtual McStatusResponse* status_impl(std::chrono::milliseconds timeout,
+	                                                    const RetryPolicy& retry_policy) const = 0;
+	[[nodiscard]] virtual result_t<McStatusResponse*> try_status_impl(std::chrono::milliseconds timeout,
+	                                                                  const RetryPolicy& retry_policy) const = 0;
+
+	[[noreturn]] void throw_error(McError error) const;
 
 public:
 	[[nodiscard]] virtual std::string to_string() const = 0;
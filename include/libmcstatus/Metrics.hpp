@@ -0,0 +1,67 @@
+#ifndef LIBMCSTATUS_METRICS_HPP
+#define LIBMCSTATUS_METRICS_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Histogram.hpp"
+#include "McError.hpp"
+
+namespace libmcstatus {
+
+// Process-wide counters and latency histograms, recorded by the library itself (including internal retries and
+// hedged attempts). Every thread records into its own shard, so the hot path takes no locks and does no atomic
+// read-modify-write. Shards of exited threads are handed to new threads instead of being freed
+class Metrics {
+public:
+	enum class Counter : std::uint8_t {
+		queries_started,    // ping() and status() calls, no matter how many attempts they took
+		queries_succeeded,  // Failed queries are counted per McError, see Snapshot::failed()
+		attempts,           // Connection attempts, including retries and hedged ones
+		retries,
+		hedges,
+		bytes_in,
+		bytes_out,
+		lookups,  // lookup() calls
+		lookup_failures,
+		srv_queries,
+	};
+	static constexpr std::size_t COUNTERS{static_cast<std::size_t>(Counter::srv_queries) + 1};
+
+	enum class Timer : std::uint8_t {
+		query,    // Whole ping() and status() calls, including retries and backoff
+		attempt,  // Successful attempts from connecting until the response was processed
+		lookup,   // lookup() calls, including the SRV query
+	};
+	static constexpr std::size_t TIMERS{static_cast<std::size_t>(Timer::lookup) + 1};
+
+	static constexpr std::size_t ERRORS{static_cast<std::size_t>(McError::unknown) + 1};
+
+	struct Snapshot {
+		std::array<std::uint64_t, COUNTERS> counters{};
+		std::array<std::uint64_t, ERRORS> failures{};
+		std::array<Histogram, TIMERS> timers{};
+
+		[[nodiscard]] std::uint64_t counter(Counter counter) const;
+		[[nodiscard]] std::uint64_t failed(McError error) const;
+		[[nodiscard]] std::uint64_t failed() const;
+		[[nodiscard]] const Histogram& timer(Timer timer) const;
+
+		// Renders all metrics in the Prometheus text exposition format (version 0.0.4)
+		[[nodiscard]] std::string to_prometheus() const;
+	};
+
+	static void increment(Counter counter, std::uint64_t amount = 1);
+	static void record_failure(McError error);
+	static void record(Timer timer, std::chrono::steady_clock::duration value);
+
+	// Sums up the shards of all threads. Values recorded while the snapshot is taken may or may not be included
+	[[nodiscard]] static Snapshot snapshot();
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_METRICS_HPP
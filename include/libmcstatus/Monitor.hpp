@@ -0,0 +1,102 @@
+#ifndef LIBMCSTATUS_MONITOR_HPP
+#define LIBMCSTATUS_MONITOR_HPP
+
+#include <boost/asio/any_io_executor.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+
+#include "AdaptiveInterval.hpp"
+#include "JavaServer.hpp"
+#include "McError.hpp"
+#include "RetryPolicy.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+struct MonitorState;
+
+}  // namespace _impl
+
+// Polls any number of servers over and over, each at an interval of its own, and hands every result to the
+// subscribers. Due polls come off a hierarchical timer wheel (see impl/TimerWheel.hpp), so adding, updating or removing
+// a target and scheduling its next poll cost O(1) no matter how many there are, and there's no thread per target.
+// Everything runs on a strand of the executor the monitor is created with, subscribers are called on it as well.
+// Targets and subscribers can be changed from any thread
+class Monitor {
+public:
+	using target_id_t = std::uint64_t;
+	using subscription_id_t = std::uint64_t;
+
+	enum class Query : std::uint8_t { status, ping };
+
+	// How a target is polled
+	struct Poll {
+		Query query{Query::status};
+		std::chrono::milliseconds interval{std::chrono::seconds{60}};
+		std::chrono::milliseconds timeout{McServer::DEFAULT_TIMEOUT};
+		RetryPolicy retry_policy{.max_attempts = 1};
+		// Lets the interval follow how often players.online, the version or the MOTD change, starting out at interval.
+		// Pings can't see changes, so for them only the error backoff applies
+		std::optional<AdaptivePolicy> adaptive{};
+	};
+
+	struct Options {
+		// Resolution of the schedule, intervals are rounded up to whole ticks
+		std::chrono::milliseconds tick{100};
+		// Due polls wait for others to finish beyond this many
+		std::size_t max_in_flight{1024};
+		// Cap on the polls per second of all targets together, 0 for none. Once their intervals ask for more, every
+		// interval is stretched by the same factor, even beyond max_interval
+		double max_queries_per_second{0.0};
+	};
+
+	struct Result {
+		target_id_t target{0};
+		std::shared_ptr<const JavaServer> server{};
+		Query query{Query::status};
+		std::chrono::steady_clock::time_point time{};  // When the poll finished
+		// Latency of the ping or the status query, or why it failed
+		McServer::result_t<McServer::latency_t> latency{std::unexpected{McError::unknown}};
+		std::optional<JavaServer::RawStatus> status{};  // Only for successful status polls
+		// Whether players.online, the version or the MOTD differ from the previous status. Only for adaptive targets,
+		// and only once there is a previous status
+		std::optional<bool> changed{};
+		std::chrono::milliseconds interval{};  // Until the next poll of the target
+	};
+
+	// Must not throw. Blocks the strand while it runs, so hand anything expensive off to other threads
+	using subscriber_t = std::function<void(const Result& result)>;
+
+	explicit Monitor(const boost::asio::any_io_executor& executor) : Monitor{executor, Options{}} {}
+	Monitor(const boost::asio::any_io_executor& executor, Options options);
+
+	Monitor(const Monitor&) = delete;
+	Monitor& operator=(const Monitor&) = delete;
+	// Stops polling. Polls in flight still finish in the background, but their results aren't published anymore
+	~Monitor();
+
+	// The first poll happens at a random point within the first interval, so that targets added at once are spread out
+	target_id_t add(JavaServer server, const Poll& poll);
+	// The next poll is one (new) interval after the previous one, adaptive targets start adapting over from it. Returns
+	// false if there's no such target
+	bool update(target_id_t target, const Poll& poll);
+	// A poll in flight still finishes, but isn't published. Returns false if there's no such target
+	bool remove(target_id_t target);
+	[[nodiscard]] std::size_t size() const;
+
+	subscription_id_t subscribe(subscriber_t subscriber);
+	void unsubscribe(subscription_id_t subscription);
+
+private:
+	// Shared with the polls in flight, which may outlive the monitor
+	std::shared_ptr<_impl::MonitorState> state;
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_MONITOR_HPP
@@ -0,0 +1,71 @@
+#ifndef LIBMCSTATUS_MOTD_HPP
+#define LIBMCSTATUS_MOTD_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace libmcstatus {
+
+// Structured form of McStatusResponse::motd, which is either plain text with legacy § formatting codes or a JSON chat
+// component. Nothing is parsed until components() is first called, and plain_text() of plain MOTDs only strips the
+// codes, so consumers that only want the text pay for nothing else. Can be shared between any number of threads
+class Motd {
+public:
+	enum Format : std::uint8_t {
+		bold = 1 << 0,
+		italic = 1 << 1,
+		underlined = 1 << 2,
+		strikethrough = 1 << 3,
+		obfuscated = 1 << 4,
+	};
+
+	struct Component {
+		std::string_view text{};               // Unescaped and without § codes, points into the Motd
+		std::optional<std::uint32_t> color{};  // 0xRRGGBB, named and legacy colors included
+		std::uint8_t format{0};                // Format flags
+		// The component's children (extra, and text following § codes) directly follow it, up to this index. Color
+		// and format already include everything inherited from the parents
+		std::uint32_t end{0};
+	};
+
+	Motd() = default;
+	explicit Motd(std::string raw) : raw_motd{std::move(raw)} {}
+	// Copies only the raw MOTD, the copy parses again when needed
+	Motd(const Motd& other) : Motd{other.raw_motd} {}
+	Motd& operator=(const Motd& other) {
+		return *this = Motd{other};
+	}
+	Motd(Motd&& other) noexcept;
+	Motd& operator=(Motd&& other) noexcept;
+	~Motd();
+
+	[[nodiscard]] const std::string& raw() const {
+		return raw_motd;
+	}
+
+	// The text without any formatting
+	[[nodiscard]] std::string plain_text() const;
+	// All components in depth first order, starting with the root. JSON that turns out to be malformed is treated as
+	// plain text
+	[[nodiscard]] std::span<const Component> components() const;
+
+private:
+	struct Parsed {
+		std::string arena{};  // Copy of the raw MOTD, unescaped in place
+		std::vector<Component> components{};
+	};
+
+	std::string raw_motd{};
+	// Published once by whichever thread parses first, never modified afterwards
+	mutable std::atomic<const Parsed*> parsed{nullptr};
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_MOTD_HPP
@@ -0,0 +1,57 @@
+#ifndef LIBMCSTATUS_PLAYERTRACKER_HPP
+#define LIBMCSTATUS_PLAYERTRACKER_HPP
+
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "impl/ShardedMap.hpp"
+#include "impl/UuidSet.hpp"
+#include "JavaServer.hpp"
+#include "JavaStatusView.hpp"
+
+namespace libmcstatus {
+
+struct PlayerEvent {
+	enum class Type : std::uint8_t {
+		join,
+		leave,
+	};
+
+	Type type{Type::join};
+	boost::uuids::uuid id{};
+	std::string name{};  // Only known for joins, names aren't kept
+};
+
+// Compares consecutive player samples of every endpoint by UUID and reports who joined and who left. Only the UUIDs of
+// the last sample are kept, in a compact set per endpoint. Samples are all there is to go by: vanilla servers show at
+// most 12 random players, so on larger servers the events describe the sample rather than the server. Entries with the
+// nil UUID (which servers use for lines of text) are ignored. Can be shared between any number of threads
+class PlayerTracker {
+public:
+	// Updates the endpoint's players (any key that identifies a server, like JavaServer::to_string()) and returns what
+	// changed since the previous sample, joins first. The first sample of an endpoint is all joins. A status without
+	// sample counts as an empty one if nobody is online, otherwise nothing is known and the previous sample is kept
+	std::vector<PlayerEvent> update(std::string_view endpoint, const JavaServer::JavaServerResponse& status);
+	std::vector<PlayerEvent> update(std::string_view endpoint, const JavaStatusView& status);
+
+	// Forgets the endpoint, so its next sample is all joins again
+	void forget(std::string_view endpoint);
+	// Number of tracked endpoints
+	[[nodiscard]] std::size_t size() const;
+	// Bytes used by the sets of all endpoints, without the map holding them
+	[[nodiscard]] std::size_t memory_usage() const;
+
+private:
+	_impl::ShardedMap<_impl::UuidSet> players{};
+
+	template <typename Sample>
+	std::vector<PlayerEvent> update_sample(std::string_view endpoint, const Sample& sample);
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_PLAYERTRACKER_HPP
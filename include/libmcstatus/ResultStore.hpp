@@ -0,0 +1,211 @@
+#ifndef LIBMCSTATUS_RESULTSTORE_HPP
+#define LIBMCSTATUS_RESULTSTORE_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "impl/ShardedMap.hpp"
+#include "JavaServer.hpp"
+#include "McError.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+// Sections of a result store file, in the order they are written
+enum class StoreSection : std::uint8_t {
+	endpoint_offsets,
+	endpoint_bytes,
+	timestamps,
+	latencies,
+	online,
+	max,
+	protocols,
+	version_ids,
+	motd_ids,
+	icon_ids,
+	version_offsets,
+	version_bytes,
+	motd_offsets,
+	motd_bytes,
+	icon_offsets,
+	icon_bytes,
+	count,
+};
+
+constexpr std::size_t STORE_SECTIONS{static_cast<std::size_t>(StoreSection::count)};
+
+}  // namespace _impl
+
+// One row of a ResultStore. The strings point into the store
+struct StoredResult {
+	std::string_view endpoint{};
+	std::chrono::system_clock::time_point time{};
+	McServer::latency_t latency{-1};
+	McServer::response_int_t online{-1};
+	McServer::response_int_t max{-1};
+	McServer::response_int_t protocol{-1};
+	std::string_view version_name{};
+	std::string_view motd{};
+	std::optional<std::string_view> icon{};
+};
+
+// Collects results for a ResultStore file, column by column. Versions and MOTDs are dictionary encoded and icons
+// deduplicated, so each distinct one is only stored once. Not thread-safe
+class ResultStoreWriter {
+public:
+	void append(std::string_view endpoint, std::chrono::system_clock::time_point time,
+	            const JavaServer::JavaServerResponse& status);
+
+	[[nodiscard]] std::size_t size() const {
+		return timestamps.size();
+	}
+
+	// Writes all results appended so far into a new file, replacing any existing one. Throws std::runtime_error if the
+	// file can't be written
+	void write(const std::filesystem::path& path) const;
+
+private:
+	// Distinct strings, stored back to back
+	struct Dictionary {
+		std::unordered_map<std::string, std::uint32_t, _impl::StringHash, std::equal_to<>> ids{};
+		std::vector<std::uint64_t> offsets{0};
+		std::string bytes{};
+
+		[[nodiscard]] std::uint32_t id(std::string_view string);
+	};
+
+	std::vector<std::uint64_t> endpoint_offsets{0};
+	std::string endpoint_bytes{};
+	std::vector<std::int64_t> timestamps{};
+	std::vector<std::int64_t> latencies{};
+	std::vector<std::int64_t> online{};
+	std::vector<std::int64_t> max{};
+	std::vector<std::int64_t> protocols{};
+	std::vector<std::uint32_t> version_ids{};
+	std::vector<std::uint32_t> motd_ids{};
+	std::vector<std::uint32_t> icon_ids{};
+	Dictionary versions{};
+	Dictionary motds{};
+	Dictionary icons{};
+};
+
+// Read-only view of a file written by ResultStoreWriter, memory-mapped instead of read. Every column is a contiguous
+// array, so scanning one (like online()) never touches the pages of the others. The file starts with an 8 byte magic,
+// the row count and the offset and size of every section, followed by the 8 byte aligned sections in native byte
+// order. Can be shared between any number of threads
+class ResultStore {
+public:
+	static constexpr std::string_view MAGIC{"MCSTORE\x01"};
+	// Icon id of rows without an icon
+	static constexpr std::uint32_t NO_ICON{0xFFFFFFFF};
+
+	ResultStore(const ResultStore&) = delete;
+	ResultStore& operator=(const ResultStore&) = delete;
+	ResultStore(ResultStore&& other) noexcept;
+	ResultStore& operator=(ResultStore&& other) noexcept;
+	~ResultStore();
+
+	// Maps a store file and checks it. Returns McError::bad_frame if it can't be read, isn't a store or is corrupt
+	[[nodiscard]] static std::expected<ResultStore, McError> try_open(const std::filesystem::path& path);
+
+	[[nodiscard]] std::size_t size() const {
+		return rows;
+	}
+
+	// Columns, one value per row
+	[[nodiscard]] std::span<const std::int64_t> timestamps() const {  // Microseconds since the epoch
+		return column<std::int64_t>(_impl::StoreSection::timestamps);
+	}
+	[[nodiscard]] std::span<const std::int64_t> latencies() const {  // Nanoseconds
+		return column<std::int64_t>(_impl::StoreSection::latencies);
+	}
+	[[nodiscard]] std::span<const std::int64_t> online() const {
+		return column<std::int64_t>(_impl::StoreSection::online);
+	}
+	[[nodiscard]] std::span<const std::int64_t> max() const {
+		return column<std::int64_t>(_impl::StoreSection::max);
+	}
+	[[nodiscard]] std::span<const std::int64_t> protocols() const {
+		return column<std::int64_t>(_impl::StoreSection::protocols);
+	}
+	// Indices into the dictionaries below
+	[[nodiscard]] std::span<const std::uint32_t> version_ids() const {
+		return column<std::uint32_t>(_impl::StoreSection::version_ids);
+	}
+	[[nodiscard]] std::span<const std::uint32_t> motd_ids() const {
+		return column<std::uint32_t>(_impl::StoreSection::motd_ids);
+	}
+	[[nodiscard]] std::span<const std::uint32_t> icon_ids() const {  // NO_ICON for rows without one
+		return column<std::uint32_t>(_impl::StoreSection::icon_ids);
+	}
+
+	[[nodiscard]] std::string_view endpoint(std::size_t row) const;
+	// Dictionaries, by the ids of the columns above
+	[[nodiscard]] std::string_view version(std::uint32_t id) const;
+	[[nodiscard]] std::string_view motd(std::uint32_t id) const;
+	[[nodiscard]] std::string_view icon(std::uint32_t id) const;
+	[[nodiscard]] std::size_t version_count() const;
+	[[nodiscard]] std::size_t motd_count() const;
+	[[nodiscard]] std::size_t icon_count() const;
+	// Id of a version name, for filtering version_ids() without comparing strings
+	[[nodiscard]] std::optional<std::uint32_t> find_version(std::string_view name) const;
+
+	// Assembles a whole row from all columns
+	[[nodiscard]] StoredResult operator[](std::size_t row) const;
+
+	// Rows (in ascending order) whose value in the column matches the predicate, e.g.
+	// ResultStore::filter(store.online(), [](std::int64_t online) { return online > 100; })
+	template <typename T, typename Predicate>
+	[[nodiscard]] static std::vector<std::size_t> filter(std::span<const T> column, Predicate&& predicate) {
+		std::vector<std::size_t> matches;
+
+		for (std::size_t row = 0; row < column.size(); ++row) {
+			if (predicate(column[row])) {
+				matches.push_back(row);
+			}
+		}
+
+		return matches;
+	}
+
+private:
+	struct Section {
+		std::uint64_t offset{0};
+		std::uint64_t size{0};
+	};
+
+	const std::byte* data{nullptr};
+	std::size_t length{0};
+	std::size_t rows{0};
+	std::array<Section, _impl::STORE_SECTIONS> sections{};
+
+	ResultStore() = default;
+
+	template <typename T>
+	[[nodiscard]] std::span<const T> column(_impl::StoreSection section) const {
+		const Section& found = sections[static_cast<std::size_t>(section)];
+		return {reinterpret_cast<const T*>(data + found.offset), static_cast<std::size_t>(found.size / sizeof(T))};
+	}
+
+	// Element id of the strings stored in offsets and bytes
+	[[nodiscard]] std::string_view string(_impl::StoreSection offsets, _impl::StoreSection bytes,
+	                                      std::size_t id) const;
+	// Reads the header and checks everything the accessors rely on
+	[[nodiscard]] bool valid();
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_RESULTSTORE_HPP
@@ -0,0 +1,86 @@
+#ifndef LIBMCSTATUS_RETRYPOLICY_HPP
+#define LIBMCSTATUS_RETRYPOLICY_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+#include "McError.hpp"
+#include "RttEstimator.hpp"
+
+namespace libmcstatus {
+
+// Thread-safe ring buffer of the most recent attempt latencies, used to derive the hedging delay
+class LatencyWindow {
+public:
+	using duration_t = std::chrono::steady_clock::duration;
+
+	static constexpr std::size_t CAPACITY{128};
+
+	void record(duration_t latency);
+	[[nodiscard]] std::size_t size() const;
+	// Returns the given percentile (0.0 - 1.0) of the recorded latencies, if there are any
+	[[nodiscard]] std::optional<duration_t> percentile(double percentile) const;
+
+private:
+	std::array<std::atomic<duration_t::rep>, CAPACITY> samples{};
+	std::atomic_size_t count{0};
+};
+
+// Starts a second, concurrent attempt if the first one takes longer than usual. Whichever responds first wins and the
+// other one gets cancelled
+struct HedgePolicy {
+	// Latency percentile (0.0 - 1.0) of previous attempts after which the hedged attempt is started
+	double percentile{0.95};
+	// Delay used until at least min_samples latencies have been observed
+	std::chrono::milliseconds initial_delay{500};
+	std::size_t min_samples{20};
+	// Shared between all copies of this policy, so every call contributes to and benefits from the statistics
+	std::shared_ptr<LatencyWindow> latencies{std::make_shared<LatencyWindow>()};
+
+	[[nodiscard]] std::chrono::steady_clock::duration delay() const;
+};
+
+// Derives the timeout of every attempt from the round trip times observed on the same endpoint, instead of always
+// waiting the full timeout. The timeout passed alongside the policy becomes the ceiling, which is also what endpoints
+// without samples get
+struct TimeoutPolicy {
+	// Floor, so that a few fast responses don't make the next slightly slower one time out
+	std::chrono::milliseconds min_timeout{200};
+	// Shared between all copies of this policy, like HedgePolicy::latencies. Every successful attempt contributes its
+	// duration, every timed out one backs off the timeout of its endpoint
+	std::shared_ptr<RttTable> rtts{std::make_shared<RttTable>()};
+};
+
+// Per-call configuration of how often and when failed attempts are retried. The timeout passed alongside applies to
+// each attempt separately
+struct RetryPolicy {
+	// Errors that are likely to go away when trying again. Refused connections and broken responses usually don't
+	static constexpr McErrorSet DEFAULT_RETRYABLE{McError::timeout, McError::connection_reset,
+	                                              McError::host_unreachable, McError::network_error, McError::unknown};
+
+	std::size_t max_attempts{3};
+
+	// Exponential backoff between attempts: initial_backoff * backoff_multiplier^(attempt - 1), capped at max_backoff
+	std::chrono::milliseconds initial_backoff{50};
+	std::chrono::milliseconds max_backoff{1000};
+	double backoff_multiplier{2.0};
+	// Fraction of the backoff that is randomized. 1.0 means "full jitter", a uniformly random delay in [0, backoff]
+	double jitter{1.0};
+
+	McErrorSet retryable{DEFAULT_RETRYABLE};
+
+	std::optional<HedgePolicy> hedge{};
+	std::optional<TimeoutPolicy> adaptive_timeout{};
+
+	[[nodiscard]] bool should_retry(std::size_t attempt, McError error) const;
+	// Delay before the next attempt, after the given (1-based) attempt failed
+	[[nodiscard]] std::chrono::steady_clock::duration backoff(std::size_t attempt) const;
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_RETRYPOLICY_HPP
@@ -0,0 +1,68 @@
+#ifndef LIBMCSTATUS_RTTESTIMATOR_HPP
+#define LIBMCSTATUS_RTTESTIMATOR_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include "impl/ShardedMap.hpp"
+
+namespace libmcstatus {
+
+// Smoothed round trip time and its variation, computed like TCP's retransmission timeout (RFC 6298): the timeout is
+// SRTT + 4 * RTTVAR, doubled for every timeout in a row. Not thread-safe
+class RttEstimator {
+public:
+	using duration_t = std::chrono::steady_clock::duration;
+
+	void sample(duration_t rtt);
+	// Backs off the timeout until the next sample
+	void timed_out();
+
+	[[nodiscard]] bool has_samples() const {
+		return sampled;
+	}
+	[[nodiscard]] duration_t srtt() const {
+		return smoothed;
+	}
+	[[nodiscard]] duration_t rttvar() const {
+		return variation;
+	}
+	[[nodiscard]] std::size_t timeouts() const {
+		return backoffs;
+	}
+	// Clamped to [min_timeout, max_timeout], max_timeout until there are samples
+	[[nodiscard]] std::chrono::milliseconds timeout(std::chrono::milliseconds min_timeout,
+	                                                std::chrono::milliseconds max_timeout) const;
+
+private:
+	duration_t smoothed{};
+	duration_t variation{};
+	std::size_t backoffs{0};
+	bool sampled{false};
+};
+
+// RttEstimators of any number of endpoints (any key that identifies a server, like Transport::to_string()). Can be
+// shared between any number of threads
+class RttTable {
+public:
+	void sample(std::string_view endpoint, RttEstimator::duration_t rtt);
+	void timed_out(std::string_view endpoint);
+
+	// Timeout for the next attempt on the endpoint, max_timeout for endpoints without samples
+	[[nodiscard]] std::chrono::milliseconds timeout(std::string_view endpoint, std::chrono::milliseconds min_timeout,
+	                                                std::chrono::milliseconds max_timeout) const;
+	[[nodiscard]] std::optional<RttEstimator> get(std::string_view endpoint) const;
+
+	void forget(std::string_view endpoint);
+	[[nodiscard]] std::size_t size() const;
+
+private:
+	_impl::ShardedMap<RttEstimator> estimators{};
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_RTTESTIMATOR_HPP
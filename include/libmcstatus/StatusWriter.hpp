@@ -0,0 +1,93 @@
+#ifndef LIBMCSTATUS_STATUSWRITER_HPP
+#define LIBMCSTATUS_STATUSWRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "impl/EnumSet.hpp"
+#include "JavaServer.hpp"
+#include "JavaStatusView.hpp"
+#include "McError.hpp"
+
+namespace libmcstatus {
+
+// Fields of a status, as read by the parser, plus the latency of the query
+enum class StatusField : std::uint8_t {
+	version,
+	players,  // online and max
+	sample,
+	description,
+	enforces_secure_chat,
+	icon,
+	forge_data,
+	latency,
+};
+
+// Small set of StatusField values, selecting what a StatusWriter writes
+using StatusFields = _impl::EnumSet<StatusField>;
+
+// Writes statuses as newline delimited JSON (one object per line), straight from the status fields without building a
+// DOM first. Every line has the endpoint, followed by the selected fields under the same keys as in the status JSON
+// (version, players, description, enforcesSecureChat, favicon, forgeData) and latency_us, so lines can be fed back
+// into the parser. Strings are appended to directly, streams and file descriptors get the output in chunks of about
+// BUFFER_SIZE. Not thread-safe
+class StatusWriter {
+public:
+	// Once this much is buffered, it gets written out
+	static constexpr std::size_t BUFFER_SIZE{64 * 1024};
+
+	// Appends to the string
+	explicit StatusWriter(std::string& output) : StatusWriter{output, StatusFields::all()} {}
+	StatusWriter(std::string& output, StatusFields fields) : output{&output}, fields{fields} {}
+	// Writes to the stream, which has to stay open as long as the writer lives
+	explicit StatusWriter(std::FILE* file) : StatusWriter{file, StatusFields::all()} {}
+	StatusWriter(std::FILE* file, StatusFields fields);
+	// Writes to the file descriptor, which has to stay open as long as the writer lives
+	explicit StatusWriter(int fd) : StatusWriter{fd, StatusFields::all()} {}
+	StatusWriter(int fd, StatusFields fields);
+
+	StatusWriter(const StatusWriter&) = delete;
+	StatusWriter& operator=(const StatusWriter&) = delete;
+	// Flushes, but ignores errors. Call flush() first to see them
+	~StatusWriter();
+
+	void write(std::string_view endpoint, const JavaServer::JavaServerResponse& status);
+	void write(std::string_view endpoint, const JavaStatusView& status);
+	// A line with nothing but the endpoint and "error", the name of the error
+	void write(std::string_view endpoint, McError error);
+
+	// Writes out everything buffered. Throws std::system_error if the stream or file descriptor fails
+	void flush();
+
+private:
+	std::string buffer{};
+	std::string* output;
+	std::FILE* file{nullptr};
+	int fd{-1};
+	StatusFields fields;
+
+	void begin(std::string_view endpoint);
+	void end();
+	void key(std::string_view name);
+	void string(std::string_view value);
+	void integer(std::int64_t value);
+	// Raw JSON, written without whitespace if it is valid and as a string otherwise
+	void json(std::string_view value);
+
+	// Fields shared by all kinds of statuses, each only if it is selected
+	void version(std::string_view name, McServer::response_int_t protocol);
+	template <typename Player>
+	void players(McServer::response_int_t max, McServer::response_int_t online,
+	             const std::optional<std::vector<Player>>& sample);
+	void rest(std::optional<bool> enforces_secure_chat, std::optional<std::string_view> icon,
+	          std::optional<std::string_view> forge_data, McServer::latency_t latency);
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_STATUSWRITER_HPP
@@ -0,0 +1,103 @@
+#ifndef LIBMCSTATUS_TRAFFICLOG_HPP
+#define LIBMCSTATUS_TRAFFICLOG_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "McError.hpp"
+#include "McPacket.hpp"
+#include "Transport.hpp"
+
+namespace libmcstatus {
+
+// Everything sent and received on one connection, as the raw (framed) bytes that went over the wire
+struct TrafficRecord {
+	std::chrono::system_clock::time_point time{};  // When the connection was opened
+	std::string endpoint{};
+	McPacket::buffer_t sent{};
+	McPacket::buffer_t received{};
+};
+
+// Append-only log file of TrafficRecords. The file starts with an 8 byte header, followed by the records, each a
+// RecordHeader in native byte order and then the endpoint, sent and received bytes. Records of any size are kept.
+// Appending is thread-safe
+class TrafficLog {
+private:
+	std::mutex mutex;
+	std::ofstream file;
+
+public:
+	static constexpr std::string_view MAGIC{"MCSTLOG\x02"};
+
+	struct RecordHeader {
+		std::int64_t time{0};  // In microseconds since the epoch
+		std::uint64_t endpoint_size{0};
+		std::uint64_t sent_size{0};
+		std::uint64_t received_size{0};
+	};
+
+	// Appends to the file if it exists. Throws std::runtime_error if the file can't be opened
+	explicit TrafficLog(const std::filesystem::path& path);
+
+	// Returns false if the record couldn't be written, like when the disk is full. The log stays failed afterwards
+	bool append(const TrafficRecord& record);
+	// Throws std::system_error if writing any record or flushing failed
+	void flush();
+
+	// Reads a log file one record at a time, passing each to the function as it is read, so only one record is in
+	// memory at once. Returns the number of records, or McError::bad_frame if the file is unreadable, isn't a log or
+	// is corrupt, in which case the function may have seen the records before the corrupt one
+	[[nodiscard]] static std::expected<std::size_t, McError> try_for_each(
+	    const std::filesystem::path& path, const std::function<void(TrafficRecord&& record)>& function);
+	// Reads all records of a log file, like try_for_each()
+	[[nodiscard]] static std::expected<std::vector<TrafficRecord>, McError> try_read(
+	    const std::filesystem::path& path);
+};
+
+// Passes everything through to another transport, and appends a record of every connection to a TrafficLog once the
+// connection is closed
+class RecordingTransport : public Transport {
+private:
+	std::shared_ptr<const Transport> transport;
+	std::shared_ptr<TrafficLog> log;
+
+public:
+	RecordingTransport(std::shared_ptr<const Transport> transport, std::shared_ptr<TrafficLog> log);
+
+	[[nodiscard]] std::unique_ptr<Connection> connection(const boost::asio::any_io_executor& executor) const override;
+	[[nodiscard]] std::string host() const override;
+	[[nodiscard]] boost::asio::ip::port_type port() const override;
+	[[nodiscard]] std::string to_string() const override;
+};
+
+// Replays recorded connections without touching the network, as fast as they are read. Every new connection replays
+// the next record, starting over after the last one. Whatever gets written is discarded, so replayed pings fail with
+// McError::bad_response, as their random tokens never match the recorded ones
+class ReplayTransport : public Transport {
+private:
+	std::shared_ptr<const std::vector<TrafficRecord>> records;
+	mutable std::atomic_size_t next{0};
+
+public:
+	explicit ReplayTransport(std::vector<TrafficRecord> records);
+
+	[[nodiscard]] std::unique_ptr<Connection> connection(const boost::asio::any_io_executor& executor) const override;
+	[[nodiscard]] std::string host() const override;
+	[[nodiscard]] boost::asio::ip::port_type port() const override;
+	[[nodiscard]] std::string to_string() const override;
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_TRAFFICLOG_HPP
@@ -0,0 +1,101 @@
+#ifndef LIBMCSTATUS_TRANSPORT_HPP
+#define LIBMCSTATUS_TRANSPORT_HPP
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "McError.hpp"
+
+namespace libmcstatus {
+
+// How a server is reached. A transport is a factory for connections, and has to be thread-safe, as one transport may be
+// shared by any number of servers and threads
+class Transport {
+public:
+	// One connection, used by a single query attempt. Closing it makes all pending operations fail right away
+	class Connection {
+	public:
+		virtual ~Connection() = default;
+
+		[[nodiscard]] virtual boost::asio::awaitable<std::expected<void, McError>> async_connect() = 0;
+		// Reads at least one byte
+		[[nodiscard]] virtual boost::asio::awaitable<std::expected<std::size_t, McError>> async_read_some(
+		    boost::asio::mutable_buffer buffer) = 0;
+		// Writes the whole buffer
+		[[nodiscard]] virtual boost::asio::awaitable<std::expected<void, McError>> async_write(
+		    boost::asio::const_buffer buffer) = 0;
+		virtual void close() = 0;
+	};
+
+	virtual ~Transport() = default;
+
+	[[nodiscard]] virtual std::unique_ptr<Connection> connection(
+	    const boost::asio::any_io_executor& executor) const = 0;
+
+	// Address and port to announce in the handshake
+	[[nodiscard]] virtual std::string host() const = 0;
+	[[nodiscard]] virtual boost::asio::ip::port_type port() const = 0;
+
+	[[nodiscard]] virtual std::string to_string() const = 0;
+};
+
+class TcpTransport : public Transport {
+private:
+	boost::asio::ip::tcp::endpoint server_address;
+
+public:
+	explicit TcpTransport(boost::asio::ip::tcp::endpoint server_address);
+
+	[[nodiscard]] const boost::asio::ip::tcp::endpoint& endpoint() const {
+		return server_address;
+	}
+
+	[[nodiscard]] std::unique_ptr<Connection> connection(const boost::asio::any_io_executor& executor) const override;
+	[[nodiscard]] std::string host() const override;
+	[[nodiscard]] boost::asio::ip::port_type port() const override;
+	[[nodiscard]] std::string to_string() const override;
+};
+
+// Connects to a UNIX domain socket, for example one a proxy listens on
+class UnixTransport : public Transport {
+private:
+	std::string path;
+
+public:
+	explicit UnixTransport(std::string path);
+
+	[[nodiscard]] std::unique_ptr<Connection> connection(const boost::asio::any_io_executor& executor) const override;
+	[[nodiscard]] std::string host() const override;
+	[[nodiscard]] boost::asio::ip::port_type port() const override;
+	[[nodiscard]] std::string to_string() const override;
+};
+
+// In-memory duplex pipe, which never touches the network stack. Every connection spawns the handler with the server end
+// of a new pipe on the connection's executor, and both ends use the Connection interface. Closing either end closes the
+// whole pipe. Meant for tests and benchmarks, so both ends have to run on the same single-threaded executor
+class MemoryTransport : public Transport {
+public:
+	using handler_t = std::function<boost::asio::awaitable<void>(std::shared_ptr<Connection> server_end)>;
+
+private:
+	handler_t handler;
+
+public:
+	explicit MemoryTransport(handler_t handler);
+
+	[[nodiscard]] std::unique_ptr<Connection> connection(const boost::asio::any_io_executor& executor) const override;
+	[[nodiscard]] std::string host() const override;
+	[[nodiscard]] boost::asio::ip::port_type port() const override;
+	[[nodiscard]] std::string to_string() const override;
+};
+
+}  // namespace libmcstatus
+
+#endif  // LIBMCSTATUS_TRANSPORT_HPP
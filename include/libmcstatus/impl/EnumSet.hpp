@@ -0,0 +1,53 @@
+#ifndef LIBMCSTATUS_ENUMSET_HPP
+#define LIBMCSTATUS_ENUMSET_HPP
+
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+namespace libmcstatus::_impl {
+
+// Small set of the values of an enum, one bit each. Values have to be below 32
+template <typename Enum>
+class EnumSet {
+private:
+	static_assert(std::is_enum_v<Enum>);
+
+	std::uint32_t bits{0};
+
+	static constexpr std::uint32_t bit(Enum value) {
+		return std::uint32_t{1} << static_cast<std::underlying_type_t<Enum>>(value);
+	}
+
+public:
+	constexpr EnumSet() = default;
+	constexpr EnumSet(std::initializer_list<Enum> values) {
+		for (Enum value : values) {
+			insert(value);
+		}
+	}
+
+	[[nodiscard]] static constexpr EnumSet all() {
+		EnumSet set;
+		set.bits = ~std::uint32_t{0};
+		return set;
+	}
+
+	[[nodiscard]] constexpr bool contains(Enum value) const {
+		return (bits & bit(value)) != 0;
+	}
+	constexpr EnumSet& insert(Enum value) {
+		bits |= bit(value);
+		return *this;
+	}
+	constexpr EnumSet& erase(Enum value) {
+		bits &= ~bit(value);
+		return *this;
+	}
+
+	constexpr bool operator==(const EnumSet& rhs) const = default;
+};
+
+}  // namespace libmcstatus::_impl
+
+#endif  // LIBMCSTATUS_ENUMSET_HPP
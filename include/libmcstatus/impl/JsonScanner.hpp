@@ -0,0 +1,110 @@
+#ifndef LIBMCSTATUS_JSONSCANNER_HPP
+#define LIBMCSTATUS_JSONSCANNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace libmcstatus::_impl {
+
+// Minimal validating JSON scanner, for pulling single fields out of a document without building a DOM. Strings are
+// unescaped in place, so the buffer has to be writable and the returned views point into it. Values that are skipped
+// are left untouched, so their raw JSON text can be kept. Any function returning false or std::nullopt means the input
+// is malformed, the scanner must not be used anymore afterwards. Strings are not checked for valid UTF-8
+class JsonScanner {
+private:
+	char* position;
+	char* end;
+	std::size_t depth{0};
+	bool unescape{true};  // Whether strings (including keys) get unescaped in place
+
+	[[nodiscard]] bool skip_literal(std::string_view literal);
+	[[nodiscard]] bool skip_number(bool& integer);
+	[[nodiscard]] bool skip_unicode_escape(char*& out);
+
+public:
+	// Same limit as Boost.JSON's default
+	static constexpr std::size_t MAX_DEPTH{32};
+
+	JsonScanner(char* begin, char* end) : position{begin}, end{end} {}
+	// Only validates, strings (including keys) are returned as they are, escapes and all. Nothing is ever written, so
+	// casting away const is fine
+	JsonScanner(const char* begin, const char* end)
+	    : position{const_cast<char*>(begin)}, end{const_cast<char*>(end)}, unescape{false} {}
+
+	// Where the scanner currently is, for remembering the offsets of values
+	[[nodiscard]] const char* current() const {
+		return position;
+	}
+
+	void skip_whitespace();
+	// Skips whitespace and returns the next character (or '\0' at the end), without consuming it
+	[[nodiscard]] char peek();
+	// Skips whitespace and consumes the next character if it is the expected one
+	[[nodiscard]] bool consume(char expected);
+	// Skips whitespace and reports whether the whole input has been consumed
+	[[nodiscard]] bool at_end();
+
+	[[nodiscard]] std::optional<std::string_view> read_string();
+	// Skips any value and returns its raw JSON text
+	[[nodiscard]] std::optional<std::string_view> skip_value();
+
+	// Conversions of raw values returned by skip_value(), which return std::nullopt if the value has a different type.
+	// Only valid JSON integers without fraction or exponent that fit into an std::int64_t count as such
+	[[nodiscard]] static std::optional<std::int64_t> to_int64(std::string_view raw);
+	[[nodiscard]] static std::optional<bool> to_bool(std::string_view raw);
+
+	// Calls member(key) for every member of an object, with the scanner positioned on the member's value. member has to
+	// consume the value and return whether that succeeded
+	template <typename Member>
+	[[nodiscard]] bool object(Member&& member) {
+		if (!consume('{') || (++depth > MAX_DEPTH)) {
+			return false;
+		}
+
+		if (!consume('}')) {
+			do {
+				const std::optional<std::string_view> key = read_string();
+				if (!key || !consume(':') || !member(*key)) {
+					return false;
+				}
+			} while (consume(','));
+
+			if (!consume('}')) {
+				return false;
+			}
+		}
+
+		--depth;
+		return true;
+	}
+
+	// Calls element() for every element of an array, with the scanner positioned on the element. element has to consume
+	// it and return whether that succeeded
+	template <typename Element>
+	[[nodiscard]] bool array(Element&& element) {
+		if (!consume('[') || (++depth > MAX_DEPTH)) {
+			return false;
+		}
+
+		if (!consume(']')) {
+			do {
+				if (!element()) {
+					return false;
+				}
+			} while (consume(','));
+
+			if (!consume(']')) {
+				return false;
+			}
+		}
+
+		--depth;
+		return true;
+	}
+};
+
+}  // namespace libmcstatus::_impl
+
+#endif  // LIBMCSTATUS_JSONSCANNER_HPP
@@ -0,0 +1,130 @@
+#ifndef LIBMCSTATUS_SHARDEDMAP_HPP
+#define LIBMCSTATUS_SHARDEDMAP_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace libmcstatus::_impl {
+
+// Transparent hash, so maps keyed by std::string can be looked up with std::string_view without a copy
+struct StringHash {
+	using is_transparent = void;
+
+	[[nodiscard]] std::size_t operator()(std::string_view string) const {
+		return std::hash<std::string_view>{}(string);
+	}
+};
+
+// Any container, split into SHARDS parts behind a mutex each, so threads working on different keys rarely wait for
+// each other. Which shard a key belongs to is up to the caller's hash
+template <typename Container>
+class Sharded {
+public:
+	static constexpr std::size_t SHARDS{16};
+
+	// Calls function(container) on the shard of the hash, under its lock
+	template <typename Function>
+	decltype(auto) with_shard(std::size_t hash, Function&& function) {
+		Shard& shard = shards[hash % SHARDS];
+		const std::lock_guard lock{shard.mutex};
+		return std::forward<Function>(function)(shard.container);
+	}
+	template <typename Function>
+	decltype(auto) with_shard(std::size_t hash, Function&& function) const {
+		const Shard& shard = shards[hash % SHARDS];
+		const std::lock_guard lock{shard.mutex};
+		return std::forward<Function>(function)(shard.container);
+	}
+
+	// Calls function(container) on every shard in turn, each under its lock
+	template <typename Function>
+	void for_each_shard(Function&& function) {
+		for (Shard& shard : shards) {
+			const std::lock_guard lock{shard.mutex};
+			function(shard.container);
+		}
+	}
+	template <typename Function>
+	void for_each_shard(Function&& function) const {
+		for (const Shard& shard : shards) {
+			const std::lock_guard lock{shard.mutex};
+			function(shard.container);
+		}
+	}
+
+	[[nodiscard]] std::size_t size() const {
+		std::size_t size = 0;
+		for_each_shard([&](const Container& container) { size += container.size(); });
+		return size;
+	}
+
+private:
+	struct Shard {
+		mutable std::mutex mutex;
+		Container container;
+	};
+
+	std::array<Shard, SHARDS> shards{};
+};
+
+// Thread-safe map from endpoints (or any other string) to values
+template <typename Value>
+class ShardedMap : public Sharded<std::unordered_map<std::string, Value, StringHash, std::equal_to<>>> {
+public:
+	using map_t = std::unordered_map<std::string, Value, StringHash, std::equal_to<>>;
+
+	// Calls function(value) on the value of the key under its shard's lock, default constructing it if there is none
+	template <typename Function>
+	decltype(auto) with(std::string_view key, Function&& function) {
+		return this->with_shard(StringHash{}(key), [&](map_t& map) -> decltype(auto) {
+			auto existing = map.find(key);
+			if (existing == map.end()) {
+				existing = map.emplace(std::string{key}, Value{}).first;
+			}
+			return std::forward<Function>(function)(existing->second);
+		});
+	}
+
+	// A copy of the value, if there is one
+	[[nodiscard]] std::optional<Value> get(std::string_view key) const {
+		return this->with_shard(StringHash{}(key), [&](const map_t& map) -> std::optional<Value> {
+			if (const auto existing = map.find(key); existing != map.end()) {
+				return existing->second;
+			}
+			return std::nullopt;
+		});
+	}
+
+	void put(std::string_view key, Value value) {
+		with(key, [&](Value& existing) { existing = std::move(value); });
+	}
+
+	void erase(std::string_view key) {
+		this->with_shard(StringHash{}(key), [&](map_t& map) {
+			if (const auto existing = map.find(key); existing != map.end()) {
+				map.erase(existing);
+			}
+		});
+	}
+
+	// Calls function(key, value) on every entry, holding the lock of one shard at a time
+	template <typename Function>
+	void for_each(Function&& function) const {
+		this->for_each_shard([&](const map_t& map) {
+			for (const auto& [key, value] : map) {
+				function(key, value);
+			}
+		});
+	}
+};
+
+}  // namespace libmcstatus::_impl
+
+#endif  // LIBMCSTATUS_SHARDEDMAP_HPP
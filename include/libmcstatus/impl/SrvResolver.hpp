@@ -3,11 +3,14 @@
 
 #include <compare>
 #include <cstdint>
+#include <expected>
 #include <string>
 #include <string_view>
 #include <set>
 #include <random>
 
+#include "libmcstatus/McError.hpp"
+
 namespace libmcstatus::_impl {
 
 struct SrvRecord {
@@ -23,9 +26,13 @@ struct SrvRecord {
 
 using records_t = std::multiset<SrvRecord>;
 
-extern std::minstd_rand rng;
+// Used by pick_record, one per thread
+extern thread_local std::minstd_rand rng;
 
 records_t resolve_srv(std::string_view service, std::string_view proto, std::string_view domain);
+// Returns McError::resolve_failed instead of throwing if the query fails
+std::expected<records_t, McError> try_resolve_srv(std::string_view service, std::string_view proto,
+                                                  std::string_view domain);
 const SrvRecord& pick_record(const records_t& records);
 
 }  // namespace libmcstatus::_impl
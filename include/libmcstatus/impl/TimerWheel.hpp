@@ -0,0 +1,67 @@
+#ifndef LIBMCSTATUS_TIMERWHEEL_HPP
+#define LIBMCSTATUS_TIMERWHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace libmcstatus::_impl {
+
+// Hierarchical timing wheel over integer ticks, like the one of the Linux kernel: LEVELS wheels of SLOTS slots each,
+// where level n holds the timers due in less than SLOTS^(n + 1) ticks, so scheduling is O(1) no matter how many timers
+// there are. Whenever a wheel comes around, the next slot of the level above is cascaded down into it. Timers can't be
+// cancelled, the owner tells stale ones apart by their generation instead. Not thread-safe
+class TimerWheel {
+public:
+	using tick_t = std::uint64_t;
+
+	static constexpr std::size_t SLOT_BITS{8};
+	static constexpr std::size_t SLOTS{std::size_t{1} << SLOT_BITS};
+	static constexpr std::size_t LEVELS{4};
+	// Timers further out than this are due at the last tick of the top level instead, and get rescheduled by the owner
+	static constexpr tick_t MAX_DELAY{(tick_t{1} << (SLOT_BITS * LEVELS)) - 1};
+
+	struct Timer {
+		std::uint64_t id{0};
+		std::uint32_t generation{0};
+	};
+
+	explicit TimerWheel(tick_t now = 0) : current{now} {}
+
+	// Due at the given tick, or at the next one if that has passed already
+	void schedule(tick_t due, Timer timer);
+
+	// Advances to now and appends every timer due until then to expired, in the order they were due
+	void advance(tick_t now, std::vector<Timer>& expired);
+
+	// Earliest tick after the current one at which advance() expires or cascades anything, empty if there are no
+	// timers. May be earlier than the next timer that is actually due, when it is on one of the upper levels
+	[[nodiscard]] std::optional<tick_t> next_tick() const;
+
+	[[nodiscard]] tick_t now() const {
+		return current;
+	}
+	[[nodiscard]] std::size_t size() const {
+		return count;
+	}
+
+private:
+	struct Entry {
+		tick_t due{0};
+		Timer timer{};
+	};
+
+	std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> wheels{};
+	tick_t current;
+	std::size_t count{0};
+
+	void insert(Entry entry);
+	// Moves the timers of the slot the level above the given one has reached into the lower levels
+	void cascade(std::size_t level);
+};
+
+}  // namespace libmcstatus::_impl
+
+#endif  // LIBMCSTATUS_TIMERWHEEL_HPP
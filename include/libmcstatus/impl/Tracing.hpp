@@ -0,0 +1,16 @@
+#ifndef LIBMCSTATUS_TRACING_HPP
+#define LIBMCSTATUS_TRACING_HPP
+
+// USDT (SystemTap / DTrace style) static tracepoints, enabled by configuring with -DLIBMCSTATUS_ENABLE_USDT=ON. Each
+// probe is a single nop instruction plus an ELF note, which bpftrace or perf can attach to at runtime. Without the
+// option, the probes compile to nothing at all. Keep the arguments cheap to compute, as they are evaluated even while
+// nobody is tracing. List the probes with: bpftrace -l 'usdt:/path/to/binary:libmcstatus:*'
+#ifdef LIBMCSTATUS_ENABLE_USDT
+#include <sys/sdt.h>
+
+#define LIBMCSTATUS_TRACE(name, ...) STAP_PROBEV(libmcstatus, name __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define LIBMCSTATUS_TRACE(name, ...) static_cast<void>(0)
+#endif
+
+#endif  // LIBMCSTATUS_TRACING_HPP
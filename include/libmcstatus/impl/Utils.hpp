@@ -2,11 +2,36 @@
 #define LIBMCSTATUS_UTILS_HPP
 
 #include <boost/asio/ip/basic_endpoint.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
 #include <string_view>
 
 namespace libmcstatus::_impl {
 
 boost::asio::ip::port_type parse_port(std::string_view port_string);
+// Accepts both the dashed (8-4-4-4-12) and the plain 32 digit hex form
+std::optional<boost::uuids::uuid> parse_uuid(std::string_view uuid_string);
+// Decodes exactly 32 hex digits (either case) into 16 bytes, returns false if any of them isn't one. Uses SSE2 where
+// available, decode_hex_scalar() otherwise
+bool decode_hex(const char* digits, std::uint8_t* bytes);
+bool decode_hex_scalar(const char* digits, std::uint8_t* bytes);
+// Fast 64 bit hash, eight bytes at a time. Tells payloads apart, but isn't meant to withstand crafted collisions
+std::uint64_t hash_bytes(std::string_view data, std::uint64_t seed = 0);
+// Offset of the first § (the legacy formatting code prefix, UTF-8 encoded) at or after from, text.size() if there is
+// none. Uses SSE2 where available, find_section_sign_scalar() otherwise
+std::size_t find_section_sign(std::string_view text, std::size_t from = 0);
+std::size_t find_section_sign_scalar(std::string_view text, std::size_t from = 0);
+// Offset of the first character at or after from that has to be escaped in a JSON string (quote, backslash or control
+// character), text.size() if there is none. Uses SSE2 where available, find_json_escape_scalar() otherwise
+std::size_t find_json_escape(std::string_view text, std::size_t from = 0);
+std::size_t find_json_escape_scalar(std::string_view text, std::size_t from = 0);
+// Length of the UTF-8 sequence starting with lead, 1 for anything that can't start one
+std::size_t utf8_length(char lead);
+// Text without any legacy formatting codes (§ and the character following it)
+std::string strip_formatting_codes(std::string_view text);
 
 }
 
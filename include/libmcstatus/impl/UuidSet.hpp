@@ -0,0 +1,55 @@
+#ifndef LIBMCSTATUS_UUIDSET_HPP
+#define LIBMCSTATUS_UUIDSET_HPP
+
+#include <boost/uuid/uuid.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace libmcstatus::_impl {
+
+// Open addressing set of UUIDs with linear probing, made to be small: one allocation holding nothing but the UUIDs,
+// with the nil UUID marking empty slots (so it can't be stored). There is no erase, sets get rebuilt instead
+class UuidSet {
+private:
+	std::unique_ptr<boost::uuids::uuid[]> slots{};
+	std::uint32_t capacity{0};  // Always a power of two, or zero
+	std::uint32_t count{0};
+
+	[[nodiscard]] std::uint32_t slot_of(const boost::uuids::uuid& id) const;
+	void rehash(std::uint32_t new_capacity);
+
+public:
+	UuidSet() = default;
+	UuidSet(UuidSet&&) noexcept = default;
+	UuidSet& operator=(UuidSet&&) noexcept = default;
+
+	// Returns false if the UUID is in the set already
+	bool insert(const boost::uuids::uuid& id);
+	[[nodiscard]] bool contains(const boost::uuids::uuid& id) const;
+
+	// Empties the set and makes sure it can take expected UUIDs without growing. Keeps the memory if it fits, and frees
+	// it if nothing is expected
+	void clear(std::size_t expected);
+
+	[[nodiscard]] std::size_t size() const {
+		return count;
+	}
+	// Bytes allocated by the set
+	[[nodiscard]] std::size_t memory_usage() const {
+		return capacity * sizeof(boost::uuids::uuid);
+	}
+
+	template <typename Function>
+	void for_each(Function&& function) const {
+		for (std::uint32_t slot = 0; slot < capacity; ++slot) {
+			if (!slots[slot].is_nil()) {
+				function(slots[slot]);
+			}
+		}
+	}
+};
+
+}  // namespace libmcstatus::_impl
+
+#endif  // LIBMCSTATUS_UUIDSET_HPP
@@ -0,0 +1,60 @@
+#include "libmcstatus/AdaptiveInterval.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace libmcstatus {
+
+namespace {
+
+double to_ms(std::chrono::milliseconds duration) {
+	return static_cast<double>(duration.count());
+}
+
+}  // namespace
+
+AdaptiveInterval::AdaptiveInterval(const AdaptivePolicy& policy, std::chrono::milliseconds initial)
+    : policy{policy},
+      interval_ms{std::clamp(to_ms(initial), to_ms(policy.min_interval),
+                             std::max(to_ms(policy.min_interval), to_ms(policy.max_interval)))},
+      // Starts out at the target, so the first polls don't move the interval too far either way
+      rate{std::clamp(policy.target_change_rate, 0.0, 1.0)} {}
+
+void AdaptiveInterval::success(std::optional<bool> changed) {
+	failed = 0;
+
+	if (!changed) {
+		return;
+	}
+
+	const double smoothing = std::clamp(policy.smoothing, 0.0, 1.0);
+	rate = ((1.0 - smoothing) * rate) + (smoothing * (*changed ? 1.0 : 0.0));
+
+	// More changes than wanted shorten the interval, fewer lengthen it. Never dividing by zero, servers that never
+	// change just keep growing by max_step until they hit max_interval
+	const double max_step = std::max(policy.max_step, 1.0);
+	const double step = std::clamp(std::clamp(policy.target_change_rate, 0.0, 1.0) / std::max(rate, 1e-3),
+	                               1.0 / max_step, max_step);
+
+	interval_ms = std::clamp(interval_ms * step, to_ms(policy.min_interval),
+	                         std::max(to_ms(policy.min_interval), to_ms(policy.max_interval)));
+}
+
+void AdaptiveInterval::failure() {
+	++failed;
+}
+
+std::chrono::milliseconds AdaptiveInterval::next() const {
+	// pow() may overflow to infinity after enough failures, which min() takes care of
+	const double backoff = interval_ms * std::pow(std::max(policy.error_backoff, 1.0), static_cast<double>(failed));
+
+	const double capped = std::min(backoff, std::max(interval_ms, to_ms(policy.max_interval)));
+
+	return std::chrono::milliseconds{static_cast<std::chrono::milliseconds::rep>(capped)};
+}
+
+std::chrono::milliseconds AdaptiveInterval::interval() const {
+	return std::chrono::milliseconds{static_cast<std::chrono::milliseconds::rep>(interval_ms)};
+}
+
+}  // namespace libmcstatus
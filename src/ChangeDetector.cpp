@@ -0,0 +1,125 @@
+#include "libmcstatus/ChangeDetector.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include "libmcstatus/impl/JsonScanner.hpp"
+#include "libmcstatus/impl/Utils.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+using JavaServerResponse = JavaServer::JavaServerResponse;
+
+// Offset of the value of players.online, in a status that is known to be valid
+std::optional<std::size_t> find_online(std::string_view json) {
+	JsonScanner scanner{json.data(), json.data() + json.size()};
+	std::optional<std::size_t> offset;
+
+	std::ignore = scanner.object([&](std::string_view key) {
+		if ((key != "players") || (scanner.peek() != '{')) {
+			return scanner.skip_value().has_value();
+		}
+
+		return scanner.object([&](std::string_view players_key) {
+			if (players_key == "online") {
+				scanner.skip_whitespace();
+				offset = static_cast<std::size_t>(scanner.current() - json.data());
+			}
+			return scanner.skip_value().has_value();
+		});
+	});
+
+	return offset;
+}
+
+// Copy of the previous status with nothing but the online players changed. Players and version are copied as well,
+// so the two statuses share nothing
+std::shared_ptr<const JavaServerResponse> with_online(const JavaServerResponse& previous,
+                                                      McServer::response_int_t online,
+                                                      const JavaServer::RawStatus& raw_status) {
+	auto players = std::make_shared<JavaServerResponse::JavaStatusPlayers>(*previous.players);
+	players->online = online;
+
+	auto status = std::make_shared<JavaServerResponse>(
+	    std::move(players), std::make_shared<JavaServerResponse::JavaStatusVersion>(*previous.version));
+	status->motd = previous.motd;
+	status->latency = raw_status.latency;
+	status->timings = raw_status.timings;
+	status->enforces_secure_chat = previous.enforces_secure_chat;
+	status->icon = previous.icon;
+	status->forge_data = previous.forge_data;
+
+	return status;
+}
+
+}  // namespace _impl
+
+auto ChangeDetector::update(std::string_view endpoint, const JavaServer::RawStatus& raw_status)
+    -> McServer::result_t<Update> {
+	const std::string_view json = raw_status.json();
+	const std::uint64_t hash = _impl::hash_bytes(json);
+
+	std::optional<Entry> previous = entries.get(endpoint);
+
+	if (previous && (previous->hash == hash)) {
+		return Update{Change::unchanged, previous->status};
+	}
+
+	// Same bytes before and after players.online means nothing else can have changed
+	if (previous && previous->online_offset && (*previous->online_offset <= json.size())) {
+		const std::size_t offset = *previous->online_offset;
+		const std::size_t end = std::min(json.find_first_not_of("-0123456789", offset), json.size());
+		const std::optional<std::int64_t> online = _impl::JsonScanner::to_int64(json.substr(offset, end - offset));
+
+		if (online && (_impl::hash_bytes(json.substr(0, offset)) == previous->prefix_hash) &&
+		    (_impl::hash_bytes(json.substr(end)) == previous->suffix_hash)) {
+			previous->hash = hash;
+			previous->status = _impl::with_online(*previous->status, *online, raw_status);
+			entries.put(endpoint, *previous);
+
+			return Update{Change::online_only, std::move(previous->status)};
+		}
+	}
+
+	McServer::result_t<std::unique_ptr<_impl::JavaServerResponse>> status = JavaServer::try_parse_status(raw_status);
+	if (!status) {
+		forget(endpoint);
+		return std::unexpected{status.error()};
+	}
+
+	Entry entry{.hash = hash, .online_offset = _impl::find_online(json), .status = std::move(*status)};
+	if (entry.online_offset) {
+		const std::size_t end = std::min(json.find_first_not_of("-0123456789", *entry.online_offset), json.size());
+		entry.prefix_hash = _impl::hash_bytes(json.substr(0, *entry.online_offset));
+		entry.suffix_hash = _impl::hash_bytes(json.substr(end));
+	}
+
+	std::shared_ptr<const _impl::JavaServerResponse> parsed = entry.status;
+	entries.put(endpoint, std::move(entry));
+
+	return Update{Change::changed, std::move(parsed)};
+}
+
+auto ChangeDetector::try_poll(const JavaServer& server, std::chrono::milliseconds timeout,
+                              const RetryPolicy& retry_policy) -> McServer::result_t<Update> {
+	const McServer::result_t<JavaServer::RawStatus> raw_status = server.try_status_raw(timeout, retry_policy);
+
+	if (!raw_status) {
+		return std::unexpected{raw_status.error()};
+	}
+
+	return update(server.to_string(), *raw_status);
+}
+
+void ChangeDetector::forget(std::string_view endpoint) {
+	entries.erase(endpoint);
+}
+
+std::size_t ChangeDetector::size() const {
+	return entries.size();
+}
+
+}  // namespace libmcstatus
@@ -0,0 +1,80 @@
+#include "libmcstatus/Histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace libmcstatus {
+
+void Histogram::record(duration_t value) {
+	const auto nanoseconds = static_cast<std::uint64_t>(
+	    std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(value).count(), std::int64_t{0}));
+
+	++counts[bucket_index(nanoseconds)];
+	++count;
+	sum += nanoseconds;
+}
+
+void Histogram::merge(const Histogram& other) {
+	for (std::size_t i = 0; i < BUCKETS; ++i) {
+		counts[i] += other.counts[i];
+	}
+
+	count += other.count;
+	sum += other.sum;
+}
+
+auto Histogram::percentile(double percentile) const -> duration_t {
+	if (count == 0) {
+		return duration_t::zero();
+	}
+
+	const auto rank = std::max<std::uint64_t>(
+	    static_cast<std::uint64_t>(std::ceil(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(count))), 1);
+	std::uint64_t seen = 0;
+
+	for (std::size_t i = 0; i < BUCKETS; ++i) {
+		seen += counts[i];
+
+		if (seen >= rank) {
+			return std::chrono::duration_cast<duration_t>(std::chrono::nanoseconds{bucket_limit(i) - 1});
+		}
+	}
+
+	return std::chrono::duration_cast<duration_t>(std::chrono::nanoseconds{bucket_limit(BUCKETS - 1) - 1});
+}
+
+auto Histogram::mean() const -> duration_t {
+	if (count == 0) {
+		return duration_t::zero();
+	}
+
+	return std::chrono::duration_cast<duration_t>(std::chrono::nanoseconds{sum / count});
+}
+
+std::uint64_t Histogram::count_below(duration_t limit) const {
+	const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(limit).count();
+	std::uint64_t below = 0;
+
+	for (std::size_t i = 0; (i < BUCKETS) && (static_cast<std::int64_t>(bucket_limit(i)) <= nanoseconds); ++i) {
+		below += counts[i];
+	}
+
+	return below;
+}
+
+auto Histogram::count_up_to(duration_t limit) const -> CumulativeCount {
+	const auto nanoseconds = static_cast<std::uint64_t>(
+	    std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(limit).count(), std::int64_t{0}));
+	const std::size_t last = bucket_index(nanoseconds);
+	std::uint64_t up_to = 0;
+
+	for (std::size_t i = 0; i <= last; ++i) {
+		up_to += counts[i];
+	}
+
+	// Values are whole nanoseconds, so everything up to the bucket is at most one below its limit
+	return {.limit = std::chrono::duration_cast<duration_t>(std::chrono::nanoseconds{bucket_limit(last) - 1}),
+	        .count = up_to};
+}
+
+}  // namespace libmcstatus
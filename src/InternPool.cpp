@@ -0,0 +1,138 @@
+#include "libmcstatus/InternPool.hpp"
+
+#include <utility>
+
+#include "libmcstatus/impl/JsonScanner.hpp"
+#include "libmcstatus/impl/Utils.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+InternPool::string_t intern_optional(const std::optional<std::string>& value, InternPool& pool) {
+	return value ? pool.intern(*value) : nullptr;
+}
+
+InternPool::string_t intern_optional(const std::optional<std::string_view>& value, InternPool& pool) {
+	return value ? pool.intern(*value) : nullptr;
+}
+
+// Descriptions that are plain strings become their text, just like JavaServerResponse::motd. Chat components stay
+// the JSON they are
+InternPool::string_t intern_description(std::string_view description, InternPool& pool) {
+	if (!description.starts_with('"')) {
+		return pool.intern(description);
+	}
+
+	// Unescaping happens in place, so it needs a copy. Escapes only ever make strings shorter
+	std::string text{description};
+	JsonScanner scanner{text.data(), text.data() + text.size()};
+	const std::optional<std::string_view> unescaped = scanner.read_string();
+
+	return pool.intern(unescaped.value_or(description));
+}
+
+}  // namespace _impl
+
+std::size_t InternPool::Hash::operator()(std::string_view value) const {
+	return static_cast<std::size_t>(_impl::hash_bytes(value));
+}
+
+auto InternPool::intern(std::string_view value) -> string_t {
+	return strings.with_shard(Hash{}(value), [&](set_t& shard) {
+		if (const auto existing = shard.find(value); existing != shard.end()) {
+			return *existing;
+		}
+
+		return *shard.insert(std::make_shared<const std::string>(value)).first;
+	});
+}
+
+std::size_t InternPool::prune() {
+	std::size_t pruned = 0;
+	strings.for_each_shard([&](set_t& shard) {
+		pruned += std::erase_if(shard, [](const string_t& value) { return value.use_count() == 1; });
+	});
+
+	return pruned;
+}
+
+std::size_t InternPool::size() const {
+	return strings.size();
+}
+
+std::size_t InternPool::memory_usage() const {
+	std::size_t bytes = 0;
+	strings.for_each_shard([&](const set_t& shard) {
+		for (const string_t& value : shard) {
+			bytes += sizeof(std::string) + value->capacity();
+		}
+	});
+
+	return bytes;
+}
+
+InternedStatus InternedStatus::from(const JavaServer::JavaServerResponse& status, InternPool& pool) {
+	InternedStatus interned{
+	    .latency = status.latency,
+	    .version_name = pool.intern(status.version->name),
+	    .protocol = status.version->protocol,
+	    .online = status.players->online,
+	    .max = status.players->max,
+	    .motd = pool.intern(status.motd),
+	    .enforces_secure_chat = status.enforces_secure_chat,
+	    .icon = _impl::intern_optional(status.icon, pool),
+	    .forge_data = _impl::intern_optional(status.forge_data, pool),
+	};
+
+	if (status.players->sample) {
+		std::vector<Player>& sample = interned.sample.emplace();
+		sample.reserve(status.players->sample->size());
+
+		for (const auto& player : *status.players->sample) {
+			sample.push_back({pool.intern(player.name), player.id});
+		}
+	}
+
+	return interned;
+}
+
+InternedStatus InternedStatus::from(const JavaStatusView& status, InternPool& pool) {
+	InternedStatus interned{
+	    .latency = status.latency,
+	    .version_name = pool.intern(status.version_name),
+	    .protocol = status.protocol,
+	    .online = status.online,
+	    .max = status.max,
+	    .motd = _impl::intern_description(status.description.value_or(""), pool),
+	    .enforces_secure_chat = status.enforces_secure_chat,
+	    .icon = _impl::intern_optional(status.icon, pool),
+	    .forge_data = _impl::intern_optional(status.forge_data, pool),
+	};
+
+	if (status.sample) {
+		std::vector<Player>& sample = interned.sample.emplace();
+		sample.reserve(status.sample->size());
+
+		for (const JavaStatusView::Player& player : *status.sample) {
+			sample.push_back({pool.intern(player.name), player.id});
+		}
+	}
+
+	return interned;
+}
+
+auto InternedStatus::try_parse(JavaServer::RawStatus raw_status, InternPool& pool)
+    -> std::expected<InternedStatus, McError> {
+	std::expected<JavaStatusView, McError> status =
+	    JavaStatusView::try_parse(std::move(raw_status.buffer), raw_status.offset, raw_status.size);
+
+	if (!status) {
+		return std::unexpected{status.error()};
+	}
+
+	status->latency = raw_status.latency;
+	return from(*status, pool);
+}
+
+}  // namespace libmcstatus
@@ -1,149 +1,749 @@
 #include "libmcstatus/JavaServer.hpp"
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <boost/json.hpp>
-#include <boost/uuid/string_generator.hpp>
+#include <boost/system/system_error.hpp>
+#include <algorithm>
+#include <exception>
 #include <iostream>
 #include <limits>
+#include <optional>
 #include <random>
+#include <string>
+#include <vector>
 
 #include "libmcstatus/impl/SrvResolver.hpp"
+#include "libmcstatus/impl/Tracing.hpp"
 #include "libmcstatus/impl/Utils.hpp"
+#include "libmcstatus/McError.hpp"
 #include "libmcstatus/McPacket.hpp"
+#include "libmcstatus/Metrics.hpp"
 
 namespace libmcstatus {
 
-JavaServer::JavaServer(boost::asio::ip::tcp::endpoint server_address) : server_address{std::move(server_address)} {}
+namespace _impl {
+
+namespace asio = boost::asio;
+
+template <typename T>
+using result_t = McServer::result_t<T>;
+
+// A single attempt on its own connection. Closing the connection makes all pending operations on it fail right away,
+// which is how attempts get cut short when they time out or lose a hedging race
+struct Attempt {
+	Attempt(const Transport& transport, const asio::any_io_executor& executor)
+	    : connection{transport.connection(executor)}, deadline{executor} {}
+
+	std::unique_ptr<Transport::Connection> connection;
+	asio::steady_timer deadline;
+	bool timed_out{false};
+	bool cancelled{false};
+	McServer::McTimings timings{};
+
+	void cancel() {
+		cancelled = true;
+		connection->close();
+	}
+};
+
+// Owns its copy of the exchange, as attempts that lost a hedging race may still be running after the query returned
+template <typename T, typename Exchange>
+asio::awaitable<result_t<T>> run_attempt(std::shared_ptr<Attempt> attempt, [[maybe_unused]] asio::ip::port_type port,
+                                         std::chrono::milliseconds timeout, Exchange exchange) {
+	attempt->deadline.expires_after(timeout);
+	attempt->deadline.async_wait([attempt](const boost::system::error_code& error_code) {
+		if (!error_code) {
+			attempt->timed_out = true;
+			attempt->cancel();
+		}
+	});
+
+	// Don't keep the io_context busy with the deadline once the attempt is over, no matter how it ended
+	struct DeadlineGuard {
+		Attempt& attempt;
+		~DeadlineGuard() {
+			attempt.deadline.cancel();
+		}
+	} deadline_guard{*attempt};
+
+	Metrics::increment(Metrics::Counter::attempts);
+	LIBMCSTATUS_TRACE(connect__start, attempt.get(), port);
+
+	const std::chrono::steady_clock::time_point connect_start = std::chrono::steady_clock::now();
+	const result_t<void> connected = co_await attempt->connection->async_connect();
+	attempt->timings.connect = std::chrono::steady_clock::now() - connect_start;
+
+	LIBMCSTATUS_TRACE(connect__done, attempt.get(), connected ? 0 : static_cast<int>(connected.error()));
+
+	// Whatever failed after the deadline closed the connection failed because of the timeout
+	if (!connected) {
+		co_return std::unexpected{attempt->timed_out ? McError::timeout : connected.error()};
+	}
+	// Connected just as the attempt was cut short, in which case nobody waits for its result anymore
+	if (attempt->cancelled) {
+		co_return std::unexpected{attempt->timed_out ? McError::timeout : McError::connection_reset};
+	}
+
+	result_t<T> result = co_await exchange(*attempt->connection, attempt->timings);
+
+	if (!result && attempt->timed_out) {
+		co_return std::unexpected{McError::timeout};
+	}
+
+	if (result) {
+		Metrics::record(Metrics::Timer::attempt, std::chrono::steady_clock::now() - connect_start);
+	}
+
+	co_return result;
+}
+
+// Where attempts report their round trip times to, if the timeouts are adaptive
+struct RttSink {
+	std::shared_ptr<RttTable> rtts{};
+	std::string endpoint{};
+};
+
+// Runs one attempt, plus a hedged one if the policy asks for it and the first one takes too long. The first successful
+// attempt wins and cancels the other one. Only if all attempts fail, the first error is returned
+template <typename T, typename Exchange>
+asio::awaitable<result_t<T>> run_hedged(std::shared_ptr<const Transport> transport, std::chrono::milliseconds timeout,
+                                        std::optional<HedgePolicy> hedge, std::shared_ptr<const RttSink> rtt_sink,
+                                        const Exchange& exchange) {
+	const auto executor = co_await asio::this_coro::executor;
+
+	struct Race {
+		explicit Race(const asio::any_io_executor& executor)
+		    : done{executor, asio::steady_timer::time_point::max()}, hedge_timer{executor} {}
+
+		asio::steady_timer done;
+		asio::steady_timer hedge_timer;
+		std::vector<std::shared_ptr<Attempt>> attempts{};
+		result_t<T> result{std::unexpected{McError::unknown}};
+		std::size_t running{0};
+		bool failed{false};
+		bool finished{false};
+
+		void finish() {
+			finished = true;
+			hedge_timer.cancel();
+			for (const std::shared_ptr<Attempt>& attempt : attempts) {
+				attempt->cancel();
+			}
+			done.cancel();
+		}
+	};
+
+	const auto race = std::make_shared<Race>(executor);
+	const std::shared_ptr<LatencyWindow> latencies = hedge ? hedge->latencies : nullptr;
+
+	const auto launch = [&] {
+		const auto attempt = std::make_shared<Attempt>(*transport, executor);
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+		race->attempts.push_back(attempt);
+		++race->running;
+
+		asio::co_spawn(executor, run_attempt<T>(attempt, transport->port(), timeout, exchange),
+		               [race, latencies, rtt_sink, start](std::exception_ptr exception, result_t<T> result) {
+			               --race->running;
+
+			               if (race->finished) {
+				               return;
+			               }
+
+			               if (!exception && result) {
+				               if (latencies) {
+					               latencies->record(std::chrono::steady_clock::now() - start);
+				               }
+				               if (rtt_sink) {
+					               rtt_sink->rtts->sample(rtt_sink->endpoint, std::chrono::steady_clock::now() - start);
+				               }
+
+				               race->result = std::move(result);
+				               race->finish();
+				               return;
+			               }
+
+			               if (rtt_sink && !exception && (result.error() == McError::timeout)) {
+				               rtt_sink->rtts->timed_out(rtt_sink->endpoint);
+			               }
+
+			               if (!race->failed) {
+				               race->failed = true;
+				               race->result = exception ? std::unexpected{McError::unknown} : std::move(result);
+			               }
+
+			               // Give up once nothing is running anymore. A pending hedge isn't worth waiting for, as it
+			               // would just be an immediate retry
+			               if (race->running == 0) {
+				               race->finish();
+			               }
+		               });
+	};
+
+	launch();
+
+	if (hedge) {
+		race->hedge_timer.expires_after(hedge->delay());
+		race->hedge_timer.async_wait([race, &launch](const boost::system::error_code& error_code) {
+			// Only touch launch while the race is still going, as the coroutine frame is gone afterwards
+			if (!error_code && !race->finished) {
+				Metrics::increment(Metrics::Counter::hedges);
+				launch();
+			}
+		});
+	}
+
+	if (!race->finished) {
+		boost::system::error_code ignored;
+		co_await race->done.async_wait(asio::redirect_error(asio::use_awaitable, ignored));
+	}
+
+	co_return std::move(race->result);
+}
+
+template <typename T, typename Exchange>
+asio::awaitable<result_t<T>> run_with_retries(std::shared_ptr<const Transport> transport,
+                                              std::chrono::milliseconds timeout, RetryPolicy retry_policy,
+                                              Exchange exchange) {
+	asio::steady_timer backoff_timer{co_await asio::this_coro::executor};
+	// Only looked up with adaptive timeouts, which costs naming the endpoint
+	const std::shared_ptr<const RttSink> rtt_sink =
+	    retry_policy.adaptive_timeout
+	        ? std::make_shared<const RttSink>(
+	              RttSink{.rtts = retry_policy.adaptive_timeout->rtts, .endpoint = transport->to_string()})
+	        : nullptr;
+
+	for (std::size_t attempt = 1;; ++attempt) {
+		// Every attempt gets the timeout of what has been observed so far, including the attempts before it
+		const std::chrono::milliseconds attempt_timeout =
+		    rtt_sink ? rtt_sink->rtts->timeout(rtt_sink->endpoint, retry_policy.adaptive_timeout->min_timeout, timeout)
+		             : timeout;
+		result_t<T> result = co_await run_hedged<T>(transport, attempt_timeout, retry_policy.hedge, rtt_sink, exchange);
+
+		if (result || !retry_policy.should_retry(attempt, result.error())) {
+			co_return std::move(result);
+		}
+
+		boost::system::error_code ignored;
+		backoff_timer.expires_after(retry_policy.backoff(attempt));
+		co_await backoff_timer.async_wait(asio::redirect_error(asio::use_awaitable, ignored));
+
+		Metrics::increment(Metrics::Counter::retries);
+	}
+}
+
+// Runs a query on the executor of the calling coroutine, recording the query metrics
+template <typename T, typename Exchange>
+asio::awaitable<result_t<T>> run_query(std::shared_ptr<const Transport> transport, std::chrono::milliseconds timeout,
+                                       RetryPolicy retry_policy, Exchange exchange) {
+	Metrics::increment(Metrics::Counter::queries_started);
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	result_t<T> result =
+	    co_await run_with_retries<T>(std::move(transport), timeout, std::move(retry_policy), std::move(exchange));
+
+	Metrics::record(Metrics::Timer::query, std::chrono::steady_clock::now() - start);
+
+	if (result) {
+		Metrics::increment(Metrics::Counter::queries_succeeded);
+	} else {
+		Metrics::record_failure(result.error());
+	}
+
+	co_return result;
+}
+
+// Runs the io_context until it is out of work, then rethrows the exception a coroutine on it ended with, if any. Only
+// truly exceptional conditions (like running out of memory) end up there
+void run_rethrowing(asio::io_context& io_context, const std::exception_ptr& exception) {
+	io_context.run();
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+// Runs a query to completion on its own io_context, so concurrent calls never share anything
+template <typename T, typename Exchange>
+result_t<T> run_blocking(const std::shared_ptr<const Transport>& transport, std::chrono::milliseconds timeout,
+                         const RetryPolicy& retry_policy, Exchange exchange) {
+	asio::io_context io_context;
+	std::exception_ptr exception;
+	result_t<T> result{std::unexpected{McError::unknown}};
+
+	asio::co_spawn(io_context, run_query<T>(transport, timeout, retry_policy, std::move(exchange)),
+	               [&](std::exception_ptr spawn_exception, result_t<T> spawn_result) {
+		               exception = spawn_exception;
+		               result = std::move(spawn_result);
+	               });
+	run_rethrowing(io_context, exception);
+
+	return result;
+}
+
+const boost::json::object* if_object(const boost::json::value* value) {
+	return (value != nullptr) ? value->if_object() : nullptr;
+}
+
+const boost::json::array* if_array(const boost::json::value* value) {
+	return (value != nullptr) ? value->if_array() : nullptr;
+}
+
+const boost::json::string* if_string(const boost::json::value* value) {
+	return (value != nullptr) ? value->if_string() : nullptr;
+}
+
+const std::int64_t* if_int64(const boost::json::value* value) {
+	return (value != nullptr) ? value->if_int64() : nullptr;
+}
+
+const bool* if_bool(const boost::json::value* value) {
+	return (value != nullptr) ? value->if_bool() : nullptr;
+}
+
+}  // namespace _impl
+
+JavaServer::JavaServer(std::shared_ptr<const Transport> transport) : transport{std::move(transport)} {}
+
+JavaServer::JavaServer(boost::asio::ip::tcp::endpoint server_address)
+    : transport{std::make_shared<TcpTransport>(std::move(server_address))} {}
 
 JavaServer::JavaServer(const boost::asio::ip::address& ip_address, boost::asio::ip::port_type port)
-    : server_address{ip_address, port} {}
+    : JavaServer{boost::asio::ip::tcp::endpoint{ip_address, port}} {}
 
-void JavaServer::handshake(boost::asio::ip::tcp::socket& socket) const {
+auto JavaServer::handshake(Transport::Connection& connection) const -> boost::asio::awaitable<result_t<void>> {
 	McPacket packet;
 	packet.write_varint(0);
 	packet.write_varint(47);  // Protocol version (this is 1.8-1.8.9, since this is the last time the basic
 	                          // protocol was changed)
-	packet.write_utf(server_address.address().to_string());
-	packet.write_ushort(server_address.port());
+	packet.write_utf(transport->host());
+	packet.write_ushort(transport->port());
 	packet.write_varint(1);  // Intention to query status
 
-	packet.write_to_socket(socket);
+	const result_t<void> result = co_await packet.async_try_write(connection);
+	LIBMCSTATUS_TRACE(handshake__written, result ? 0 : static_cast<int>(result.error()));
+
+	co_return result;
 }
 
-auto JavaServer::ping([[maybe_unused]] std::chrono::milliseconds timeout) const -> latency_t {
-	static std::minstd_rand rng{std::random_device{}()};
-	static std::uniform_int_distribution<std::int64_t> dist{0, std::numeric_limits<std::int64_t>::max()};
+auto JavaServer::ping_exchange(Transport::Connection& connection) const
+    -> boost::asio::awaitable<result_t<latency_t>> {
+	// For the ping tokens
+	thread_local std::minstd_rand rng{std::random_device{}()};
+	std::uniform_int_distribution<std::int64_t> dist{0, std::numeric_limits<std::int64_t>::max()};
 
-	boost::asio::io_context io_context;
+	if (const result_t<void> sent = co_await handshake(connection); !sent) {
+		co_return std::unexpected{sent.error()};
+	}
 
-	for (std::size_t attempt = 1;; ++attempt) {
-		try {
-			boost::asio::ip::tcp::socket socket(io_context);
-			socket.connect(server_address);
-			handshake(socket);
+	using ping_token_t = std::int64_t;
+	const ping_token_t ping_token = dist(rng);
 
-			using ping_token_t = std::int64_t;
-			const ping_token_t ping_token = dist(rng);
+	McPacket packet;
+	packet.write_varint(1);  // Ping packet
+	packet.write_long(ping_token);
 
-			McPacket packet;
-			packet.write_varint(1);  // Ping packet
-			packet.write_long(ping_token);
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-			const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	if (const result_t<void> sent = co_await packet.async_try_write(connection); !sent) {
+		co_return std::unexpected{sent.error()};
+	}
+	result_t<McPacket> response = co_await McPacket::async_try_read(connection);
 
-			packet.write_to_socket(socket);
-			McPacket response = McPacket::read_from_socket(socket);
+	const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
 
-			const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	if (!response) {
+		co_return std::unexpected{response.error()};
+	}
 
-			if (response.read_varint() != 1) {
-				throw std::runtime_error("Invalid ping response packet");
-			}
+	if (const result_t<std::int32_t> packet_id = response->try_read_varint(); !packet_id || (*packet_id != 1)) {
+		co_return std::unexpected{packet_id ? McError::bad_response : packet_id.error()};
+	}
 
-			const ping_token_t response_token = response.read_long();
-			if (response_token != ping_token) {
-				throw std::runtime_error("Invalid ping response token (expected " + std::to_string(ping_token) +
-				                         ", got " + std::to_string(response_token) + ")");
-			}
+	const result_t<ping_token_t> response_token = response->try_read_long();
+	if (!response_token || (*response_token != ping_token)) {
+		co_return std::unexpected{response_token ? McError::bad_response : response_token.error()};
+	}
 
-			return end - start;
-		} catch (const std::exception&) {
-			if (attempt >= RETRIES) {
-				throw;
-			}
-		}
+	co_return end - start;
+}
+
+auto JavaServer::status_request(Transport::Connection& connection, McTimings& timings) const
+    -> boost::asio::awaitable<result_t<McPacket>> {
+	const std::chrono::steady_clock::time_point handshake_start = std::chrono::steady_clock::now();
+
+	if (const result_t<void> sent = co_await handshake(connection); !sent) {
+		co_return std::unexpected{sent.error()};
+	}
+
+	McPacket packet;
+	packet.write_varint(0);  // Request status
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	timings.handshake = start - handshake_start;
+
+	if (const result_t<void> sent = co_await packet.async_try_write(connection); !sent) {
+		co_return std::unexpected{sent.error()};
+	}
+
+	std::chrono::steady_clock::time_point first_byte;
+	result_t<McPacket> response = co_await McPacket::async_try_read(connection, &first_byte);
+
+	const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+	if (!response) {
+		co_return std::unexpected{response.error()};
 	}
+
+	if (const result_t<std::int32_t> packet_id = response->try_read_varint(); !packet_id || (*packet_id != 0)) {
+		co_return std::unexpected{packet_id ? McError::bad_response : packet_id.error()};
+	}
+
+	timings.resolve = resolve_time;
+	timings.first_byte = first_byte - start;
+	timings.response = end - start;
+
+	co_return response;
 }
 
-auto JavaServer::status_impl([[maybe_unused]] std::chrono::milliseconds timeout) const -> JavaServerResponse* {
-	boost::asio::io_context io_context;
+auto JavaServer::status_exchange(Transport::Connection& connection, McTimings& timings) const
+    -> boost::asio::awaitable<result_t<std::unique_ptr<JavaServerResponse>>> {
+	result_t<McPacket> response = co_await status_request(connection, timings);
+	if (!response) {
+		co_return std::unexpected{response.error()};
+	}
 
-	for (std::size_t attempt = 1;; ++attempt) {
-		try {
-			boost::asio::ip::tcp::socket socket(io_context);
-			socket.connect(server_address);
-			handshake(socket);
+	const std::chrono::steady_clock::time_point parse_start = std::chrono::steady_clock::now();
 
-			McPacket packet;
-			packet.write_varint(0);  // Request status
+	const result_t<std::string> status_response = response->try_read_utf();
+	if (!status_response) {
+		co_return std::unexpected{status_response.error()};
+	}
 
-			const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+	LIBMCSTATUS_TRACE(parse__start, status_response->size());
+	result_t<std::unique_ptr<JavaServerResponse>> status = try_parse_status(timings.response, *status_response);
+	LIBMCSTATUS_TRACE(parse__done, status ? 0 : static_cast<int>(status.error()));
 
-			packet.write_to_socket(socket);
-			McPacket response = McPacket::read_from_socket(socket);
+	if (status) {
+		timings.parse = std::chrono::steady_clock::now() - parse_start;
+		(*status)->timings = timings;
+	}
 
-			const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	co_return status;
+}
 
-			if (response.read_varint() != 0) {
-				throw std::runtime_error("Invalid status response packet");
-			}
+auto JavaServer::status_view_exchange(Transport::Connection& connection, McTimings& timings) const
+    -> boost::asio::awaitable<result_t<JavaStatusView>> {
+	result_t<RawStatus> raw_status = co_await status_raw_exchange(connection, timings);
+	if (!raw_status) {
+		co_return std::unexpected{raw_status.error()};
+	}
 
-			return parse_status(end - start, response.read_utf());
-		} catch (const std::exception&) {
-			if (attempt >= RETRIES) {
-				throw;
-			}
+	const std::chrono::steady_clock::time_point parse_start = std::chrono::steady_clock::now();
+
+	LIBMCSTATUS_TRACE(parse__start, raw_status->size);
+	result_t<JavaStatusView> status =
+	    JavaStatusView::try_parse(std::move(raw_status->buffer), raw_status->offset, raw_status->size);
+	LIBMCSTATUS_TRACE(parse__done, status ? 0 : static_cast<int>(status.error()));
+
+	if (status) {
+		timings.parse = std::chrono::steady_clock::now() - parse_start;
+		status->latency = timings.response;
+		status->timings = timings;
+	}
+
+	co_return status;
+}
+
+auto JavaServer::status_raw_exchange(Transport::Connection& connection, McTimings& timings) const
+    -> boost::asio::awaitable<result_t<RawStatus>> {
+	result_t<McPacket> response = co_await status_request(connection, timings);
+	if (!response) {
+		co_return std::unexpected{response.error()};
+	}
+
+	const result_t<std::string_view> status_response = response->try_read_utf_view();
+	if (!status_response) {
+		co_return std::unexpected{status_response.error()};
+	}
+
+	// Moving the buffer out of the packet keeps its data where it is, so the offset stays valid
+	RawStatus raw_status{.latency = timings.response, .timings = timings, .buffer = std::move(*response).release()};
+	raw_status.offset = static_cast<std::size_t>(reinterpret_cast<const std::uint8_t*>(status_response->data()) -
+	                                             raw_status.buffer.data());
+	raw_status.size = status_response->size();
+
+	co_return raw_status;
+}
+
+auto JavaServer::try_ping(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const
+    -> result_t<latency_t> {
+	LIBMCSTATUS_TRACE(query__start, "ping", transport->port());
+
+	result_t<latency_t> result = _impl::run_blocking<latency_t>(
+	    transport, timeout, retry_policy,
+	    [server = *this](Transport::Connection& connection, McTimings&) { return server.ping_exchange(connection); });
+
+	LIBMCSTATUS_TRACE(query__done, "ping", result ? 0 : static_cast<int>(result.error()));
+	return result;
+}
+
+auto JavaServer::try_status(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const
+    -> result_t<std::unique_ptr<JavaServerResponse>> {
+	LIBMCSTATUS_TRACE(query__start, "status", transport->port());
+
+	result_t<std::unique_ptr<JavaServerResponse>> result = _impl::run_blocking<std::unique_ptr<JavaServerResponse>>(
+	    transport, timeout, retry_policy,
+	    [server = *this](Transport::Connection& connection, McTimings& timings) {
+		    return server.status_exchange(connection, timings);
+	    });
+
+	LIBMCSTATUS_TRACE(query__done, "status", result ? 0 : static_cast<int>(result.error()));
+	return result;
+}
+
+auto JavaServer::try_status_view(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const
+    -> result_t<JavaStatusView> {
+	LIBMCSTATUS_TRACE(query__start, "status", transport->port());
+
+	result_t<JavaStatusView> result = _impl::run_blocking<JavaStatusView>(
+	    transport, timeout, retry_policy, [server = *this](Transport::Connection& connection, McTimings& timings) {
+		    return server.status_view_exchange(connection, timings);
+	    });
+
+	LIBMCSTATUS_TRACE(query__done, "status", result ? 0 : static_cast<int>(result.error()));
+	return result;
+}
+
+JavaStatusView JavaServer::status_view(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const {
+	result_t<JavaStatusView> result = try_status_view(timeout, retry_policy);
+
+	if (!result) {
+		throw_error(result.error());
+	}
+
+	return std::move(*result);
+}
+
+auto JavaServer::try_status_raw(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const
+    -> result_t<RawStatus> {
+	LIBMCSTATUS_TRACE(query__start, "status", transport->port());
+
+	result_t<RawStatus> result = _impl::run_blocking<RawStatus>(
+	    transport, timeout, retry_policy,
+	    [server = *this](Transport::Connection& connection, McTimings& timings) {
+		    return server.status_raw_exchange(connection, timings);
+	    });
+
+	LIBMCSTATUS_TRACE(query__done, "status", result ? 0 : static_cast<int>(result.error()));
+	return result;
+}
+
+auto JavaServer::status_raw(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const -> RawStatus {
+	result_t<RawStatus> result = try_status_raw(timeout, retry_policy);
+
+	if (!result) {
+		throw_error(result.error());
+	}
+
+	return std::move(*result);
+}
+
+auto JavaServer::async_try_status_raw(std::chrono::milliseconds timeout, RetryPolicy retry_policy) const
+    -> boost::asio::awaitable<result_t<RawStatus>> {
+	LIBMCSTATUS_TRACE(query__start, "status", transport->port());
+
+	result_t<RawStatus> result = co_await _impl::run_query<RawStatus>(
+	    transport, timeout, std::move(retry_policy),
+	    [server = *this](Transport::Connection& connection, McTimings& timings) {
+		    return server.status_raw_exchange(connection, timings);
+	    });
+
+	LIBMCSTATUS_TRACE(query__done, "status", result ? 0 : static_cast<int>(result.error()));
+	co_return result;
+}
+
+auto JavaServer::async_try_ping(std::chrono::milliseconds timeout, RetryPolicy retry_policy) const
+    -> boost::asio::awaitable<result_t<latency_t>> {
+	LIBMCSTATUS_TRACE(query__start, "ping", transport->port());
+
+	result_t<latency_t> result = co_await _impl::run_query<latency_t>(
+	    transport, timeout, std::move(retry_policy),
+	    [server = *this](Transport::Connection& connection, McTimings&) { return server.ping_exchange(connection); });
+
+	LIBMCSTATUS_TRACE(query__done, "ping", result ? 0 : static_cast<int>(result.error()));
+	co_return result;
+}
+
+auto JavaServer::try_status_raw_batch(std::span<const JavaServer> servers, std::chrono::milliseconds timeout,
+                                      const RetryPolicy& retry_policy, std::size_t concurrency)
+    -> std::vector<result_t<RawStatus>> {
+	std::vector<result_t<RawStatus>> results(servers.size(), std::unexpected{McError::unknown});
+	boost::asio::io_context io_context;
+	std::exception_ptr exception;
+	std::size_t next = 0;
+
+	// Every worker picks the next server as soon as its previous one is done, everything runs on this thread
+	const auto worker = [&]() -> boost::asio::awaitable<void> {
+		while (next < servers.size()) {
+			const std::size_t index = next++;
+			results[index] = co_await servers[index].async_try_status_raw(timeout, retry_policy);
 		}
+	};
+
+	for (std::size_t i = 0; i < std::min(std::max(concurrency, std::size_t{1}), servers.size()); ++i) {
+		boost::asio::co_spawn(io_context, worker(), [&](std::exception_ptr worker_exception) {
+			if (worker_exception && !exception) {
+				exception = worker_exception;
+			}
+		});
 	}
+	_impl::run_rethrowing(io_context, exception);
+
+	return results;
+}
+
+auto JavaServer::status_impl(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const
+    -> JavaServerResponse* {
+	result_t<std::unique_ptr<JavaServerResponse>> result = try_status(timeout, retry_policy);
+
+	if (!result) {
+		throw_error(result.error());
+	}
+
+	return result->release();
+}
+
+auto JavaServer::try_status_impl(std::chrono::milliseconds timeout, const RetryPolicy& retry_policy) const
+    -> result_t<McStatusResponse*> {
+	result_t<std::unique_ptr<JavaServerResponse>> result = try_status(timeout, retry_policy);
+
+	if (!result) {
+		return std::unexpected{result.error()};
+	}
+
+	return result->release();
 }
 
 JavaServer::JavaServerResponse* JavaServer::parse_status(latency_t latency, std::string_view status_response) {
-	boost::json::object parsed_status = boost::json::parse(status_response).as_object();
+	result_t<std::unique_ptr<JavaServerResponse>> status = try_parse_status(latency, status_response);
+
+	if (!status) {
+		throw boost::system::system_error{status.error(), "Failed to parse status response"};
+	}
+
+	return status->release();
+}
+
+auto JavaServer::parse_status(const RawStatus& raw_status) -> std::unique_ptr<JavaServerResponse> {
+	result_t<std::unique_ptr<JavaServerResponse>> status = try_parse_status(raw_status);
+
+	if (!status) {
+		throw boost::system::system_error{status.error(), "Failed to parse status response"};
+	}
+
+	return std::move(*status);
+}
+
+auto JavaServer::try_parse_status(const RawStatus& raw_status) -> result_t<std::unique_ptr<JavaServerResponse>> {
+	result_t<std::unique_ptr<JavaServerResponse>> status = try_parse_status(raw_status.latency, raw_status.json());
+
+	if (status) {
+		(*status)->timings = raw_status.timings;
+	}
+
+	return status;
+}
+
+auto JavaServer::try_parse_status(latency_t latency, std::string_view status_response)
+    -> result_t<std::unique_ptr<JavaServerResponse>> {
+	boost::system::error_code error_code;
+	const boost::json::value parsed = boost::json::parse(status_response, error_code);
+	const boost::json::object* parsed_status = parsed.if_object();
+
+	if (error_code || (parsed_status == nullptr)) {
+		return std::unexpected{McError::bad_json};
+	}
+
+	const boost::json::object* players = _impl::if_object(parsed_status->if_contains("players"));
+	const boost::json::object* version = _impl::if_object(parsed_status->if_contains("version"));
+
+	if ((players == nullptr) || (version == nullptr)) {
+		return std::unexpected{McError::bad_json};
+	}
 
-	boost::json::object& players = parsed_status["players"].as_object();
-	boost::json::object& version = parsed_status["version"].as_object();
+	const std::int64_t* online = _impl::if_int64(players->if_contains("online"));
+	const std::int64_t* max = _impl::if_int64(players->if_contains("max"));
+	const boost::json::string* version_name = _impl::if_string(version->if_contains("name"));
+	const std::int64_t* protocol = _impl::if_int64(version->if_contains("protocol"));
 
-	auto* status = new JavaServerResponse{};
+	if ((online == nullptr) || (max == nullptr) || (version_name == nullptr) || (protocol == nullptr)) {
+		return std::unexpected{McError::bad_json};
+	}
+
+	auto status = std::make_unique<JavaServerResponse>();
 	status->latency = latency;
-	status->players->online = players["online"].as_int64();
-	status->players->max = players["max"].as_int64();
-	if (players.contains("sample") && players["sample"].is_array()) {
-		boost::json::array& sample = players["sample"].as_array();
-		status->players->sample = std::vector<JavaServerResponse::JavaStatusPlayers::JavaStatusPlayer>(sample.size());
-
-		boost::uuids::string_generator uuid_gen;
-		for (auto& player : sample) {
-			status->players->sample->emplace_back(player.as_object()["name"].as_string().c_str(),
-			                                      uuid_gen(player.as_object()["id"].as_string().c_str()));
+	status->players->online = *online;
+	status->players->max = *max;
+	if (const boost::json::array* sample = _impl::if_array(players->if_contains("sample"))) {
+		auto& sample_players = status->players->sample.emplace();
+		sample_players.reserve(sample->size());
+
+		for (const boost::json::value& player : *sample) {
+			const boost::json::object* player_object = player.if_object();
+			if (player_object == nullptr) {
+				return std::unexpected{McError::bad_json};
+			}
+
+			const boost::json::string* name = _impl::if_string(player_object->if_contains("name"));
+			const boost::json::string* id = _impl::if_string(player_object->if_contains("id"));
+			const std::optional<boost::uuids::uuid> uuid = (id != nullptr) ? _impl::parse_uuid(*id) : std::nullopt;
+			if ((name == nullptr) || !uuid) {
+				return std::unexpected{McError::bad_json};
+			}
+
+			sample_players.emplace_back(std::string{*name}, *uuid);
 		}
 	}
-	status->version->name = version["name"].as_string();
-	status->version->protocol = version["protocol"].as_int64();
-	status->motd = parsed_status["description"].is_string() ? parsed_status["description"].as_string().c_str()
-	                                                        : boost::json::serialize(parsed_status["description"]);
-	if (parsed_status.contains("enforcesSecureChat") && parsed_status["enforcesSecureChat"].is_bool())
-		status->enforces_secure_chat = parsed_status["enforcesSecureChat"].as_bool();
-	if (parsed_status.contains("favicon") && parsed_status["favicon"].is_string())
-		status->icon = parsed_status["favicon"].as_string();
-	if (parsed_status.contains("forgeData") || parsed_status.contains("modinfo")) {
-		boost::json::value& forge_data =
-		    parsed_status.contains("forgeData") ? parsed_status["forgeData"] : parsed_status["modinfo"];
-		status->forge_data = boost::json::serialize(forge_data);
+	status->version->name = *version_name;
+	status->version->protocol = *protocol;
+	if (const boost::json::value* description = parsed_status->if_contains("description")) {
+		const boost::json::string* description_text = description->if_string();
+		status->motd =
+		    (description_text != nullptr) ? std::string{*description_text} : boost::json::serialize(*description);
 	}
+	if (const bool* enforces_secure_chat = _impl::if_bool(parsed_status->if_contains("enforcesSecureChat")))
+		status->enforces_secure_chat = *enforces_secure_chat;
+	if (const boost::json::string* favicon = _impl::if_string(parsed_status->if_contains("favicon")))
+		status->icon = *favicon;
+	if (const boost::json::value* forge_data = parsed_status->contains("forgeData")
+	                                               ? parsed_status->if_contains("forgeData")
+	                                               : parsed_status->if_contains("modinfo"))
+		status->forge_data = boost::json::serialize(*forge_data);
 
 	return status;
 }
 
 JavaServer JavaServer::lookup(std::string_view host_address) {
+	result_t<JavaServer> server = try_lookup(host_address);
+
+	if (!server) {
+		throw boost::system::system_error{server.error(),
+		                                  "Failed to resolve host \"" + std::string{host_address} + "\""};
+	}
+
+	return std::move(*server);
+}
+
+auto JavaServer::try_lookup(std::string_view host_address) -> result_t<JavaServer> {
+	Metrics::increment(Metrics::Counter::lookups);
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 	boost::system::error_code ec;
 	boost::asio::io_context io_context;
 	boost::asio::ip::tcp::resolver resolver(io_context);
@@ -160,38 +760,44 @@ JavaServer JavaServer::lookup(std::string_view host_address) {
 		return JavaServer{address, colon_found ? _impl::parse_port(port) : DEFAULT_PORT};
 	}
 
-	// Try SRV lookup if we have a plain hostname (without port)
+	// Try SRV lookup if we have a plain hostname (without port). If there are no SRV records, continue with normal DNS
+	// lookup
 	if (!colon_found) {
-		try {
-			_impl::SrvRecord record = _impl::pick_record(_impl::resolve_srv("minecraft", "tcp", host));
+		if (const result_t<_impl::records_t> records = _impl::try_resolve_srv("minecraft", "tcp", host);
+		    records && !records->empty()) {
+			const _impl::SrvRecord& record = _impl::pick_record(*records);
 			host = record.target;
 			port = std::to_string(record.port);
-		} catch (std::runtime_error& e) {
-			// No SRV records found, continue with normal DNS lookup
 		}
 	}
 
 	// Resolve the host
 	auto results = resolver.resolve(host, port, ec);
+	const latency_t resolve_time = std::chrono::steady_clock::now() - start;
 
-	if (ec.failed()) {
-		throw std::runtime_error("Failed to resolve host \"" + std::string{host_address} + "\": " + ec.message());
-	}
+	Metrics::record(Metrics::Timer::lookup, resolve_time);
 
-	// Prefer IPv4 addresses
-	for (const auto& endpoint : results) {
-		if (endpoint.endpoint().address().is_v4()) {
-			// Use this IPv4 address
-			return JavaServer{endpoint};
-		}
+	if (ec.failed() || results.empty()) {
+		Metrics::increment(Metrics::Counter::lookup_failures);
+		return std::unexpected{McError::resolve_failed};
 	}
 
-	// Fallback to IPv6 addresses
-	return JavaServer{results.begin()->endpoint()};
+	// Prefer IPv4 addresses and fall back to IPv6 addresses
+	const auto ipv4 = std::find_if(results.begin(), results.end(),
+	                               [](const auto& entry) { return entry.endpoint().address().is_v4(); });
+
+	JavaServer server{(ipv4 != results.end()) ? ipv4->endpoint() : results.begin()->endpoint()};
+	server.resolve_time = resolve_time;
+
+	return server;
+}
+
+const std::shared_ptr<const Transport>& JavaServer::get_transport() const {
+	return transport;
 }
 
 std::string JavaServer::to_string() const {
-	return server_address.address().to_string() + ":" + std::to_string(server_address.port());
+	return transport->to_string();
 }
 
 }  // namespace libmcstatus
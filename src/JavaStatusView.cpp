@@ -0,0 +1,164 @@
+#include "libmcstatus/JavaStatusView.hpp"
+
+#include <utility>
+
+#include "libmcstatus/impl/JsonScanner.hpp"
+#include "libmcstatus/impl/Utils.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+// Required fields are only known to be present once the whole object has been read
+struct RequiredFields {
+	bool players{false};
+	bool version{false};
+	bool version_name{false};
+	bool protocol{false};
+	bool online{false};
+	bool max{false};
+
+	[[nodiscard]] bool all() const {
+		return players && version && version_name && protocol && online && max;
+	}
+};
+
+// Reads a value that is only of use if it is an integer. Values of other types don't fail the scan, the missing field
+// fails the status later on
+bool read_int64(JsonScanner& scanner, McServer::response_int_t& value, bool& found) {
+	const std::optional<std::string_view> raw = scanner.skip_value();
+	const std::optional<std::int64_t> parsed = raw ? JsonScanner::to_int64(*raw) : std::nullopt;
+
+	value = parsed.value_or(-1);
+	found = parsed.has_value();
+	return raw.has_value();
+}
+
+bool parse_player(JsonScanner& scanner, std::vector<JavaStatusView::Player>& sample) {
+	std::optional<std::string_view> name;
+	std::optional<boost::uuids::uuid> id;
+
+	if (scanner.peek() != '{') {
+		return false;
+	}
+
+	const bool valid = scanner.object([&](std::string_view key) {
+		if ((key != "name") && (key != "id")) {
+			return scanner.skip_value().has_value();
+		}
+
+		const bool is_string = scanner.peek() == '"';
+		const std::optional<std::string_view> value = is_string ? scanner.read_string() : scanner.skip_value();
+		if (key == "name") {
+			name = is_string ? value : std::nullopt;
+		} else {
+			id = (is_string && value) ? parse_uuid(*value) : std::nullopt;
+		}
+
+		return value.has_value();
+	});
+
+	if (!valid || !name || !id) {
+		return false;
+	}
+
+	sample.push_back({*name, *id});
+	return true;
+}
+
+bool parse_players(JsonScanner& scanner, JavaStatusView& status, RequiredFields& required) {
+	return scanner.object([&](std::string_view key) {
+		if (key == "online") {
+			return read_int64(scanner, status.online, required.online);
+		}
+		if (key == "max") {
+			return read_int64(scanner, status.max, required.max);
+		}
+		if ((key == "sample") && (scanner.peek() == '[')) {
+			std::vector<JavaStatusView::Player>& sample = status.sample.emplace();
+			return scanner.array([&] { return parse_player(scanner, sample); });
+		}
+
+		return scanner.skip_value().has_value();
+	});
+}
+
+bool parse_version(JsonScanner& scanner, JavaStatusView& status, RequiredFields& required) {
+	return scanner.object([&](std::string_view key) {
+		if (key == "protocol") {
+			return read_int64(scanner, status.protocol, required.protocol);
+		}
+		if ((key == "name") && (scanner.peek() == '"')) {
+			const std::optional<std::string_view> name = scanner.read_string();
+			status.version_name = name.value_or(std::string_view{});
+			required.version_name = name.has_value();
+			return name.has_value();
+		}
+
+		required.version_name = required.version_name && (key != "name");
+		return scanner.skip_value().has_value();
+	});
+}
+
+}  // namespace _impl
+
+auto JavaStatusView::try_parse(McPacket::buffer_t buffer, std::size_t offset, std::size_t size)
+    -> std::expected<JavaStatusView, McError> {
+	JavaStatusView status;
+	status.buffer = std::move(buffer);
+
+	if ((offset > status.buffer.size()) || (size > (status.buffer.size() - offset))) {
+		return std::unexpected{McError::bad_json};
+	}
+
+	char* const begin = reinterpret_cast<char*>(status.buffer.data()) + offset;
+	_impl::JsonScanner scanner{begin, begin + size};
+	_impl::RequiredFields required;
+	bool has_forge_data = false;
+
+	const bool valid = scanner.object([&](std::string_view key) {
+		if ((key == "players") && (scanner.peek() == '{')) {
+			required.players = true;
+			return _impl::parse_players(scanner, status, required);
+		}
+		if ((key == "version") && (scanner.peek() == '{')) {
+			required.version = true;
+			return _impl::parse_version(scanner, status, required);
+		}
+		if ((key == "favicon") && (scanner.peek() == '"')) {
+			status.icon = scanner.read_string();
+			return status.icon.has_value();
+		}
+
+		// Everything else is kept as raw JSON
+		const std::optional<std::string_view> value = scanner.skip_value();
+		if (key == "description") {
+			status.description = value;
+		} else if (key == "enforcesSecureChat") {
+			status.enforces_secure_chat = value ? _impl::JsonScanner::to_bool(*value) : std::nullopt;
+		} else if (key == "forgeData") {
+			status.forge_data = value;
+			has_forge_data = true;
+		} else if ((key == "modinfo") && !has_forge_data) {
+			status.forge_data = value;  // forgeData takes precedence, no matter the order
+		}
+
+		return value.has_value();
+	});
+
+	if (!valid || !scanner.at_end() || !required.all()) {
+		return std::unexpected{McError::bad_json};
+	}
+
+	return status;
+}
+
+auto JavaStatusView::try_parse(std::string_view json) -> std::expected<JavaStatusView, McError> {
+	return try_parse(McPacket::buffer_t{json.begin(), json.end()}, 0, json.size());
+}
+
+std::size_t JavaStatusView::memory_usage() const {
+	return sizeof(JavaStatusView) + buffer.capacity() + (sample ? (sample->capacity() * sizeof(Player)) : 0);
+}
+
+}  // namespace libmcstatus
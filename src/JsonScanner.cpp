@@ -0,0 +1,320 @@
+#include "libmcstatus/impl/JsonScanner.hpp"
+
+#include <charconv>
+#include <cstring>
+
+namespace libmcstatus::_impl {
+
+namespace {
+
+bool is_digit(char c) {
+	return (c >= '0') && (c <= '9');
+}
+
+std::optional<std::uint32_t> parse_hex4(const char* digits) {
+	std::uint32_t value = 0;
+
+	for (int i = 0; i < 4; ++i) {
+		const char c = digits[i];
+		value <<= 4;
+
+		if (is_digit(c)) {
+			value |= static_cast<std::uint32_t>(c - '0');
+		} else if ((c >= 'a') && (c <= 'f')) {
+			value |= static_cast<std::uint32_t>(c - 'a' + 10);
+		} else if ((c >= 'A') && (c <= 'F')) {
+			value |= static_cast<std::uint32_t>(c - 'A' + 10);
+		} else {
+			return std::nullopt;
+		}
+	}
+
+	return value;
+}
+
+void write_utf8(char*& out, std::uint32_t code_point) {
+	if (code_point < 0x80) {
+		*out++ = static_cast<char>(code_point);
+	} else if (code_point < 0x800) {
+		*out++ = static_cast<char>(0xC0 | (code_point >> 6));
+		*out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+	} else if (code_point < 0x10000) {
+		*out++ = static_cast<char>(0xE0 | (code_point >> 12));
+		*out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+		*out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+	} else {
+		*out++ = static_cast<char>(0xF0 | (code_point >> 18));
+		*out++ = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+		*out++ = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+		*out++ = static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+}
+
+}  // namespace
+
+void JsonScanner::skip_whitespace() {
+	while ((position != end) &&
+	       ((*position == ' ') || (*position == '\n') || (*position == '\r') || (*position == '\t'))) {
+		++position;
+	}
+}
+
+char JsonScanner::peek() {
+	skip_whitespace();
+	return (position != end) ? *position : '\0';
+}
+
+bool JsonScanner::consume(char expected) {
+	if (peek() != expected) {
+		return false;
+	}
+
+	++position;
+	return true;
+}
+
+bool JsonScanner::at_end() {
+	skip_whitespace();
+	return position == end;
+}
+
+// Called with position right after "\u". The escaped text is always longer than its UTF-8 encoding, so unescaping in
+// place never overtakes the input
+bool JsonScanner::skip_unicode_escape(char*& out) {
+	if ((end - position) < 4) {
+		return false;
+	}
+
+	std::optional<std::uint32_t> code_point = parse_hex4(position);
+	position += 4;
+
+	if (!code_point || ((*code_point >= 0xDC00) && (*code_point <= 0xDFFF))) {
+		return false;  // Lone low surrogate
+	}
+
+	if ((*code_point >= 0xD800) && (*code_point <= 0xDBFF)) {
+		if (((end - position) < 6) || (position[0] != '\\') || (position[1] != 'u')) {
+			return false;  // Lone high surrogate
+		}
+
+		const std::optional<std::uint32_t> low = parse_hex4(position + 2);
+		if (!low || (*low < 0xDC00) || (*low > 0xDFFF)) {
+			return false;
+		}
+
+		position += 6;
+		code_point = 0x10000 + ((*code_point - 0xD800) << 10) + (*low - 0xDC00);
+	}
+
+	if (unescape) {
+		write_utf8(out, *code_point);
+	}
+
+	return true;
+}
+
+std::optional<std::string_view> JsonScanner::read_string() {
+	if (!consume('"')) {
+		return std::nullopt;
+	}
+
+	char* const start = position;
+	char* out = position;
+
+	while (position != end) {
+		const char c = *position;
+
+		if (c == '"') {
+			++position;
+			return std::string_view{start, unescape ? out : (position - 1)};
+		}
+
+		if (static_cast<unsigned char>(c) < 0x20) {
+			return std::nullopt;  // Control characters have to be escaped
+		}
+
+		++position;
+
+		if (c != '\\') {
+			if (unescape) {
+				*out++ = c;
+			}
+			continue;
+		}
+
+		if (position == end) {
+			return std::nullopt;
+		}
+
+		char decoded;
+		switch (*position++) {
+		case '"':
+			decoded = '"';
+			break;
+		case '\\':
+			decoded = '\\';
+			break;
+		case '/':
+			decoded = '/';
+			break;
+		case 'b':
+			decoded = '\b';
+			break;
+		case 'f':
+			decoded = '\f';
+			break;
+		case 'n':
+			decoded = '\n';
+			break;
+		case 'r':
+			decoded = '\r';
+			break;
+		case 't':
+			decoded = '\t';
+			break;
+		case 'u':
+			if (!skip_unicode_escape(out)) {
+				return std::nullopt;
+			}
+			continue;
+		default:
+			return std::nullopt;
+		}
+
+		if (unescape) {
+			*out++ = decoded;
+		}
+	}
+
+	return std::nullopt;
+}
+
+bool JsonScanner::skip_literal(std::string_view literal) {
+	if ((static_cast<std::size_t>(end - position) < literal.size()) ||
+	    (std::memcmp(position, literal.data(), literal.size()) != 0)) {
+		return false;
+	}
+
+	position += literal.size();
+	return true;
+}
+
+bool JsonScanner::skip_number(bool& integer) {
+	const auto skip_digits = [this] {
+		const char* const start = position;
+		while ((position != end) && is_digit(*position)) {
+			++position;
+		}
+		return position != start;
+	};
+
+	integer = true;
+
+	if ((position != end) && (*position == '-')) {
+		++position;
+	}
+
+	// No leading zeros
+	if ((position != end) && (*position == '0')) {
+		++position;
+	} else if (!skip_digits()) {
+		return false;
+	}
+
+	if ((position != end) && (*position == '.')) {
+		integer = false;
+		++position;
+
+		if (!skip_digits()) {
+			return false;
+		}
+	}
+
+	if ((position != end) && ((*position == 'e') || (*position == 'E'))) {
+		integer = false;
+		++position;
+
+		if ((position != end) && ((*position == '+') || (*position == '-'))) {
+			++position;
+		}
+		if (!skip_digits()) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::optional<std::string_view> JsonScanner::skip_value() {
+	const char next = peek();
+	const char* const start = position;
+	bool valid;
+
+	// Raw values must stay as they are, including their keys and strings
+	const bool outer_unescape = unescape;
+	unescape = false;
+
+	switch (next) {
+	case '{':
+		valid = object([this](std::string_view) { return skip_value().has_value(); });
+		break;
+	case '[':
+		valid = array([this] { return skip_value().has_value(); });
+		break;
+	case '"':
+		valid = read_string().has_value();
+		break;
+	case 't':
+		valid = skip_literal("true");
+		break;
+	case 'f':
+		valid = skip_literal("false");
+		break;
+	case 'n':
+		valid = skip_literal("null");
+		break;
+	default: {
+		bool integer;
+		valid = skip_number(integer);
+		break;
+	}
+	}
+
+	unescape = outer_unescape;
+
+	if (!valid) {
+		return std::nullopt;
+	}
+
+	return std::string_view{start, position};
+}
+
+std::optional<std::int64_t> JsonScanner::to_int64(std::string_view raw) {
+	// Integers are the only values made of nothing but a sign and digits, without leading zeros
+	const std::string_view digits = raw.starts_with('-') ? raw.substr(1) : raw;
+	if (digits.empty() || (digits.find_first_not_of("0123456789") != std::string_view::npos) ||
+	    ((digits.size() > 1) && (digits.front() == '0'))) {
+		return std::nullopt;
+	}
+
+	std::int64_t value;
+	const std::from_chars_result result = std::from_chars(raw.data(), raw.data() + raw.size(), value);
+	if ((result.ec != std::errc{}) || (result.ptr != (raw.data() + raw.size()))) {
+		return std::nullopt;  // Out of range
+	}
+
+	return value;
+}
+
+std::optional<bool> JsonScanner::to_bool(std::string_view raw) {
+	if (raw == "true") {
+		return true;
+	}
+	if (raw == "false") {
+		return false;
+	}
+
+	return std::nullopt;
+}
+
+}  // namespace libmcstatus::_impl
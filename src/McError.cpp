@@ -0,0 +1,92 @@
+#include "libmcstatus/McError.hpp"
+
+#include <boost/asio/error.hpp>
+#include <string>
+
+namespace libmcstatus {
+
+namespace _impl {
+
+class McErrorCategory : public boost::system::error_category {
+public:
+	[[nodiscard]] const char* name() const noexcept override {
+		return "libmcstatus";
+	}
+
+	[[nodiscard]] std::string message(int value) const override {
+		return std::string{to_string(static_cast<McError>(value))};
+	}
+};
+
+}  // namespace _impl
+
+std::string_view to_string(McError error) {
+	switch (error) {
+	case McError::timeout:
+		return "timeout";
+	case McError::connection_refused:
+		return "connection_refused";
+	case McError::connection_reset:
+		return "connection_reset";
+	case McError::host_unreachable:
+		return "host_unreachable";
+	case McError::network_error:
+		return "network_error";
+	case McError::resolve_failed:
+		return "resolve_failed";
+	case McError::bad_frame:
+		return "bad_frame";
+	case McError::bad_response:
+		return "bad_response";
+	case McError::bad_json:
+		return "bad_json";
+	case McError::unknown:
+		break;
+	}
+
+	return "unknown";
+}
+
+const boost::system::error_category& mc_error_category() noexcept {
+	static const _impl::McErrorCategory category;
+	return category;
+}
+
+boost::system::error_code make_error_code(McError error) noexcept {
+	return {static_cast<int>(error), mc_error_category()};
+}
+
+McError classify_error(const boost::system::error_code& error_code) noexcept {
+	namespace error = boost::asio::error;
+
+	if (error_code.category() == mc_error_category()) {
+		return static_cast<McError>(error_code.value());
+	}
+
+	if (error_code == error::timed_out) {
+		return McError::timeout;
+	}
+	if (error_code == error::connection_refused) {
+		return McError::connection_refused;
+	}
+	if ((error_code == error::connection_reset) || (error_code == error::connection_aborted) ||
+	    (error_code == error::broken_pipe) || (error_code == error::eof)) {
+		return McError::connection_reset;
+	}
+	if ((error_code == error::host_unreachable) || (error_code == error::network_unreachable) ||
+	    (error_code == error::network_down)) {
+		return McError::host_unreachable;
+	}
+	if ((error_code == error::host_not_found) || (error_code == error::host_not_found_try_again) ||
+	    (error_code == error::no_data)) {
+		return McError::resolve_failed;
+	}
+	if ((error_code.category() == boost::system::system_category()) ||
+	    (error_code.category() == boost::system::generic_category())) {
+		return McError::network_error;
+	}
+
+	return McError::unknown;
+}
+
+}  // namespace libmcstatus
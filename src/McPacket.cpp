@@ -5,6 +5,11 @@
 #include <boost/asio/read.hpp>
 #include <concepts>
 #include <iostream>
+#include <optional>
+#include <span>
+
+#include "libmcstatus/impl/Tracing.hpp"
+#include "libmcstatus/Metrics.hpp"
 
 namespace libmcstatus {
 
@@ -27,12 +32,18 @@ void write_int_be(McPacket::buffer_t& buffer, T value) {
 }
 
 template <std::integral T>
-T read_int_be(const McPacket::buffer_iterator_t& head, McPacket::head_offset_t& head_offset) {
+std::optional<T> read_int_be(const McPacket::buffer_t& buffer, McPacket::head_offset_t& head_offset) {
 	constexpr std::size_t bytes = sizeof(T);
+
+	if ((head_offset + static_cast<McPacket::head_offset_t>(bytes)) >
+	    static_cast<McPacket::head_offset_t>(buffer.size())) {
+		return std::nullopt;
+	}
+
 	T value;
 	auto* ptr = reinterpret_cast<std::uint8_t*>(&value);
 
-	std::copy_n(head, bytes, ptr);
+	std::copy_n(buffer.begin() + head_offset, bytes, ptr);
 	head_offset += bytes;
 
 	// Clang-tidy doesn't understand that this is essentially a compile-time check
@@ -46,6 +57,56 @@ T read_int_be(const McPacket::buffer_iterator_t& head, McPacket::head_offset_t&
 	return value;
 }
 
+// Shared by the throwing and non-throwing read functions, so both decode the exact same way
+enum class VarIntStatus : std::uint8_t { ok, end_of_buffer, too_big };
+
+template <std::unsigned_integral T, int max_bytes>
+VarIntStatus read_var_int(std::span<const std::uint8_t> buffer, McPacket::head_offset_t& head_offset, T& result) {
+	result = 0;
+
+	for (int i = 0; i < max_bytes; ++i) {
+		if (head_offset >= static_cast<McPacket::head_offset_t>(buffer.size())) {
+			return VarIntStatus::end_of_buffer;
+		}
+
+		const std::uint8_t part = buffer[head_offset++];
+		result |= static_cast<T>(part & 0x7F) << (7 * i);
+
+		if ((part & 0x80) == 0) {
+			return VarIntStatus::ok;
+		}
+	}
+
+	return VarIntStatus::too_big;
+}
+
+enum class FrameStatus : std::uint8_t { complete, incomplete, invalid };
+
+// Locates the first packet in the buffer. On success, payload_offset and length describe the packet's data
+FrameStatus find_frame(std::span<const std::uint8_t> buffer, McPacket::head_offset_t& payload_offset,
+                       std::int32_t& length) {
+	std::uint32_t raw_length;
+	payload_offset = 0;
+
+	switch (read_var_int<std::uint32_t, 5>(buffer, payload_offset, raw_length)) {
+	case VarIntStatus::ok:
+		break;
+	case VarIntStatus::end_of_buffer:
+		return FrameStatus::incomplete;
+	case VarIntStatus::too_big:
+		return FrameStatus::invalid;
+	}
+
+	length = static_cast<std::int32_t>(raw_length);
+
+	if ((length < 0) || (length > McPacket::MAX_PACKET_SIZE)) {
+		return FrameStatus::invalid;
+	}
+
+	return ((payload_offset + length) > static_cast<McPacket::head_offset_t>(buffer.size())) ? FrameStatus::incomplete
+	                                                                                          : FrameStatus::complete;
+}
+
 }  // namespace _impl
 
 McPacket::McPacket(const std::vector<std::uint8_t>& buffer) : buffer{buffer}, head_offset{0} {}
@@ -142,19 +203,45 @@ void McPacket::write_bool(bool value) {
 
 auto McPacket::write_to_buffer() -> buffer_t {
 	McPacket length_packet{};
+	// Make room for the longest possible length prefix right away, so this allocates only once
+	length_packet.buffer.reserve(5 + buffer.size());
 	length_packet.write_varint(static_cast<std::int32_t>(buffer.size()));
 
 	length_packet.buffer.insert(length_packet.buffer.end(), buffer.begin(), buffer.end());
 
-	return length_packet.buffer;
+	return std::move(length_packet.buffer);
+}
+
+auto McPacket::release() && -> buffer_t {
+	head_offset = 0;
+	return std::move(buffer);
 }
 
 void McPacket::write_to_socket(boost::asio::ip::tcp::socket& socket) {
-	socket.write_some(boost::asio::buffer(write_to_buffer()));
+	const std::size_t written = socket.write_some(boost::asio::buffer(write_to_buffer()));
+
+	Metrics::increment(Metrics::Counter::bytes_out, written);
+	LIBMCSTATUS_TRACE(packet__written, written, 0);
 }
 
 void McPacket::write_to_socket(boost::asio::ip::udp::socket& socket) {
-	socket.send(boost::asio::buffer(write_to_buffer()));
+	const std::size_t written = socket.send(boost::asio::buffer(write_to_buffer()));
+
+	Metrics::increment(Metrics::Counter::bytes_out, written);
+	LIBMCSTATUS_TRACE(packet__written, written, 0);
+}
+
+auto McPacket::async_try_write(Transport::Connection& connection)
+    -> boost::asio::awaitable<std::expected<void, McError>> {
+	const buffer_t data = write_to_buffer();
+	const std::expected<void, McError> result = co_await connection.async_write(boost::asio::buffer(data));
+
+	if (result) {
+		Metrics::increment(Metrics::Counter::bytes_out, data.size());
+	}
+	LIBMCSTATUS_TRACE(packet__written, result ? data.size() : 0, result ? 0 : static_cast<int>(result.error()));
+
+	co_return result;
 }
 
 bool McPacket::eof() const {
@@ -162,38 +249,30 @@ bool McPacket::eof() const {
 }
 
 std::int32_t McPacket::read_varint() {
-	std::uint32_t result = 0;
-
-	for (int i = 0; i < 5; ++i) {
-		if (eof()) {
-			throw PacketDecodingError{"Unexpected end of buffer while reading varint"};
-		}
-
-		std::uint8_t part = *advance_head();
-		result |= static_cast<std::uint32_t>(part & 0x7F) << (7 * i);
-
-		if ((part & 0x80) == 0) {
-			return static_cast<std::int32_t>(result);
-		}
+	std::uint32_t result;
+
+	switch (_impl::read_var_int<std::uint32_t, 5>(buffer, head_offset, result)) {
+	case _impl::VarIntStatus::ok:
+		return static_cast<std::int32_t>(result);
+	case _impl::VarIntStatus::end_of_buffer:
+		throw PacketDecodingError{"Unexpected end of buffer while reading varint"};
+	case _impl::VarIntStatus::too_big:
+		break;
 	}
 
 	throw PacketDecodingError{"Received varint is too big!"};
 }
 
 std::int64_t McPacket::read_varlong() {
-	std::uint64_t result = 0;
-
-	for (int i = 0; i < 10; ++i) {
-		if (eof()) {
-			throw PacketDecodingError{"Unexpected end of buffer while reading varlong"};
-		}
-
-		std::uint8_t part = *advance_head();
-		result |= static_cast<std::uint64_t>(part & 0x7F) << (7 * i);
-
-		if ((part & 0x80) == 0) {
-			return static_cast<std::int64_t>(result);
-		}
+	std::uint64_t result;
+
+	switch (_impl::read_var_int<std::uint64_t, 10>(buffer, head_offset, result)) {
+	case _impl::VarIntStatus::ok:
+		return static_cast<std::int64_t>(result);
+	case _impl::VarIntStatus::end_of_buffer:
+		throw PacketDecodingError{"Unexpected end of buffer while reading varlong"};
+	case _impl::VarIntStatus::too_big:
+		break;
 	}
 
 	throw PacketDecodingError{"Received varlong is too big!"};
@@ -202,7 +281,7 @@ std::int64_t McPacket::read_varlong() {
 std::string McPacket::read_utf() {
 	const std::int32_t length = read_varint();
 
-	if ((head_offset + length) > static_cast<head_offset_t>(buffer.size())) {
+	if ((length < 0) || ((head_offset + length) > static_cast<head_offset_t>(buffer.size()))) {
 		throw PacketDecodingError{"Received packet is shorter than expected while reading UTF string"};
 	}
 
@@ -221,43 +300,139 @@ std::string McPacket::read_ascii() {
 	return res;
 }
 
+template <std::integral T>
+T McPacket::read_int_be_or_throw() {
+	if (const std::optional<T> value = _impl::read_int_be<T>(buffer, head_offset)) {
+		return *value;
+	}
+
+	throw PacketDecodingError{"Unexpected end of buffer while reading integer"};
+}
+
 std::int16_t McPacket::read_short() {
-	return _impl::read_int_be<std::int16_t>(get_head(), head_offset);
+	return read_int_be_or_throw<std::int16_t>();
 }
 
 std::uint16_t McPacket::read_ushort() {
-	return _impl::read_int_be<std::uint16_t>(get_head(), head_offset);
+	return read_int_be_or_throw<std::uint16_t>();
 }
 
 std::int32_t McPacket::read_int() {
-	return _impl::read_int_be<std::int32_t>(get_head(), head_offset);
+	return read_int_be_or_throw<std::int32_t>();
 }
 
 std::uint32_t McPacket::read_uint() {
-	return _impl::read_int_be<std::uint32_t>(get_head(), head_offset);
+	return read_int_be_or_throw<std::uint32_t>();
 }
 
 std::int64_t McPacket::read_long() {
-	return _impl::read_int_be<std::int64_t>(get_head(), head_offset);
+	return read_int_be_or_throw<std::int64_t>();
 }
 
 std::uint64_t McPacket::read_ulong() {
-	return _impl::read_int_be<std::uint64_t>(get_head(), head_offset);
+	return read_int_be_or_throw<std::uint64_t>();
 }
 
 bool McPacket::read_bool() {
 	return *advance_head();
 }
 
+std::expected<std::int32_t, McError> McPacket::try_read_varint() {
+	std::uint32_t result;
+
+	if (_impl::read_var_int<std::uint32_t, 5>(buffer, head_offset, result) != _impl::VarIntStatus::ok) {
+		return std::unexpected{McError::bad_frame};
+	}
+
+	return static_cast<std::int32_t>(result);
+}
+
+std::expected<std::int64_t, McError> McPacket::try_read_varlong() {
+	std::uint64_t result;
+
+	if (_impl::read_var_int<std::uint64_t, 10>(buffer, head_offset, result) != _impl::VarIntStatus::ok) {
+		return std::unexpected{McError::bad_frame};
+	}
+
+	return static_cast<std::int64_t>(result);
+}
+
+std::expected<std::string, McError> McPacket::try_read_utf() {
+	const std::expected<std::int32_t, McError> length = try_read_varint();
+
+	if (!length || (*length < 0) || ((head_offset + *length) > static_cast<head_offset_t>(buffer.size()))) {
+		return std::unexpected{McError::bad_frame};
+	}
+
+	std::string res{get_head(), get_head() + *length};
+
+	head_offset += *length;
+	return res;
+}
+
+std::expected<std::string_view, McError> McPacket::try_read_utf_view() {
+	const std::expected<std::int32_t, McError> length = try_read_varint();
+
+	if (!length || (*length < 0) || ((head_offset + *length) > static_cast<head_offset_t>(buffer.size()))) {
+		return std::unexpected{McError::bad_frame};
+	}
+
+	const std::string_view res{reinterpret_cast<const char*>(buffer.data()) + head_offset,
+	                           static_cast<std::size_t>(*length)};
+
+	head_offset += *length;
+	return res;
+}
+
+std::expected<std::int64_t, McError> McPacket::try_read_long() {
+	if (const std::optional<std::int64_t> value = _impl::read_int_be<std::int64_t>(buffer, head_offset)) {
+		return *value;
+	}
+
+	return std::unexpected{McError::bad_frame};
+}
+
 McPacket McPacket::read_from_buffer(const buffer_t& buffer) {
-	McPacket length_packet{buffer};
-	std::int32_t length = length_packet.read_varint();
+	head_offset_t payload_offset;
+	std::int32_t length;
 
-	if ((length_packet.head_offset + length) > static_cast<head_offset_t>(buffer.size())) {
+	switch (_impl::find_frame(buffer, payload_offset, length)) {
+	case _impl::FrameStatus::complete:
+		return McPacket{buffer.begin() + payload_offset, buffer.begin() + payload_offset + length};
+	case _impl::FrameStatus::incomplete:
 		throw PacketDecodingError{"Received packet is shorter than expected"};
+	case _impl::FrameStatus::invalid:
+		break;
+	}
+
+	throw PacketDecodingError{"Received packet has an invalid length"};
+}
+
+std::expected<std::size_t, McError> McPacket::try_frame_size(std::span<const std::uint8_t> data) {
+	head_offset_t payload_offset;
+	std::int32_t length;
+
+	switch (_impl::find_frame(data, payload_offset, length)) {
+	case _impl::FrameStatus::complete:
+		return static_cast<std::size_t>(payload_offset + length);
+	case _impl::FrameStatus::incomplete:
+		return 0;
+	case _impl::FrameStatus::invalid:
+		break;
+	}
+
+	return std::unexpected{McError::bad_frame};
+}
+
+std::expected<McPacket, McError> McPacket::try_read_from_buffer(const buffer_t& buffer) {
+	head_offset_t payload_offset;
+	std::int32_t length;
+
+	if (_impl::find_frame(buffer, payload_offset, length) != _impl::FrameStatus::complete) {
+		return std::unexpected{McError::bad_frame};
 	}
 
-	return McPacket{length_packet.get_head(), length_packet.get_head() + length};
+	return McPacket{buffer.begin() + payload_offset, buffer.begin() + payload_offset + length};
 }
 
 // Thread-local static buffer for reading packets into. Using this allows us to avoid allocating a new buffer for each
@@ -268,16 +443,62 @@ McPacket McPacket::read_from_socket(boost::asio::ip::tcp::socket& socket) {
 	package_buffer.resize(0);
 
 	while (true) {
-		try {
-			boost::asio::read(socket, boost::asio::dynamic_buffer(package_buffer), boost::asio::transfer_at_least(1));
-
-			return read_from_buffer(package_buffer);
-		} catch (const PacketDecodingError& error) {
-			// Rethrow if the error is not due to an unexpected end of buffer and the packet being too short
-			if ((error.what() != std::string{"Unexpected end of buffer while reading varint"}) &&
-			    (error.what() != std::string{"Received packet is shorter than expected"}))
-				throw;
-			// Otherwise, continue reading
+		Metrics::increment(Metrics::Counter::bytes_in,
+		                   boost::asio::read(socket, boost::asio::dynamic_buffer(package_buffer),
+		                                     boost::asio::transfer_at_least(1)));
+
+		head_offset_t payload_offset;
+		std::int32_t length;
+
+		switch (_impl::find_frame(package_buffer, payload_offset, length)) {
+		case _impl::FrameStatus::complete:
+			LIBMCSTATUS_TRACE(packet__read, package_buffer.size(), 0);
+			return McPacket{package_buffer.begin() + payload_offset, package_buffer.begin() + payload_offset + length};
+		case _impl::FrameStatus::incomplete:
+			continue;  // Keep reading until the whole packet has been received
+		case _impl::FrameStatus::invalid:
+			throw PacketDecodingError{"Received packet has an invalid length"};
+		}
+	}
+}
+
+auto McPacket::async_try_read(Transport::Connection& connection, std::chrono::steady_clock::time_point* first_byte)
+    -> boost::asio::awaitable<std::expected<McPacket, McError>> {
+	// Most responses fit into the first read, larger ones grow the buffer geometrically
+	static constexpr std::size_t MIN_READ_SIZE{4096};
+	buffer_t buffer;
+	std::size_t filled = 0;
+
+	while (true) {
+		buffer.resize(filled + std::max(MIN_READ_SIZE, filled));
+		const std::expected<std::size_t, McError> read =
+		    co_await connection.async_read_some(boost::asio::buffer(buffer.data() + filled, buffer.size() - filled));
+
+		if (!read) {
+			LIBMCSTATUS_TRACE(packet__read, filled, static_cast<int>(read.error()));
+			co_return std::unexpected{read.error()};
+		}
+
+		Metrics::increment(Metrics::Counter::bytes_in, *read);
+		filled += *read;
+
+		if (first_byte != nullptr) {
+			*first_byte = std::chrono::steady_clock::now();
+			first_byte = nullptr;
+		}
+
+		head_offset_t payload_offset;
+		std::int32_t length;
+
+		buffer.resize(filled);
+		switch (_impl::find_frame(buffer, payload_offset, length)) {
+		case _impl::FrameStatus::complete:
+			LIBMCSTATUS_TRACE(packet__read, filled, 0);
+			co_return McPacket{buffer.begin() + payload_offset, buffer.begin() + payload_offset + length};
+		case _impl::FrameStatus::incomplete:
+			continue;
+		case _impl::FrameStatus::invalid:
+			co_return std::unexpected{McError::bad_frame};
 		}
 	}
 }
@@ -294,6 +515,8 @@ McPacket McPacket::read_from_socket(boost::asio::ip::udp::socket& socket) {
 	// Receive data from socket and resize buffer to actual size (doesn't change capacity)
 	std::size_t received = socket.receive(boost::asio::buffer(package_buffer));
 	package_buffer.resize(received);
+	Metrics::increment(Metrics::Counter::bytes_in, received);
+	LIBMCSTATUS_TRACE(packet__read, received, 0);
 
 	return read_from_buffer(package_buffer);
 }
@@ -1,8 +1,14 @@
 #include "libmcstatus/McServer.hpp"
 
+#include <boost/system/system_error.hpp>
+
 namespace libmcstatus {
 
-std::size_t McServer::RETRIES = 3;
+std::atomic_size_t McServer::RETRIES = 3;
+
+void McServer::throw_error(McError error) const {
+	throw boost::system::system_error{error, "Failed to query " + to_string()};
+}
 
 std::ostream& operator<<(std::ostream& os, const McServer& server) {
 	return os << server.to_string();
@@ -0,0 +1,220 @@
+#include "libmcstatus/Metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <numeric>
+#include <string_view>
+
+namespace libmcstatus {
+
+namespace _impl {
+
+using namespace std::chrono_literals;
+
+// Only the owning thread ever writes to a shard, so a relaxed load and store is enough and avoids the much more costly
+// locked read-modify-write. Readers may see a slightly outdated value, but never a torn one
+inline void add(std::atomic_uint64_t& value, std::uint64_t amount) {
+	value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+struct AtomicHistogram {
+	std::array<std::atomic_uint64_t, Histogram::BUCKETS> counts{};
+	std::atomic_uint64_t sum{0};
+
+	void record(std::chrono::steady_clock::duration value) {
+		const auto nanoseconds = static_cast<std::uint64_t>(
+		    std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(value).count(), std::int64_t{0}));
+
+		add(counts[Histogram::bucket_index(nanoseconds)], 1);
+		add(sum, nanoseconds);
+	}
+
+	void add_to(Histogram& histogram) const {
+		// The count is taken from the very buckets loaded here, so that it always matches their total, even while
+		// values are being recorded
+		for (std::size_t i = 0; i < Histogram::BUCKETS; ++i) {
+			const std::uint64_t bucket = counts[i].load(std::memory_order_relaxed);
+			histogram.counts[i] += bucket;
+			histogram.count += bucket;
+		}
+
+		histogram.sum += sum.load(std::memory_order_relaxed);
+	}
+};
+
+struct MetricsShard {
+	std::array<std::atomic_uint64_t, Metrics::COUNTERS> counters{};
+	std::array<std::atomic_uint64_t, Metrics::ERRORS> failures{};
+	std::array<AtomicHistogram, Metrics::TIMERS> timers{};
+
+	std::atomic_bool in_use{true};
+	MetricsShard* next{nullptr};
+};
+
+// Singly linked list of all shards ever created. Shards are only ever added, never removed
+std::atomic<MetricsShard*> shards{nullptr};
+
+MetricsShard& acquire_shard() {
+	// Take over the shard of an exited thread if there is one, so the number of shards stays bounded by the highest
+	// number of threads that were recording at the same time
+	for (MetricsShard* shard = shards.load(std::memory_order_acquire); shard != nullptr; shard = shard->next) {
+		bool in_use = false;
+		if (shard->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire)) {
+			return *shard;
+		}
+	}
+
+	auto* shard = new MetricsShard;
+	shard->next = shards.load(std::memory_order_relaxed);
+
+	// On failure, compare_exchange_weak updates shard->next to the current head, so just try again
+	while (!shards.compare_exchange_weak(shard->next, shard, std::memory_order_release, std::memory_order_relaxed)) {
+		continue;
+	}
+
+	return *shard;
+}
+
+MetricsShard& local_shard() {
+	struct ShardLease {
+		MetricsShard& shard{acquire_shard()};
+
+		~ShardLease() {
+			shard.in_use.store(false, std::memory_order_release);
+		}
+	};
+
+	thread_local ShardLease lease;
+	return lease.shard;
+}
+
+struct CounterInfo {
+	std::string_view name;
+	std::string_view help;
+};
+
+constexpr std::array<CounterInfo, Metrics::COUNTERS> COUNTER_INFO{{
+    {"queries_started_total", "Number of ping and status queries started."},
+    {"queries_succeeded_total", "Number of ping and status queries that succeeded."},
+    {"attempts_total", "Number of connection attempts, including retries and hedged attempts."},
+    {"retries_total", "Number of attempts that were retries of a failed attempt."},
+    {"hedges_total", "Number of hedged attempts started alongside a slow attempt."},
+    {"received_bytes_total", "Number of bytes received from servers."},
+    {"sent_bytes_total", "Number of bytes sent to servers."},
+    {"lookups_total", "Number of host lookups."},
+    {"lookup_failures_total", "Number of host lookups that failed."},
+    {"srv_queries_total", "Number of DNS SRV queries."},
+}};
+
+constexpr std::array<CounterInfo, Metrics::TIMERS> TIMER_INFO{{
+    {"query_duration_seconds", "Duration of whole ping and status queries, including retries."},
+    {"attempt_duration_seconds", "Duration of successful attempts."},
+    {"lookup_duration_seconds", "Duration of host lookups."},
+}};
+
+// Exported bucket limits. The internal buckets are much finer, but far too many to export. Each of these is rounded up
+// to the end of the internal bucket it falls into, which is what gets exported as le, so the counts are exact
+constexpr std::array<std::chrono::microseconds, 14> EXPORTED_BUCKETS{
+    1ms, 2500us, 5ms, 10ms, 25ms, 50ms, 100ms, 250ms, 500ms, 1s, 2500ms, 5s, 10s, 30s};
+
+void append_number(std::string& out, double value) {
+	char buffer[32];
+	const std::to_chars_result result = std::to_chars(std::begin(buffer), std::end(buffer), value);
+	out.append(buffer, result.ptr);
+}
+
+void append_header(std::string& out, std::string_view name, std::string_view help, std::string_view type) {
+	out.append("# HELP libmcstatus_").append(name).append(" ").append(help).append("\n");
+	out.append("# TYPE libmcstatus_").append(name).append(" ").append(type).append("\n");
+}
+
+}  // namespace _impl
+
+void Metrics::increment(Counter counter, std::uint64_t amount) {
+	_impl::add(_impl::local_shard().counters[static_cast<std::size_t>(counter)], amount);
+}
+
+void Metrics::record_failure(McError error) {
+	_impl::add(_impl::local_shard().failures[static_cast<std::size_t>(error)], 1);
+}
+
+void Metrics::record(Timer timer, std::chrono::steady_clock::duration value) {
+	_impl::local_shard().timers[static_cast<std::size_t>(timer)].record(value);
+}
+
+auto Metrics::snapshot() -> Snapshot {
+	Snapshot snapshot;
+
+	for (const _impl::MetricsShard* shard = _impl::shards.load(std::memory_order_acquire); shard != nullptr;
+	     shard = shard->next) {
+		for (std::size_t i = 0; i < COUNTERS; ++i) {
+			snapshot.counters[i] += shard->counters[i].load(std::memory_order_relaxed);
+		}
+		for (std::size_t i = 0; i < ERRORS; ++i) {
+			snapshot.failures[i] += shard->failures[i].load(std::memory_order_relaxed);
+		}
+		for (std::size_t i = 0; i < TIMERS; ++i) {
+			shard->timers[i].add_to(snapshot.timers[i]);
+		}
+	}
+
+	return snapshot;
+}
+
+std::uint64_t Metrics::Snapshot::counter(Counter counter) const {
+	return counters[static_cast<std::size_t>(counter)];
+}
+
+std::uint64_t Metrics::Snapshot::failed(McError error) const {
+	return failures[static_cast<std::size_t>(error)];
+}
+
+std::uint64_t Metrics::Snapshot::failed() const {
+	return std::accumulate(failures.begin(), failures.end(), std::uint64_t{0});
+}
+
+const Histogram& Metrics::Snapshot::timer(Timer timer) const {
+	return timers[static_cast<std::size_t>(timer)];
+}
+
+std::string Metrics::Snapshot::to_prometheus() const {
+	std::string out;
+
+	for (std::size_t i = 0; i < COUNTERS; ++i) {
+		_impl::append_header(out, _impl::COUNTER_INFO[i].name, _impl::COUNTER_INFO[i].help, "counter");
+		out.append("libmcstatus_").append(_impl::COUNTER_INFO[i].name).append(" ");
+		out.append(std::to_string(counters[i])).append("\n");
+	}
+
+	_impl::append_header(out, "queries_failed_total", "Number of ping and status queries that failed, by error.",
+	                     "counter");
+	for (std::size_t i = 1; i < ERRORS; ++i) {
+		out.append("libmcstatus_queries_failed_total{error=\"").append(to_string(static_cast<McError>(i)));
+		out.append("\"} ").append(std::to_string(failures[i])).append("\n");
+	}
+
+	for (std::size_t i = 0; i < TIMERS; ++i) {
+		const std::string_view name = _impl::TIMER_INFO[i].name;
+		_impl::append_header(out, name, _impl::TIMER_INFO[i].help, "histogram");
+
+		for (const std::chrono::microseconds limit : _impl::EXPORTED_BUCKETS) {
+			const Histogram::CumulativeCount bucket = timers[i].count_up_to(limit);
+
+			out.append("libmcstatus_").append(name).append("_bucket{le=\"");
+			_impl::append_number(out, std::chrono::duration<double>{bucket.limit}.count());
+			out.append("\"} ").append(std::to_string(bucket.count)).append("\n");
+		}
+
+		out.append("libmcstatus_").append(name).append("_bucket{le=\"+Inf\"} ");
+		out.append(std::to_string(timers[i].count)).append("\n");
+		out.append("libmcstatus_").append(name).append("_sum ");
+		_impl::append_number(out, static_cast<double>(timers[i].sum) / 1e9);
+		out.append("\n");
+		out.append("libmcstatus_").append(name).append("_count ").append(std::to_string(timers[i].count)).append("\n");
+	}
+
+	return out;
+}
+
+}  // namespace libmcstatus
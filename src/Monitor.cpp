@@ -0,0 +1,414 @@
+#include "libmcstatus/Monitor.hpp"
+
+#include <algorithm>
+#include <array>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <deque>
+#include <expected>
+#include <mutex>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "libmcstatus/ChangeDetector.hpp"
+#include "libmcstatus/impl/TimerWheel.hpp"
+#include "libmcstatus/impl/Utils.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+using tick_t = TimerWheel::tick_t;
+
+// Hash of the fields that count as a change for adaptive targets. Player samples and the like don't, only what people
+// actually look at
+std::uint64_t fingerprint(const JavaServer::JavaServerResponse& status) {
+	const std::array<McServer::response_int_t, 2> numbers{status.players->online, status.version->protocol};
+	std::uint64_t hash = hash_bytes(status.version->name);
+	hash = hash_bytes(status.motd, hash);
+	return hash_bytes({reinterpret_cast<const char*>(numbers.data()), sizeof(numbers)}, hash);
+}
+
+struct MonitorState : std::enable_shared_from_this<MonitorState> {
+	enum class Phase : std::uint8_t {
+		scheduled,  // On the wheel, with the target's generation
+		queued,     // Due, but waiting for max_in_flight
+		in_flight,
+	};
+
+	struct Target {
+		std::shared_ptr<const JavaServer> server;
+		Monitor::Poll poll;
+		std::optional<AdaptiveInterval> adaptive{};
+		std::optional<std::uint64_t> fingerprint{};  // Of the last status, for adaptive targets
+		double rate{0.0};  // Polls per second, its share of demand
+		std::uint32_t generation{0};
+		tick_t due{0};       // Of the next poll, or of the one queued or in flight
+		tick_t interval{0};  // Between the previous poll and due
+		Phase phase{Phase::scheduled};
+	};
+
+	using subscribers_t = std::vector<std::pair<Monitor::subscription_id_t, Monitor::subscriber_t>>;
+
+	const Monitor::Options options;
+	const std::chrono::steady_clock::time_point origin{std::chrono::steady_clock::now()};
+	boost::asio::strand<boost::asio::any_io_executor> strand;
+	boost::asio::steady_timer timer;  // Only touched on the strand
+
+	std::mutex mutex{};
+	bool stopped{false};
+	TimerWheel wheel{};
+	// Tick the timer has been set to, so that targets due earlier can wake it up
+	std::optional<tick_t> wake_tick{};
+	std::unordered_map<Monitor::target_id_t, Target> targets{};
+	// Last status of the adaptive targets, keyed by their id. Thread-safe by itself, so polls use it outside the mutex
+	ChangeDetector detector{};
+	Monitor::target_id_t next_target{1};
+	std::deque<Monitor::target_id_t> queue{};
+	std::size_t in_flight{0};
+	// Polls per second all targets together ask for, for max_queries_per_second
+	double demand{0.0};
+	// Copied on write, so publishing a result only takes a reference
+	std::shared_ptr<const subscribers_t> subscribers{std::make_shared<subscribers_t>()};
+	Monitor::subscription_id_t next_subscription{1};
+
+	MonitorState(const boost::asio::any_io_executor& executor, Monitor::Options options)
+	    : options{options}, strand{boost::asio::make_strand(executor)}, timer{strand} {}
+
+	[[nodiscard]] tick_t now_tick() const {
+		return static_cast<tick_t>((std::chrono::steady_clock::now() - origin) / options.tick);
+	}
+	[[nodiscard]] std::chrono::steady_clock::time_point time_of(tick_t tick) const {
+		return origin + (options.tick * static_cast<std::int64_t>(tick));
+	}
+	// Rounded up
+	[[nodiscard]] tick_t ticks(std::chrono::milliseconds interval) const {
+		const auto count = (interval + options.tick - std::chrono::milliseconds{1}) / options.tick;
+		return std::max<tick_t>(static_cast<tick_t>(std::max<decltype(count)>(count, 0)), 1);
+	}
+
+	// All of these expect the mutex to be held
+
+	// Before stretching to the query budget
+	[[nodiscard]] static std::chrono::milliseconds base_interval(const Target& target) {
+		return target.adaptive ? target.adaptive->next() : target.poll.interval;
+	}
+
+	[[nodiscard]] std::chrono::milliseconds next_interval(const Target& target) const {
+		const std::chrono::milliseconds interval = base_interval(target);
+
+		if ((options.max_queries_per_second <= 0.0) || (demand <= options.max_queries_per_second)) {
+			return interval;
+		}
+
+		return std::chrono::duration_cast<std::chrono::milliseconds>(interval *
+		                                                             (demand / options.max_queries_per_second));
+	}
+
+	// Whenever the interval of the target changed
+	void update_rate(Target& target) {
+		const auto interval = static_cast<double>(std::max<std::int64_t>(base_interval(target).count(), 1));
+
+		demand -= target.rate;
+		target.rate = 1000.0 / interval;
+		demand += target.rate;
+	}
+
+	// After a target with the given rate has been removed
+	void forget_rate(double rate) {
+		// Rounding errors would pile up over time otherwise
+		demand = targets.empty() ? 0.0 : std::max(demand - rate, 0.0);
+	}
+
+	void schedule(Monitor::target_id_t id, Target& target, tick_t due, tick_t interval) {
+		target.phase = Phase::scheduled;
+		target.due = std::max(due, wheel.now() + 1);
+		target.interval = interval;
+		wheel.schedule(target.due, {.id = id, .generation = target.generation});
+
+		if (!wake_tick || (target.due < *wake_tick)) {
+			wake_tick = target.due;
+			boost::asio::post(strand, [self = shared_from_this()] { self->timer.cancel(); });
+		}
+	}
+
+	// Polls of the due targets that can start right away
+	void start(Monitor::target_id_t id, Target& target,
+	           std::vector<std::pair<Monitor::target_id_t, Target*>>& starting) {
+		if (in_flight >= options.max_in_flight) {
+			target.phase = Phase::queued;
+			queue.push_back(id);
+			return;
+		}
+
+		target.phase = Phase::in_flight;
+		++in_flight;
+		starting.emplace_back(id, &target);
+	}
+
+	void start_queued(std::vector<std::pair<Monitor::target_id_t, Target*>>& starting) {
+		while (!queue.empty() && (in_flight < options.max_in_flight)) {
+			const auto target = targets.find(queue.front());
+			queue.pop_front();
+
+			// Removed targets stay in the queue until they come up
+			if ((target != targets.end()) && (target->second.phase == Phase::queued)) {
+				start(target->first, target->second, starting);
+			}
+		}
+	}
+
+	// Spawns the polls, still under the mutex (co_spawn only posts them to the strand)
+	void spawn(const std::vector<std::pair<Monitor::target_id_t, Target*>>& starting);
+
+	void run_due() {
+		std::vector<TimerWheel::Timer> expired;
+		std::vector<std::pair<Monitor::target_id_t, Target*>> starting;
+		std::lock_guard lock{mutex};
+
+		wheel.advance(now_tick(), expired);
+
+		for (const TimerWheel::Timer& timer : expired) {
+			const auto target = targets.find(timer.id);
+
+			// Removed, or rescheduled by update() since
+			if ((target != targets.end()) && (target->second.phase == Phase::scheduled) &&
+			    (target->second.generation == timer.generation)) {
+				start(target->first, target->second, starting);
+			}
+		}
+
+		spawn(starting);
+	}
+
+	void finish(Monitor::Result result, std::optional<std::uint64_t> fingerprint) {
+		std::shared_ptr<const subscribers_t> current_subscribers;
+		{
+			std::vector<std::pair<Monitor::target_id_t, Target*>> starting;
+			std::lock_guard lock{mutex};
+
+			--in_flight;
+			start_queued(starting);
+
+			const auto target = targets.find(result.target);
+			if (target != targets.end()) {
+				if (target->second.adaptive) {
+					if (result.latency) {
+						target->second.adaptive->success(result.changed);
+					} else {
+						target->second.adaptive->failure();
+					}
+					if (fingerprint) {
+						target->second.fingerprint = fingerprint;
+					}
+					update_rate(target->second);
+				}
+
+				// Keeps the polls on their schedule. Once they fell behind, the next one is a whole interval from now
+				// instead of right away, so that a backlog doesn't turn into a burst
+				result.interval = next_interval(target->second);
+				const tick_t interval = ticks(result.interval);
+				const tick_t now = now_tick();
+				const tick_t next = target->second.due + interval;
+
+				schedule(target->first, target->second, (next > now) ? next : now + interval, interval);
+				current_subscribers = subscribers;
+			} else {
+				// Removed while the poll was in flight, which may have remembered its status again
+				detector.forget(std::to_string(result.target));
+			}
+
+			spawn(starting);
+		}
+
+		if (current_subscribers) {
+			for (const auto& [id, subscriber] : *current_subscribers) {
+				subscriber(result);
+			}
+		}
+	}
+};
+
+boost::asio::awaitable<void> run_poll(std::shared_ptr<MonitorState> state, Monitor::target_id_t id,
+                                      std::shared_ptr<const JavaServer> server, Monitor::Poll poll,
+                                      std::optional<std::uint64_t> previous) {
+	Monitor::Result result{.target = id, .server = server, .query = poll.query};
+	std::optional<std::uint64_t> fingerprint;
+
+	if (poll.query == Monitor::Query::ping) {
+		result.latency = co_await server->async_try_ping(poll.timeout, std::move(poll.retry_policy));
+	} else {
+		McServer::result_t<JavaServer::RawStatus> status =
+		    co_await server->async_try_status_raw(poll.timeout, std::move(poll.retry_policy));
+
+		if (status) {
+			// Outside of the mutex, parsing takes a while
+			if (poll.adaptive) {
+				const McServer::result_t<ChangeDetector::Update> update =
+				    state->detector.update(std::to_string(id), *status);
+
+				if (update) {
+					fingerprint = ((update->change == ChangeDetector::Change::unchanged) && previous)
+					                  ? *previous
+					                  : _impl::fingerprint(*update->status);
+				}
+				if (fingerprint && previous) {
+					result.changed = *fingerprint != *previous;
+				}
+			}
+
+			result.latency = status->latency;
+			result.status = std::move(*status);
+		} else {
+			result.latency = std::unexpected{status.error()};
+		}
+	}
+
+	result.time = std::chrono::steady_clock::now();
+	state->finish(std::move(result), fingerprint);
+}
+
+void MonitorState::spawn(const std::vector<std::pair<Monitor::target_id_t, Target*>>& starting) {
+	for (const auto& [id, target] : starting) {
+		boost::asio::co_spawn(strand,
+		                      run_poll(shared_from_this(), id, target->server, target->poll, target->fingerprint),
+		                      boost::asio::detached);
+	}
+}
+
+// Sleeps until the wheel has something due, for as long as the monitor lives
+boost::asio::awaitable<void> drive(std::shared_ptr<MonitorState> state) {
+	while (true) {
+		{
+			std::lock_guard lock{state->mutex};
+			if (state->stopped) {
+				co_return;
+			}
+
+			state->wake_tick = state->wheel.next_tick();
+			state->timer.expires_at(state->wake_tick ? state->time_of(*state->wake_tick)
+			                                         : std::chrono::steady_clock::time_point::max());
+		}
+
+		// Cancelled whenever a target is due earlier than the timer, or the monitor stops
+		boost::system::error_code ec;
+		co_await state->timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+		state->run_due();
+	}
+}
+
+}  // namespace _impl
+
+Monitor::Monitor(const boost::asio::any_io_executor& executor, Options options)
+    : state{std::make_shared<_impl::MonitorState>(executor, options)} {
+	boost::asio::co_spawn(state->strand, _impl::drive(state), boost::asio::detached);
+}
+
+Monitor::~Monitor() {
+	std::lock_guard lock{state->mutex};
+
+	state->stopped = true;
+	state->targets.clear();
+	state->demand = 0.0;
+	state->subscribers = std::make_shared<_impl::MonitorState::subscribers_t>();
+	boost::asio::post(state->strand, [state = state] { state->timer.cancel(); });
+}
+
+auto Monitor::add(JavaServer server, const Poll& poll) -> target_id_t {
+	// For spreading out the first polls
+	thread_local std::minstd_rand rng{std::random_device{}()};
+	std::lock_guard lock{state->mutex};
+
+	const target_id_t id = state->next_target++;
+	auto& target = state->targets[id] = {.server = std::make_shared<const JavaServer>(std::move(server)), .poll = poll};
+	if (poll.adaptive) {
+		target.adaptive.emplace(*poll.adaptive, poll.interval);
+	}
+	state->update_rate(target);
+
+	// The wheel only moves on when something is due, so it may be behind by now
+	const _impl::tick_t interval = state->ticks(state->next_interval(target));
+	const _impl::tick_t now = std::max(state->now_tick(), state->wheel.now());
+	state->schedule(id, target, now + std::uniform_int_distribution<_impl::tick_t>{1, interval}(rng), interval);
+
+	return id;
+}
+
+bool Monitor::update(target_id_t target, const Poll& poll) {
+	std::lock_guard lock{state->mutex};
+
+	const auto found = state->targets.find(target);
+	if (found == state->targets.end()) {
+		return false;
+	}
+
+	_impl::MonitorState::Target& updated = found->second;
+	updated.poll = poll;
+	updated.adaptive.reset();
+	if (poll.adaptive) {
+		updated.adaptive.emplace(*poll.adaptive, poll.interval);
+	}
+	state->update_rate(updated);
+
+	// Polls queued or in flight get rescheduled with the new interval once they're done
+	if (updated.phase == _impl::MonitorState::Phase::scheduled) {
+		const _impl::tick_t previous = (updated.due > updated.interval) ? updated.due - updated.interval : 0;
+		const _impl::tick_t interval = state->ticks(state->next_interval(updated));
+
+		++updated.generation;
+		state->schedule(target, updated, previous + interval, interval);
+	}
+
+	return true;
+}
+
+bool Monitor::remove(target_id_t target) {
+	std::lock_guard lock{state->mutex};
+
+	const auto found = state->targets.find(target);
+	if (found == state->targets.end()) {
+		return false;
+	}
+
+	const double rate = found->second.rate;
+	state->targets.erase(found);
+	state->forget_rate(rate);
+	state->detector.forget(std::to_string(target));
+
+	return true;
+}
+
+std::size_t Monitor::size() const {
+	std::lock_guard lock{state->mutex};
+	return state->targets.size();
+}
+
+auto Monitor::subscribe(subscriber_t subscriber) -> subscription_id_t {
+	std::lock_guard lock{state->mutex};
+
+	auto subscribers = std::make_shared<_impl::MonitorState::subscribers_t>(*state->subscribers);
+	const subscription_id_t id = state->next_subscription++;
+	subscribers->emplace_back(id, std::move(subscriber));
+	state->subscribers = std::move(subscribers);
+
+	return id;
+}
+
+void Monitor::unsubscribe(subscription_id_t subscription) {
+	std::lock_guard lock{state->mutex};
+
+	auto subscribers = std::make_shared<_impl::MonitorState::subscribers_t>(*state->subscribers);
+	std::erase_if(*subscribers, [&](const auto& entry) { return entry.first == subscription; });
+	state->subscribers = std::move(subscribers);
+}
+
+}  // namespace libmcstatus
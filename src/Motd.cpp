@@ -0,0 +1,271 @@
+#include "libmcstatus/Motd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <memory>
+
+#include "libmcstatus/impl/JsonScanner.hpp"
+#include "libmcstatus/impl/Utils.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+using Component = Motd::Component;
+
+struct Style {
+	std::optional<std::uint32_t> color{};
+	std::uint8_t format{0};
+};
+
+// In the order of the legacy codes §0 to §f
+constexpr std::array<std::string_view, 16> COLOR_NAMES{
+    "black",     "dark_blue", "dark_green", "dark_aqua", "dark_red", "dark_purple",  "gold",   "gray",
+    "dark_gray", "blue",      "green",      "aqua",      "red",      "light_purple", "yellow", "white",
+};
+constexpr std::array<std::uint32_t, 16> COLORS{
+    0x000000, 0x0000AA, 0x00AA00, 0x00AAAA, 0xAA0000, 0xAA00AA, 0xFFAA00, 0xAAAAAA,
+    0x555555, 0x5555FF, 0x55FF55, 0x55FFFF, 0xFF5555, 0xFF55FF, 0xFFFF55, 0xFFFFFF,
+};
+
+// Names of the format flags, as used by both chat components and the legacy codes §k to §o
+struct FormatKey {
+	std::string_view name;
+	char code;
+	std::uint8_t flag;
+};
+constexpr std::array<FormatKey, 5> FORMAT_KEYS{{
+    {"obfuscated", 'k', Motd::obfuscated},
+    {"bold", 'l', Motd::bold},
+    {"strikethrough", 'm', Motd::strikethrough},
+    {"underlined", 'n', Motd::underlined},
+    {"italic", 'o', Motd::italic},
+}};
+
+// Like in the game, colors reset the formatting and §r goes back to the style the text started with
+void apply_code(char code, const Style& base, Style& style) {
+	code = static_cast<char>((code >= 'A' && code <= 'Z') ? (code - 'A' + 'a') : code);
+
+	if (code >= '0' && code <= '9') {
+		style = {.color = COLORS[static_cast<std::size_t>(code - '0')]};
+	} else if (code >= 'a' && code <= 'f') {
+		style = {.color = COLORS[static_cast<std::size_t>(code - 'a' + 10)]};
+	} else if (code == 'r') {
+		style = base;
+	} else if (const auto key = std::ranges::find(FORMAT_KEYS, code, &FormatKey::code); key != FORMAT_KEYS.end()) {
+		style.format |= key->flag;
+	}
+}
+
+// Unknown colors leave the inherited one as it is
+void apply_color(std::string_view color, Style& style) {
+	if (color == "reset") {
+		style.color = std::nullopt;
+	} else if (const auto name = std::ranges::find(COLOR_NAMES, color); name != COLOR_NAMES.end()) {
+		style.color = COLORS[static_cast<std::size_t>(name - COLOR_NAMES.begin())];
+	} else if ((color.size() == 7) && color.starts_with('#')) {
+		std::uint32_t rgb;
+		const auto [end, ec] = std::from_chars(color.data() + 1, color.data() + color.size(), rgb, 16);
+
+		if ((ec == std::errc{}) && (end == color.data() + color.size())) {
+			style.color = rgb;
+		}
+	}
+}
+
+// Adds the component for text, with a child for every part following a § code. Returns the component's index, its
+// end is left for the caller to set
+std::size_t add_text(std::string_view text, const Style& style, std::vector<Component>& components) {
+	const std::size_t index = components.size();
+	std::size_t code = find_section_sign(text);
+	components.push_back({.text = text.substr(0, code), .color = style.color, .format = style.format});
+
+	Style current = style;
+	while (code < text.size()) {
+		std::size_t offset = code + 2;
+		if (offset < text.size()) {
+			apply_code(text[offset], style, current);
+			offset = std::min(offset + utf8_length(text[offset]), text.size());
+		}
+
+		code = find_section_sign(text, offset);
+		if (code > offset) {
+			components.push_back({.text = text.substr(offset, code - offset),
+			                      .color = current.color,
+			                      .format = current.format,
+			                      .end = static_cast<std::uint32_t>(components.size() + 1)});
+		}
+	}
+
+	return index;
+}
+
+void close(std::size_t index, std::vector<Component>& components) {
+	components[index].end = static_cast<std::uint32_t>(components.size());
+}
+
+// Parses any kind of chat component (string, array or object) and its children. own is set to the style of the
+// component itself, which the elements following the first one of an array inherit
+[[nodiscard]] bool parse_component(JsonScanner& scanner, const Style& inherited, std::vector<Component>& components,
+                                   Style& own) {
+	own = inherited;
+
+	if (scanner.peek() == '"') {
+		const std::optional<std::string_view> text = scanner.read_string();
+		if (!text) {
+			return false;
+		}
+
+		close(add_text(*text, inherited, components), components);
+		return true;
+	}
+
+	if (scanner.peek() == '[') {
+		std::optional<std::size_t> index;
+		Style child_style;
+
+		const bool valid = scanner.array([&] {
+			if (index) {
+				return parse_component(scanner, own, components, child_style);
+			}
+
+			index = components.size();
+			return parse_component(scanner, inherited, components, own);
+		});
+		if (!valid) {
+			return false;
+		}
+
+		if (!index) {
+			index = add_text({}, inherited, components);
+		}
+		close(*index, components);
+		return true;
+	}
+
+	if (scanner.peek() != '{') {
+		// Numbers and booleans are shown as they are
+		const std::optional<std::string_view> raw = scanner.skip_value();
+		if (!raw) {
+			return false;
+		}
+
+		close(add_text((*raw == "null") ? std::string_view{} : *raw, inherited, components), components);
+		return true;
+	}
+
+	// Children inherit the style, which may come after extra, so extra is only parsed once the object is done
+	std::string_view text;
+	std::optional<std::string_view> extra;
+
+	const bool valid = scanner.object([&](std::string_view key) {
+		if ((key == "text" || key == "color") && (scanner.peek() == '"')) {
+			const std::optional<std::string_view> value = scanner.read_string();
+			if (value && (key == "text")) {
+				text = *value;
+			} else if (value) {
+				apply_color(*value, own);
+			}
+			return value.has_value();
+		}
+
+		const std::optional<std::string_view> raw = scanner.skip_value();
+		if (!raw) {
+			return false;
+		}
+
+		if ((key == "extra") && raw->starts_with('[')) {
+			extra = raw;
+		} else if (const auto format = std::ranges::find(FORMAT_KEYS, key, &FormatKey::name);
+		           format != FORMAT_KEYS.end()) {
+			const std::optional<bool> enabled = JsonScanner::to_bool(*raw);
+			if (enabled) {
+				const std::uint8_t flag = format->flag;
+				own.format = static_cast<std::uint8_t>(*enabled ? (own.format | flag) : (own.format & ~flag));
+			}
+		}
+		return true;
+	});
+	if (!valid) {
+		return false;
+	}
+
+	const std::size_t index = add_text(text, own, components);
+
+	if (extra) {
+		// Already validated as a whole by skip_value(), but not unescaped yet
+		JsonScanner children{const_cast<char*>(extra->data()), const_cast<char*>(extra->data() + extra->size())};
+		Style child_style;
+
+		if (!children.array([&] { return parse_component(children, own, components, child_style); })) {
+			return false;
+		}
+	}
+
+	close(index, components);
+	return true;
+}
+
+}  // namespace _impl
+
+Motd::Motd(Motd&& other) noexcept : raw_motd{std::move(other.raw_motd)}, parsed{other.parsed.exchange(nullptr)} {}
+
+Motd& Motd::operator=(Motd&& other) noexcept {
+	raw_motd = std::move(other.raw_motd);
+	delete parsed.exchange(other.parsed.exchange(nullptr));
+
+	return *this;
+}
+
+Motd::~Motd() {
+	delete parsed.load();
+}
+
+std::string Motd::plain_text() const {
+	if (!raw_motd.starts_with('{') && !raw_motd.starts_with('[')) {
+		return _impl::strip_formatting_codes(raw_motd);
+	}
+
+	std::string text;
+	text.reserve(raw_motd.size());
+
+	for (const Component& component : components()) {
+		text.append(component.text);
+	}
+
+	return text;
+}
+
+std::span<const Motd::Component> Motd::components() const {
+	if (const Parsed* existing = parsed.load(std::memory_order_acquire)) {
+		return existing->components;
+	}
+
+	auto parsing = std::make_unique<Parsed>(raw_motd);
+	bool valid = false;
+
+	if (raw_motd.starts_with('{') || raw_motd.starts_with('[')) {
+		_impl::JsonScanner scanner{parsing->arena.data(), parsing->arena.data() + parsing->arena.size()};
+		_impl::Style style;
+
+		valid = _impl::parse_component(scanner, {}, parsing->components, style) && scanner.at_end();
+	}
+
+	if (!valid) {
+		// Unescaping may have changed the arena already
+		parsing->arena = raw_motd;
+		parsing->components.clear();
+		_impl::close(_impl::add_text(parsing->arena, {}, parsing->components), parsing->components);
+	}
+
+	// Several threads may have parsed at once, the first one to finish wins
+	const Parsed* expected = nullptr;
+	if (parsed.compare_exchange_strong(expected, parsing.get(), std::memory_order_acq_rel, std::memory_order_acquire)) {
+		return parsing.release()->components;
+	}
+
+	return expected->components;
+}
+
+}  // namespace libmcstatus
@@ -0,0 +1,72 @@
+#include "libmcstatus/PlayerTracker.hpp"
+
+#include <utility>
+
+namespace libmcstatus {
+
+template <typename Sample>
+std::vector<PlayerEvent> PlayerTracker::update_sample(std::string_view endpoint, const Sample& sample) {
+	// The new sample is built here and swapped with the endpoint's set, which then becomes the next scratch set. So
+	// once warmed up, nothing gets allocated unless players actually change
+	thread_local _impl::UuidSet scratch;
+	std::vector<PlayerEvent> events;
+
+	players.with(endpoint, [&](_impl::UuidSet& previous) {
+		scratch.clear(sample.size());
+		for (const auto& player : sample) {
+			if (!player.id.is_nil() && scratch.insert(player.id) && !previous.contains(player.id)) {
+				events.push_back({PlayerEvent::Type::join, player.id, std::string{player.name}});
+			}
+		}
+
+		previous.for_each([&](const boost::uuids::uuid& id) {
+			if (!scratch.contains(id)) {
+				events.push_back({PlayerEvent::Type::leave, id, {}});
+			}
+		});
+
+		std::swap(previous, scratch);
+	});
+
+	return events;
+}
+
+std::vector<PlayerEvent> PlayerTracker::update(std::string_view endpoint,
+                                               const JavaServer::JavaServerResponse& status) {
+	static const std::vector<JavaServer::JavaServerResponse::JavaStatusPlayers::JavaStatusPlayer> empty{};
+
+	if (!status.players->sample && (status.players->online != 0)) {
+		return {};
+	}
+
+	return update_sample(endpoint, status.players->sample ? *status.players->sample : empty);
+}
+
+std::vector<PlayerEvent> PlayerTracker::update(std::string_view endpoint, const JavaStatusView& status) {
+	static const std::vector<JavaStatusView::Player> empty{};
+
+	if (!status.sample && (status.online != 0)) {
+		return {};
+	}
+
+	return update_sample(endpoint, status.sample ? *status.sample : empty);
+}
+
+void PlayerTracker::forget(std::string_view endpoint) {
+	players.erase(endpoint);
+}
+
+std::size_t PlayerTracker::size() const {
+	return players.size();
+}
+
+std::size_t PlayerTracker::memory_usage() const {
+	std::size_t bytes = 0;
+	players.for_each([&](const std::string&, const _impl::UuidSet& endpoint_players) {
+		bytes += endpoint_players.memory_usage();
+	});
+
+	return bytes;
+}
+
+}  // namespace libmcstatus
@@ -0,0 +1,284 @@
+#include "libmcstatus/ResultStore.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace libmcstatus {
+
+namespace _impl {
+
+// Magic, row count and the offset and size of every section
+constexpr std::size_t STORE_HEADER_SIZE{ResultStore::MAGIC.size() + sizeof(std::uint64_t) +
+                                        (STORE_SECTIONS * 2 * sizeof(std::uint64_t))};
+constexpr std::size_t STORE_ALIGNMENT{8};
+
+template <typename T>
+std::pair<const char*, std::size_t> as_bytes(const std::vector<T>& values) {
+	return {reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T)};
+}
+
+std::pair<const char*, std::size_t> as_bytes(const std::string& bytes) {
+	return {bytes.data(), bytes.size()};
+}
+
+}  // namespace _impl
+
+std::uint32_t ResultStoreWriter::Dictionary::id(std::string_view string) {
+	if (const auto existing = ids.find(string); existing != ids.end()) {
+		return existing->second;
+	}
+
+	const auto new_id = static_cast<std::uint32_t>(ids.size());
+	ids.emplace(std::string{string}, new_id);
+	bytes.append(string);
+	offsets.push_back(bytes.size());
+
+	return new_id;
+}
+
+void ResultStoreWriter::append(std::string_view endpoint, std::chrono::system_clock::time_point time,
+                               const JavaServer::JavaServerResponse& status) {
+	endpoint_bytes.append(endpoint);
+	endpoint_offsets.push_back(endpoint_bytes.size());
+
+	timestamps.push_back(std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count());
+	latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(status.latency).count());
+	online.push_back(status.players->online);
+	max.push_back(status.players->max);
+	protocols.push_back(status.version->protocol);
+
+	version_ids.push_back(versions.id(status.version->name));
+	motd_ids.push_back(motds.id(status.motd));
+	icon_ids.push_back(status.icon ? icons.id(*status.icon) : ResultStore::NO_ICON);
+}
+
+void ResultStoreWriter::write(const std::filesystem::path& path) const {
+	// In the order of _impl::StoreSection
+	const std::array<std::pair<const char*, std::size_t>, _impl::STORE_SECTIONS> contents{
+	    _impl::as_bytes(endpoint_offsets),
+	    _impl::as_bytes(endpoint_bytes),
+	    _impl::as_bytes(timestamps),
+	    _impl::as_bytes(latencies),
+	    _impl::as_bytes(online),
+	    _impl::as_bytes(max),
+	    _impl::as_bytes(protocols),
+	    _impl::as_bytes(version_ids),
+	    _impl::as_bytes(motd_ids),
+	    _impl::as_bytes(icon_ids),
+	    _impl::as_bytes(versions.offsets),
+	    _impl::as_bytes(versions.bytes),
+	    _impl::as_bytes(motds.offsets),
+	    _impl::as_bytes(motds.bytes),
+	    _impl::as_bytes(icons.offsets),
+	    _impl::as_bytes(icons.bytes),
+	};
+
+	std::array<std::uint64_t, _impl::STORE_SECTIONS * 2> table{};
+	std::uint64_t offset = _impl::STORE_HEADER_SIZE;
+	for (std::size_t section = 0; section < _impl::STORE_SECTIONS; ++section) {
+		offset = (offset + _impl::STORE_ALIGNMENT - 1) / _impl::STORE_ALIGNMENT * _impl::STORE_ALIGNMENT;
+		table[section * 2] = offset;
+		table[(section * 2) + 1] = contents[section].second;
+		offset += contents[section].second;
+	}
+
+	std::ofstream file{path, std::ios::binary | std::ios::trunc};
+	if (!file) {
+		throw std::runtime_error{"Failed to open result store \"" + path.string() + "\""};
+	}
+
+	const std::uint64_t rows = size();
+	file.write(ResultStore::MAGIC.data(), static_cast<std::streamsize>(ResultStore::MAGIC.size()));
+	file.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+	file.write(reinterpret_cast<const char*>(table.data()), sizeof(table));
+
+	static constexpr std::array<char, _impl::STORE_ALIGNMENT> PADDING{};
+	std::uint64_t written = _impl::STORE_HEADER_SIZE;
+	for (std::size_t section = 0; section < _impl::STORE_SECTIONS; ++section) {
+		file.write(PADDING.data(), static_cast<std::streamsize>(table[section * 2] - written));
+		file.write(contents[section].first, static_cast<std::streamsize>(contents[section].second));
+		written = table[section * 2] + contents[section].second;
+	}
+
+	file.close();
+	if (!file) {
+		throw std::runtime_error{"Failed to write result store \"" + path.string() + "\""};
+	}
+}
+
+ResultStore::ResultStore(ResultStore&& other) noexcept
+    : data{std::exchange(other.data, nullptr)},
+      length{std::exchange(other.length, 0)},
+      rows{std::exchange(other.rows, 0)},
+      sections{other.sections} {}
+
+ResultStore& ResultStore::operator=(ResultStore&& other) noexcept {
+	std::swap(data, other.data);
+	std::swap(length, other.length);
+	std::swap(rows, other.rows);
+	std::swap(sections, other.sections);
+
+	return *this;
+}
+
+ResultStore::~ResultStore() {
+	if (data != nullptr) {
+		munmap(const_cast<std::byte*>(data), length);
+	}
+}
+
+auto ResultStore::try_open(const std::filesystem::path& path) -> std::expected<ResultStore, McError> {
+	const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		return std::unexpected{McError::bad_frame};
+	}
+
+	struct stat file_stat{};
+	const bool big_enough =
+	    (fstat(fd, &file_stat) == 0) && (static_cast<std::size_t>(file_stat.st_size) >= _impl::STORE_HEADER_SIZE);
+	void* mapping = big_enough
+	                    ? mmap(nullptr, static_cast<std::size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0)
+	                    : MAP_FAILED;
+	close(fd);  // The mapping stays valid without it
+
+	if (mapping == MAP_FAILED) {
+		return std::unexpected{McError::bad_frame};
+	}
+
+	ResultStore store;
+	store.data = static_cast<const std::byte*>(mapping);
+	store.length = static_cast<std::size_t>(file_stat.st_size);
+
+	if (!store.valid()) {
+		return std::unexpected{McError::bad_frame};
+	}
+
+	return store;
+}
+
+bool ResultStore::valid() {
+	using _impl::StoreSection;
+
+	if (std::memcmp(data, MAGIC.data(), MAGIC.size()) != 0) {
+		return false;
+	}
+
+	std::uint64_t row_count;
+	std::memcpy(&row_count, data + MAGIC.size(), sizeof(row_count));
+	std::memcpy(sections.data(), data + MAGIC.size() + sizeof(row_count), sizeof(sections));
+
+	// Also keeps the size calculations below from overflowing
+	if (row_count > (length / sizeof(std::uint32_t))) {
+		return false;
+	}
+	rows = static_cast<std::size_t>(row_count);
+
+	for (const Section& section : sections) {
+		if (((section.offset % _impl::STORE_ALIGNMENT) != 0) || (section.offset > length) ||
+		    (section.size > (length - section.offset))) {
+			return false;
+		}
+	}
+
+	const auto size_of = [&](StoreSection section) { return sections[static_cast<std::size_t>(section)].size; };
+	for (const StoreSection column : {StoreSection::timestamps, StoreSection::latencies, StoreSection::online,
+	                                  StoreSection::max, StoreSection::protocols}) {
+		if (size_of(column) != (rows * sizeof(std::int64_t))) {
+			return false;
+		}
+	}
+	for (const StoreSection column : {StoreSection::version_ids, StoreSection::motd_ids, StoreSection::icon_ids}) {
+		if (size_of(column) != (rows * sizeof(std::uint32_t))) {
+			return false;
+		}
+	}
+
+	// Strings must lie within their bytes, so that reading them needs no checks
+	const auto valid_strings = [&](StoreSection offsets, StoreSection bytes) {
+		const std::span<const std::uint64_t> starts = column<std::uint64_t>(offsets);
+		return ((size_of(offsets) % sizeof(std::uint64_t)) == 0) && !starts.empty() && (starts.front() == 0) &&
+		       std::ranges::is_sorted(starts) && (starts.back() == size_of(bytes));
+	};
+	if ((size_of(StoreSection::endpoint_offsets) != ((rows + 1) * sizeof(std::uint64_t))) ||
+	    !valid_strings(StoreSection::endpoint_offsets, StoreSection::endpoint_bytes) ||
+	    !valid_strings(StoreSection::version_offsets, StoreSection::version_bytes) ||
+	    !valid_strings(StoreSection::motd_offsets, StoreSection::motd_bytes) ||
+	    !valid_strings(StoreSection::icon_offsets, StoreSection::icon_bytes)) {
+		return false;
+	}
+
+	return std::ranges::all_of(version_ids(), [&](std::uint32_t id) { return id < version_count(); }) &&
+	       std::ranges::all_of(motd_ids(), [&](std::uint32_t id) { return id < motd_count(); }) &&
+	       std::ranges::all_of(icon_ids(), [&](std::uint32_t id) { return (id < icon_count()) || (id == NO_ICON); });
+}
+
+std::string_view ResultStore::string(_impl::StoreSection offsets, _impl::StoreSection bytes, std::size_t id) const {
+	const std::span<const std::uint64_t> starts = column<std::uint64_t>(offsets);
+	const auto* begin = reinterpret_cast<const char*>(data + sections[static_cast<std::size_t>(bytes)].offset);
+
+	return {begin + starts[id], static_cast<std::size_t>(starts[id + 1] - starts[id])};
+}
+
+std::string_view ResultStore::endpoint(std::size_t row) const {
+	return string(_impl::StoreSection::endpoint_offsets, _impl::StoreSection::endpoint_bytes, row);
+}
+
+std::string_view ResultStore::version(std::uint32_t id) const {
+	return string(_impl::StoreSection::version_offsets, _impl::StoreSection::version_bytes, id);
+}
+
+std::string_view ResultStore::motd(std::uint32_t id) const {
+	return string(_impl::StoreSection::motd_offsets, _impl::StoreSection::motd_bytes, id);
+}
+
+std::string_view ResultStore::icon(std::uint32_t id) const {
+	return string(_impl::StoreSection::icon_offsets, _impl::StoreSection::icon_bytes, id);
+}
+
+std::size_t ResultStore::version_count() const {
+	return column<std::uint64_t>(_impl::StoreSection::version_offsets).size() - 1;
+}
+
+std::size_t ResultStore::motd_count() const {
+	return column<std::uint64_t>(_impl::StoreSection::motd_offsets).size() - 1;
+}
+
+std::size_t ResultStore::icon_count() const {
+	return column<std::uint64_t>(_impl::StoreSection::icon_offsets).size() - 1;
+}
+
+std::optional<std::uint32_t> ResultStore::find_version(std::string_view name) const {
+	for (std::uint32_t id = 0; id < version_count(); ++id) {
+		if (version(id) == name) {
+			return id;
+		}
+	}
+
+	return std::nullopt;
+}
+
+StoredResult ResultStore::operator[](std::size_t row) const {
+	const std::uint32_t icon_id = icon_ids()[row];
+
+	return {
+	    .endpoint = endpoint(row),
+	    .time = std::chrono::system_clock::time_point{std::chrono::microseconds{timestamps()[row]}},
+	    .latency = std::chrono::duration_cast<McServer::latency_t>(std::chrono::nanoseconds{latencies()[row]}),
+	    .online = online()[row],
+	    .max = max()[row],
+	    .protocol = protocols()[row],
+	    .version_name = version(version_ids()[row]),
+	    .motd = motd(motd_ids()[row]),
+	    .icon = (icon_id != NO_ICON) ? std::optional{icon(icon_id)} : std::nullopt,
+	};
+}
+
+}  // namespace libmcstatus
@@ -0,0 +1,66 @@
+#include "libmcstatus/RetryPolicy.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace libmcstatus {
+
+void LatencyWindow::record(duration_t latency) {
+	const std::size_t index = count.fetch_add(1, std::memory_order_relaxed) % CAPACITY;
+	samples[index].store(latency.count(), std::memory_order_relaxed);
+}
+
+std::size_t LatencyWindow::size() const {
+	return std::min(count.load(std::memory_order_relaxed), CAPACITY);
+}
+
+auto LatencyWindow::percentile(double percentile) const -> std::optional<duration_t> {
+	const std::size_t samples_size = size();
+
+	if (samples_size == 0) {
+		return std::nullopt;
+	}
+
+	std::array<duration_t::rep, CAPACITY> sorted;
+	for (std::size_t i = 0; i < samples_size; ++i) {
+		sorted[i] = samples[i].load(std::memory_order_relaxed);
+	}
+
+	const auto rank =
+	    static_cast<std::size_t>(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(samples_size - 1));
+	std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.begin() + samples_size);
+
+	return duration_t{sorted[rank]};
+}
+
+std::chrono::steady_clock::duration HedgePolicy::delay() const {
+	if (latencies && (latencies->size() >= min_samples)) {
+		if (const auto threshold = latencies->percentile(percentile)) {
+			return *threshold;
+		}
+	}
+
+	return initial_delay;
+}
+
+bool RetryPolicy::should_retry(std::size_t attempt, McError error) const {
+	return (attempt < max_attempts) && retryable.contains(error);
+}
+
+std::chrono::steady_clock::duration RetryPolicy::backoff(std::size_t attempt) const {
+	// For the jitter
+	thread_local std::minstd_rand rng{std::random_device{}()};
+
+	const double exponent = static_cast<double>(std::max<std::size_t>(attempt, 1) - 1);
+	const double backoff =
+	    std::min(static_cast<double>(initial_backoff.count()) * std::pow(backoff_multiplier, exponent),
+	             static_cast<double>(max_backoff.count()));
+
+	std::uniform_real_distribution<double> dist{1.0 - std::clamp(jitter, 0.0, 1.0), 1.0};
+
+	return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+	    std::chrono::duration<double, std::milli>{backoff * dist(rng)});
+}
+
+}  // namespace libmcstatus
@@ -0,0 +1,75 @@
+#include "libmcstatus/RttEstimator.hpp"
+
+#include <algorithm>
+
+namespace libmcstatus {
+
+void RttEstimator::sample(duration_t rtt) {
+	rtt = std::max(rtt, duration_t::zero());
+	backoffs = 0;
+
+	if (!sampled) {
+		smoothed = rtt;
+		variation = rtt / 2;
+		sampled = true;
+		return;
+	}
+
+	// RTTVAR first, as it depends on the previous SRTT. Weights are 1/4 and 1/8, like RFC 6298 recommends
+	const duration_t deviation = (smoothed > rtt) ? smoothed - rtt : rtt - smoothed;
+	variation = variation - (variation / 4) + (deviation / 4);
+	smoothed = smoothed - (smoothed / 8) + (rtt / 8);
+}
+
+void RttEstimator::timed_out() {
+	++backoffs;
+}
+
+std::chrono::milliseconds RttEstimator::timeout(std::chrono::milliseconds min_timeout,
+                                                std::chrono::milliseconds max_timeout) const {
+	max_timeout = std::max(min_timeout, max_timeout);
+
+	if (!sampled) {
+		return max_timeout;
+	}
+
+	auto timeout = std::chrono::ceil<std::chrono::milliseconds>(smoothed + (4 * variation));
+	// Doubling more than that overflows long before, and is beyond any sensible ceiling anyway
+	for (std::size_t backoff = 0; (backoff < std::min<std::size_t>(backoffs, 32)) && (timeout < max_timeout);
+	     ++backoff) {
+		timeout *= 2;
+	}
+
+	return std::clamp(timeout, min_timeout, max_timeout);
+}
+
+void RttTable::sample(std::string_view endpoint, RttEstimator::duration_t rtt) {
+	estimators.with(endpoint, [&](RttEstimator& estimator) { estimator.sample(rtt); });
+}
+
+void RttTable::timed_out(std::string_view endpoint) {
+	estimators.with(endpoint, [](RttEstimator& estimator) { estimator.timed_out(); });
+}
+
+std::chrono::milliseconds RttTable::timeout(std::string_view endpoint, std::chrono::milliseconds min_timeout,
+                                            std::chrono::milliseconds max_timeout) const {
+	if (const auto estimator = estimators.get(endpoint)) {
+		return estimator->timeout(min_timeout, max_timeout);
+	}
+
+	return std::max(min_timeout, max_timeout);
+}
+
+std::optional<RttEstimator> RttTable::get(std::string_view endpoint) const {
+	return estimators.get(endpoint);
+}
+
+void RttTable::forget(std::string_view endpoint) {
+	estimators.erase(endpoint);
+}
+
+std::size_t RttTable::size() const {
+	return estimators.size();
+}
+
+}  // namespace libmcstatus
@@ -9,27 +9,35 @@
 #include <sstream>
 #include <stdexcept>
 
+#include "libmcstatus/impl/Tracing.hpp"
+#include "libmcstatus/Metrics.hpp"
+
 namespace libmcstatus::_impl {
 
 std::weak_ordering SrvRecord::operator<=>(const SrvRecord& rhs) const {
 	return this->priority <=> rhs.priority;
 }
 
-records_t resolve_srv(std::string_view service, std::string_view proto, std::string_view domain) {
+std::expected<records_t, McError> try_resolve_srv(std::string_view service, std::string_view proto,
+                                                  std::string_view domain) {
+	Metrics::increment(Metrics::Counter::srv_queries);
+
 	std::ostringstream ss;
 	ss << "_" << service << "._" << proto << "." << domain;
 	const std::string qname = ss.str();
 
 	// Buffer for the DNS response
 	unsigned char answer[NS_PACKETSZ];
+	LIBMCSTATUS_TRACE(srv__start, qname.c_str());
 	const int len = res_query(qname.c_str(), C_IN, T_SRV, answer, sizeof(answer));
+	LIBMCSTATUS_TRACE(srv__done, qname.c_str(), len);
 	if (len < 0) {
-		throw std::runtime_error("SRV query failed for " + qname);
+		return std::unexpected{McError::resolve_failed};
 	}
 
 	ns_msg handle;
 	if (ns_initparse(answer, len, &handle) < 0) {
-		throw std::runtime_error("ns_initparse failed");
+		return std::unexpected{McError::resolve_failed};
 	}
 
 	std::uint16_t count = ns_msg_count(handle, ns_s_an);
@@ -60,8 +68,19 @@ records_t resolve_srv(std::string_view service, std::string_view proto, std::str
 	return results;
 }
 
-// Initialize the random number generator with an actual random seed
-std::minstd_rand rng{std::random_device{}()};
+records_t resolve_srv(std::string_view service, std::string_view proto, std::string_view domain) {
+	std::expected<records_t, McError> records = try_resolve_srv(service, proto, domain);
+
+	if (!records) {
+		throw std::runtime_error("SRV query failed for _" + std::string{service} + "._" + std::string{proto} + "." +
+		                         std::string{domain});
+	}
+
+	return std::move(*records);
+}
+
+// Initialize the random number generator with an actual random seed (once per thread)
+thread_local std::minstd_rand rng{std::random_device{}()};
 
 const SrvRecord& pick_record(const records_t& records) {
 	if (records.empty()) {
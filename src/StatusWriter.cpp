@@ -0,0 +1,310 @@
+#include "libmcstatus/StatusWriter.hpp"
+
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <system_error>
+
+#include "libmcstatus/impl/JsonScanner.hpp"
+#include "libmcstatus/impl/Utils.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+constexpr std::string_view HEX_DIGITS{"0123456789abcdef"};
+
+void append_uuid(std::string& output, const boost::uuids::uuid& id) {
+	std::array<char, 38> text;
+	std::size_t length = 0;
+
+	text[length++] = '"';
+	for (std::size_t i = 0; i < id.size(); ++i) {
+		if ((i == 4) || (i == 6) || (i == 8) || (i == 10)) {
+			text[length++] = '-';
+		}
+		text[length++] = HEX_DIGITS[id.data[i] >> 4];
+		text[length++] = HEX_DIGITS[id.data[i] & 0x0F];
+	}
+	text[length++] = '"';
+
+	output.append(text.data(), length);
+}
+
+// Letter of the two character escape of c, '\0' if it has none
+char short_escape(char c) {
+	switch (c) {
+		case '"':
+			return '"';
+		case '\\':
+			return '\\';
+		case '\b':
+			return 'b';
+		case '\f':
+			return 'f';
+		case '\n':
+			return 'n';
+		case '\r':
+			return 'r';
+		case '\t':
+			return 't';
+		default:
+			return '\0';
+	}
+}
+
+// Copies valid JSON without any whitespace between tokens, so that it fits on one line
+void append_minified(std::string& output, std::string_view json) {
+	bool in_string = false;
+	std::size_t run = 0;
+
+	for (std::size_t i = 0; i < json.size(); ++i) {
+		const char c = json[i];
+
+		if (in_string) {
+			if (c == '\\') {
+				++i;
+			} else if (c == '"') {
+				in_string = false;
+			}
+		} else if (c == '"') {
+			in_string = true;
+		} else if ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r')) {
+			output.append(json.substr(run, i - run));
+			run = i + 1;
+		}
+	}
+
+	output.append(json.substr(run));
+}
+
+}  // namespace _impl
+
+StatusWriter::StatusWriter(std::FILE* file, StatusFields fields) : output{&buffer}, file{file}, fields{fields} {
+	buffer.reserve(BUFFER_SIZE * 2);
+}
+
+StatusWriter::StatusWriter(int fd, StatusFields fields) : output{&buffer}, fd{fd}, fields{fields} {
+	buffer.reserve(BUFFER_SIZE * 2);
+}
+
+StatusWriter::~StatusWriter() {
+	try {
+		flush();
+	} catch (const std::system_error&) {
+		// Nowhere left to report it
+	}
+}
+
+void StatusWriter::flush() {
+	if ((output != &buffer) || buffer.empty()) {
+		return;
+	}
+
+	if (file != nullptr) {
+		if (std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+			buffer.clear();
+			throw std::system_error{errno, std::generic_category(), "Failed to write statuses"};
+		}
+	} else {
+		for (std::size_t written = 0; written < buffer.size();) {
+			const ssize_t result = ::write(fd, buffer.data() + written, buffer.size() - written);
+
+			if ((result < 0) && (errno != EINTR)) {
+				buffer.clear();
+				throw std::system_error{errno, std::generic_category(), "Failed to write statuses"};
+			}
+			// Nothing written without an error would just be tried again forever
+			if (result == 0) {
+				buffer.clear();
+				throw std::system_error{std::make_error_code(std::errc::io_error), "Failed to write statuses"};
+			}
+			written += (result > 0) ? static_cast<std::size_t>(result) : 0;
+		}
+	}
+
+	buffer.clear();
+}
+
+void StatusWriter::begin(std::string_view endpoint) {
+	output->append(R"({"endpoint":)");
+	string(endpoint);
+}
+
+void StatusWriter::end() {
+	output->append("}\n");
+
+	if ((output == &buffer) && (buffer.size() >= BUFFER_SIZE)) {
+		flush();
+	}
+}
+
+void StatusWriter::key(std::string_view name) {
+	output->push_back(',');
+	output->push_back('"');
+	output->append(name);
+	output->append("\":");
+}
+
+void StatusWriter::string(std::string_view value) {
+	output->push_back('"');
+
+	for (std::size_t offset = 0;;) {
+		const std::size_t escape = _impl::find_json_escape(value, offset);
+		output->append(value.substr(offset, escape - offset));
+
+		if (escape == value.size()) {
+			break;
+		}
+
+		const char c = value[escape];
+		output->push_back('\\');
+
+		if (const char short_escape = _impl::short_escape(c); short_escape != '\0') {
+			output->push_back(short_escape);
+		} else {
+			const auto byte = static_cast<std::uint8_t>(c);
+			output->append("u00");
+			output->push_back(_impl::HEX_DIGITS[byte >> 4]);
+			output->push_back(_impl::HEX_DIGITS[byte & 0x0F]);
+		}
+
+		offset = escape + 1;
+	}
+
+	output->push_back('"');
+}
+
+void StatusWriter::integer(std::int64_t value) {
+	std::array<char, 24> digits;
+	char* end = std::to_chars(digits.data(), digits.data() + digits.size(), value).ptr;
+
+	output->append(digits.data(), end);
+}
+
+void StatusWriter::json(std::string_view value) {
+	_impl::JsonScanner scanner{value.data(), value.data() + value.size()};
+
+	if (!value.empty() && scanner.skip_value() && scanner.at_end()) {
+		_impl::append_minified(*output, value);
+	} else {
+		string(value);
+	}
+}
+
+void StatusWriter::version(std::string_view name, McServer::response_int_t protocol) {
+	if (!fields.contains(StatusField::version)) {
+		return;
+	}
+
+	key("version");
+	output->append(R"({"name":)");
+	string(name);
+	output->append(R"(,"protocol":)");
+	integer(protocol);
+	output->push_back('}');
+}
+
+template <typename Player>
+void StatusWriter::players(McServer::response_int_t max, McServer::response_int_t online,
+                           const std::optional<std::vector<Player>>& sample) {
+	const bool with_counts = fields.contains(StatusField::players);
+	const bool with_sample = fields.contains(StatusField::sample) && sample;
+	if (!with_counts && !with_sample) {
+		return;
+	}
+
+	key("players");
+	output->push_back('{');
+
+	if (with_counts) {
+		output->append(R"("max":)");
+		integer(max);
+		output->append(R"(,"online":)");
+		integer(online);
+	}
+
+	if (with_sample) {
+		output->append(with_counts ? R"(,"sample":[)" : R"("sample":[)");
+
+		for (std::size_t i = 0; i < sample->size(); ++i) {
+			output->append((i == 0) ? R"({"name":)" : R"(,{"name":)");
+			string((*sample)[i].name);
+			output->append(R"(,"id":)");
+			_impl::append_uuid(*output, (*sample)[i].id);
+			output->push_back('}');
+		}
+
+		output->push_back(']');
+	}
+
+	output->push_back('}');
+}
+
+void StatusWriter::rest(std::optional<bool> enforces_secure_chat, std::optional<std::string_view> icon,
+                        std::optional<std::string_view> forge_data, McServer::latency_t latency) {
+	if (fields.contains(StatusField::enforces_secure_chat) && enforces_secure_chat) {
+		key("enforcesSecureChat");
+		output->append(*enforces_secure_chat ? "true" : "false");
+	}
+
+	if (fields.contains(StatusField::icon) && icon) {
+		key("favicon");
+		string(*icon);
+	}
+
+	if (fields.contains(StatusField::forge_data) && forge_data) {
+		key("forgeData");
+		json(*forge_data);
+	}
+
+	if (fields.contains(StatusField::latency)) {
+		key("latency_us");
+		integer(std::chrono::duration_cast<std::chrono::microseconds>(latency).count());
+	}
+}
+
+void StatusWriter::write(std::string_view endpoint, const JavaServer::JavaServerResponse& status) {
+	begin(endpoint);
+	version(status.version->name, status.version->protocol);
+	players(status.players->max, status.players->online, status.players->sample);
+
+	if (fields.contains(StatusField::description)) {
+		key("description");
+		// Chat components have been serialized back into JSON, plain descriptions are just the text
+		if (status.motd.starts_with('{') || status.motd.starts_with('[')) {
+			json(status.motd);
+		} else {
+			string(status.motd);
+		}
+	}
+
+	rest(status.enforces_secure_chat, status.icon, status.forge_data, status.latency);
+	end();
+}
+
+void StatusWriter::write(std::string_view endpoint, const JavaStatusView& status) {
+	begin(endpoint);
+	version(status.version_name, status.protocol);
+	players(status.max, status.online, status.sample);
+
+	if (fields.contains(StatusField::description) && status.description) {
+		key("description");
+		json(*status.description);
+	}
+
+	rest(status.enforces_secure_chat, status.icon, status.forge_data, status.latency);
+	end();
+}
+
+void StatusWriter::write(std::string_view endpoint, McError error) {
+	begin(endpoint);
+	key("error");
+	string(to_string(error));
+	end();
+}
+
+}  // namespace libmcstatus
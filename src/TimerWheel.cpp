@@ -0,0 +1,84 @@
+#include "libmcstatus/impl/TimerWheel.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace libmcstatus::_impl {
+
+void TimerWheel::schedule(tick_t due, Timer timer) {
+	insert({.due = std::clamp(due, current + 1, current + MAX_DELAY), .timer = timer});
+	++count;
+}
+
+void TimerWheel::insert(Entry entry) {
+	const tick_t delay = entry.due - current;
+	std::size_t level = 0;
+
+	while ((level + 1 < LEVELS) && (delay >= (tick_t{1} << (SLOT_BITS * (level + 1))))) {
+		++level;
+	}
+
+	wheels[level][(entry.due >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(entry);
+}
+
+void TimerWheel::cascade(std::size_t level) {
+	const std::size_t slot = (current >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+	// Everything in it is due within the span of the levels below now, so it all moves down
+	std::vector<Entry> entries = std::move(wheels[level][slot]);
+	wheels[level][slot].clear();
+
+	for (const Entry& entry : entries) {
+		insert(entry);
+	}
+}
+
+void TimerWheel::advance(tick_t now, std::vector<Timer>& expired) {
+	while (current < now) {
+		// Nothing happens on the ticks in between, so they're skipped
+		const std::optional<tick_t> next = next_tick();
+		if (!next || (*next > now)) {
+			current = now;
+			break;
+		}
+		current = *next;
+
+		for (std::size_t level = 1; level < LEVELS; ++level) {
+			if ((current & ((tick_t{1} << (SLOT_BITS * level)) - 1)) != 0) {
+				break;
+			}
+			cascade(level);
+		}
+
+		std::vector<Entry>& slot = wheels[0][current & (SLOTS - 1)];
+		for (const Entry& entry : slot) {
+			expired.push_back(entry.timer);
+		}
+		count -= slot.size();
+		slot.clear();
+	}
+}
+
+std::optional<TimerWheel::tick_t> TimerWheel::next_tick() const {
+	if (count == 0) {
+		return std::nullopt;
+	}
+
+	// The first tick at which each level reaches a slot with timers in it
+	std::optional<tick_t> next;
+	for (std::size_t level = 0; level < LEVELS; ++level) {
+		const std::size_t shift = SLOT_BITS * level;
+		const tick_t position = current >> shift;
+
+		for (tick_t step = 1; step <= SLOTS; ++step) {
+			if (!wheels[level][(position + step) & (SLOTS - 1)].empty()) {
+				next = std::min(next.value_or(~tick_t{0}), (position + step) << shift);
+				break;
+			}
+		}
+	}
+
+	return next;
+}
+
+}  // namespace libmcstatus::_impl
@@ -0,0 +1,260 @@
+#include "libmcstatus/TrafficLog.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "libmcstatus/JavaServer.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+namespace asio = boost::asio;
+
+class RecordingConnection : public Transport::Connection {
+private:
+	std::unique_ptr<Transport::Connection> connection;
+	std::shared_ptr<TrafficLog> log;
+	TrafficRecord record{};
+
+public:
+	RecordingConnection(std::unique_ptr<Transport::Connection> connection, std::shared_ptr<TrafficLog> log,
+	                    std::string endpoint)
+	    : connection{std::move(connection)}, log{std::move(log)} {
+		record.time = std::chrono::system_clock::now();
+		record.endpoint = std::move(endpoint);
+	}
+
+	// Connections are done once they are destroyed, and only then the record is complete
+	~RecordingConnection() override {
+		if (!record.sent.empty() || !record.received.empty()) {
+			log->append(record);  // Failures show up in TrafficLog::flush()
+		}
+	}
+
+	asio::awaitable<std::expected<void, McError>> async_connect() override {
+		co_return co_await connection->async_connect();
+	}
+
+	asio::awaitable<std::expected<std::size_t, McError>> async_read_some(asio::mutable_buffer buffer) override {
+		const std::expected<std::size_t, McError> read = co_await connection->async_read_some(buffer);
+
+		if (read) {
+			const auto* data = static_cast<const std::uint8_t*>(buffer.data());
+			record.received.insert(record.received.end(), data, data + *read);
+		}
+
+		co_return read;
+	}
+
+	asio::awaitable<std::expected<void, McError>> async_write(asio::const_buffer buffer) override {
+		const std::expected<void, McError> written = co_await connection->async_write(buffer);
+
+		if (written) {
+			const auto* data = static_cast<const std::uint8_t*>(buffer.data());
+			record.sent.insert(record.sent.end(), data, data + buffer.size());
+		}
+
+		co_return written;
+	}
+
+	void close() override {
+		connection->close();
+	}
+};
+
+class ReplayConnection : public Transport::Connection {
+private:
+	// Keeps the records alive, even if the transport is gone
+	std::shared_ptr<const std::vector<TrafficRecord>> records;
+	const TrafficRecord* record;
+	std::size_t read_offset{0};
+	bool closed{false};
+
+public:
+	ReplayConnection(std::shared_ptr<const std::vector<TrafficRecord>> records, const TrafficRecord* record)
+	    : records{std::move(records)}, record{record} {}
+
+	asio::awaitable<std::expected<void, McError>> async_connect() override {
+		if (record == nullptr) {
+			co_return std::unexpected{McError::connection_refused};  // Nothing to replay
+		}
+
+		co_return std::expected<void, McError>{};
+	}
+
+	asio::awaitable<std::expected<std::size_t, McError>> async_read_some(asio::mutable_buffer buffer) override {
+		if (closed || (record == nullptr) || (read_offset == record->received.size())) {
+			co_return std::unexpected{McError::connection_reset};  // Like reading EOF from a socket
+		}
+
+		const std::size_t read = std::min(buffer.size(), record->received.size() - read_offset);
+		std::copy_n(record->received.begin() + static_cast<std::ptrdiff_t>(read_offset), read,
+		            static_cast<std::uint8_t*>(buffer.data()));
+		read_offset += read;
+
+		co_return read;
+	}
+
+	asio::awaitable<std::expected<void, McError>> async_write(asio::const_buffer) override {
+		if (closed || (record == nullptr)) {
+			co_return std::unexpected{McError::connection_reset};
+		}
+
+		co_return std::expected<void, McError>{};
+	}
+
+	void close() override {
+		closed = true;
+	}
+};
+
+}  // namespace _impl
+
+TrafficLog::TrafficLog(const std::filesystem::path& path) {
+	std::error_code ignored;
+	const bool empty = !std::filesystem::exists(path, ignored) || (std::filesystem::file_size(path, ignored) == 0);
+
+	file.open(path, std::ios::binary | std::ios::app);
+	if (!file) {
+		throw std::runtime_error{"Failed to open traffic log \"" + path.string() + "\""};
+	}
+
+	if (empty) {
+		file.write(MAGIC.data(), static_cast<std::streamsize>(MAGIC.size()));
+	}
+}
+
+bool TrafficLog::append(const TrafficRecord& record) {
+	const RecordHeader header{
+	    .time = std::chrono::duration_cast<std::chrono::microseconds>(record.time.time_since_epoch()).count(),
+	    .endpoint_size = record.endpoint.size(),
+	    .sent_size = record.sent.size(),
+	    .received_size = record.received.size()};
+
+	const std::lock_guard lock{mutex};
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(record.endpoint.data(), static_cast<std::streamsize>(record.endpoint.size()));
+	file.write(reinterpret_cast<const char*>(record.sent.data()), static_cast<std::streamsize>(record.sent.size()));
+	file.write(reinterpret_cast<const char*>(record.received.data()),
+	           static_cast<std::streamsize>(record.received.size()));
+
+	return file.good();
+}
+
+void TrafficLog::flush() {
+	const std::lock_guard lock{mutex};
+	file.flush();
+
+	if (!file) {
+		throw std::system_error{std::make_error_code(std::errc::io_error), "Failed to write traffic log"};
+	}
+}
+
+auto TrafficLog::try_for_each(const std::filesystem::path& path,
+                              const std::function<void(TrafficRecord&& record)>& function)
+    -> std::expected<std::size_t, McError> {
+	std::error_code error;
+	std::uintmax_t remaining = std::filesystem::file_size(path, error);
+	std::ifstream file{path, std::ios::binary};
+	std::array<char, MAGIC.size()> magic{};
+
+	if (error || (remaining < MAGIC.size()) || !file.read(magic.data(), magic.size()) ||
+	    (std::string_view{magic.data(), magic.size()} != MAGIC)) {
+		return std::unexpected{McError::bad_frame};
+	}
+	remaining -= MAGIC.size();
+
+	std::size_t count = 0;
+
+	while (remaining > 0) {
+		RecordHeader header;
+		if ((remaining < sizeof(header)) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+			return std::unexpected{McError::bad_frame};  // A truncated record can only be the result of a crash
+		}
+		remaining -= sizeof(header);
+
+		// Checked one by one, so that the sizes can't overflow. Corrupt sizes never get allocated either
+		if ((header.endpoint_size > remaining) || (header.sent_size > (remaining - header.endpoint_size)) ||
+		    (header.received_size > (remaining - header.endpoint_size - header.sent_size))) {
+			return std::unexpected{McError::bad_frame};
+		}
+		remaining -= header.endpoint_size + header.sent_size + header.received_size;
+
+		TrafficRecord record{.time = std::chrono::system_clock::time_point{std::chrono::microseconds{header.time}},
+		                     .endpoint = std::string(header.endpoint_size, '\0'),
+		                     .sent = McPacket::buffer_t(header.sent_size),
+		                     .received = McPacket::buffer_t(header.received_size)};
+
+		if (!file.read(record.endpoint.data(), static_cast<std::streamsize>(header.endpoint_size)) ||
+		    !file.read(reinterpret_cast<char*>(record.sent.data()), static_cast<std::streamsize>(header.sent_size)) ||
+		    !file.read(reinterpret_cast<char*>(record.received.data()),
+		               static_cast<std::streamsize>(header.received_size))) {
+			return std::unexpected{McError::bad_frame};
+		}
+
+		function(std::move(record));
+		++count;
+	}
+
+	return count;
+}
+
+auto TrafficLog::try_read(const std::filesystem::path& path) -> std::expected<std::vector<TrafficRecord>, McError> {
+	std::vector<TrafficRecord> records;
+	const std::expected<std::size_t, McError> count =
+	    try_for_each(path, [&](TrafficRecord&& record) { records.push_back(std::move(record)); });
+
+	if (!count) {
+		return std::unexpected{count.error()};
+	}
+
+	return records;
+}
+
+RecordingTransport::RecordingTransport(std::shared_ptr<const Transport> transport, std::shared_ptr<TrafficLog> log)
+    : transport{std::move(transport)}, log{std::move(log)} {}
+
+auto RecordingTransport::connection(const boost::asio::any_io_executor& executor) const -> std::unique_ptr<Connection> {
+	return std::make_unique<_impl::RecordingConnection>(transport->connection(executor), log, transport->to_string());
+}
+
+std::string RecordingTransport::host() const {
+	return transport->host();
+}
+
+boost::asio::ip::port_type RecordingTransport::port() const {
+	return transport->port();
+}
+
+std::string RecordingTransport::to_string() const {
+	return transport->to_string();
+}
+
+ReplayTransport::ReplayTransport(std::vector<TrafficRecord> records)
+    : records{std::make_shared<const std::vector<TrafficRecord>>(std::move(records))} {}
+
+auto ReplayTransport::connection(const boost::asio::any_io_executor&) const -> std::unique_ptr<Connection> {
+	const TrafficRecord* record =
+	    records->empty() ? nullptr : &(*records)[next.fetch_add(1, std::memory_order_relaxed) % records->size()];
+
+	return std::make_unique<_impl::ReplayConnection>(records, record);
+}
+
+std::string ReplayTransport::host() const {
+	return "localhost";
+}
+
+boost::asio::ip::port_type ReplayTransport::port() const {
+	return JavaServer::DEFAULT_PORT;
+}
+
+std::string ReplayTransport::to_string() const {
+	return "replay";
+}
+
+}  // namespace libmcstatus
@@ -0,0 +1,245 @@
+#include "libmcstatus/Transport.hpp"
+
+#include <algorithm>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "libmcstatus/JavaServer.hpp"
+
+namespace libmcstatus {
+
+namespace _impl {
+
+namespace asio = boost::asio;
+
+// Connection over any stream socket of Boost.Asio
+template <typename Protocol>
+class SocketConnection : public Transport::Connection {
+private:
+	typename Protocol::socket socket;
+	typename Protocol::endpoint endpoint;
+
+public:
+	SocketConnection(const asio::any_io_executor& executor, typename Protocol::endpoint endpoint)
+	    : socket{executor}, endpoint{std::move(endpoint)} {}
+
+	asio::awaitable<std::expected<void, McError>> async_connect() override {
+		boost::system::error_code error_code;
+		co_await socket.async_connect(endpoint, asio::redirect_error(asio::use_awaitable, error_code));
+
+		if (error_code) {
+			co_return std::unexpected{classify_error(error_code)};
+		}
+
+		co_return std::expected<void, McError>{};
+	}
+
+	asio::awaitable<std::expected<std::size_t, McError>> async_read_some(asio::mutable_buffer buffer) override {
+		boost::system::error_code error_code;
+		const std::size_t read =
+		    co_await socket.async_read_some(buffer, asio::redirect_error(asio::use_awaitable, error_code));
+
+		if (error_code) {
+			co_return std::unexpected{classify_error(error_code)};
+		}
+
+		co_return read;
+	}
+
+	asio::awaitable<std::expected<void, McError>> async_write(asio::const_buffer buffer) override {
+		boost::system::error_code error_code;
+		co_await asio::async_write(socket, buffer, asio::redirect_error(asio::use_awaitable, error_code));
+
+		if (error_code) {
+			co_return std::unexpected{classify_error(error_code)};
+		}
+
+		co_return std::expected<void, McError>{};
+	}
+
+	void close() override {
+		boost::system::error_code ignored;
+		socket.close(ignored);
+	}
+};
+
+// One direction of an in-memory pipe. The timer never expires on its own, it is cancelled to wake up a waiting reader
+struct MemoryChannel {
+	explicit MemoryChannel(const asio::any_io_executor& executor)
+	    : readable{executor, asio::steady_timer::time_point::max()} {}
+
+	std::vector<std::uint8_t> data{};
+	std::size_t read_offset{0};
+	asio::steady_timer readable;
+};
+
+struct MemoryPipe {
+	explicit MemoryPipe(const asio::any_io_executor& executor) : to_server{executor}, to_client{executor} {}
+
+	MemoryChannel to_server;
+	MemoryChannel to_client;
+	bool closed{false};
+
+	void close() {
+		closed = true;
+		to_server.readable.cancel();
+		to_client.readable.cancel();
+	}
+};
+
+class MemoryConnection : public Transport::Connection {
+private:
+	asio::any_io_executor executor;
+	std::shared_ptr<MemoryPipe> pipe{};
+	bool server_end;
+	const MemoryTransport::handler_t* handler;
+
+	MemoryChannel& input() {
+		return server_end ? pipe->to_server : pipe->to_client;
+	}
+	MemoryChannel& output() {
+		return server_end ? pipe->to_client : pipe->to_server;
+	}
+
+public:
+	// The client end, which creates the pipe on connect
+	MemoryConnection(asio::any_io_executor executor, const MemoryTransport::handler_t& handler)
+	    : executor{std::move(executor)}, server_end{false}, handler{&handler} {}
+	// The server end of an existing pipe
+	MemoryConnection(asio::any_io_executor executor, std::shared_ptr<MemoryPipe> pipe)
+	    : executor{std::move(executor)}, pipe{std::move(pipe)}, server_end{true}, handler{nullptr} {}
+
+	~MemoryConnection() override {
+		close();
+	}
+
+	asio::awaitable<std::expected<void, McError>> async_connect() override {
+		if (pipe) {
+			co_return std::unexpected{McError::network_error};  // Already connected
+		}
+
+		pipe = std::make_shared<MemoryPipe>(executor);
+		asio::co_spawn(executor, (*handler)(std::make_shared<MemoryConnection>(executor, pipe)), asio::detached);
+
+		co_return std::expected<void, McError>{};
+	}
+
+	asio::awaitable<std::expected<std::size_t, McError>> async_read_some(asio::mutable_buffer buffer) override {
+		// Keeps the pipe alive while suspended, even if this end is destroyed in the meantime
+		const std::shared_ptr<MemoryPipe> keep_alive = pipe;
+		if (!keep_alive) {
+			co_return std::unexpected{McError::network_error};
+		}
+
+		MemoryChannel& channel = input();
+
+		while ((channel.read_offset == channel.data.size()) && !keep_alive->closed) {
+			boost::system::error_code ignored;
+			co_await channel.readable.async_wait(asio::redirect_error(asio::use_awaitable, ignored));
+			channel.readable.expires_at(asio::steady_timer::time_point::max());
+		}
+
+		if (channel.read_offset == channel.data.size()) {
+			co_return std::unexpected{McError::connection_reset};  // Like reading EOF from a socket
+		}
+
+		const std::size_t read = std::min(buffer.size(), channel.data.size() - channel.read_offset);
+		std::copy_n(channel.data.begin() + static_cast<std::ptrdiff_t>(channel.read_offset), read,
+		            static_cast<std::uint8_t*>(buffer.data()));
+		channel.read_offset += read;
+
+		if (channel.read_offset == channel.data.size()) {
+			channel.data.clear();
+			channel.read_offset = 0;
+		}
+
+		co_return read;
+	}
+
+	asio::awaitable<std::expected<void, McError>> async_write(asio::const_buffer buffer) override {
+		if (!pipe || pipe->closed) {
+			co_return std::unexpected{McError::connection_reset};
+		}
+
+		MemoryChannel& channel = output();
+		const auto* data = static_cast<const std::uint8_t*>(buffer.data());
+
+		channel.data.insert(channel.data.end(), data, data + buffer.size());
+		channel.readable.cancel();
+
+		co_return std::expected<void, McError>{};
+	}
+
+	void close() override {
+		if (pipe) {
+			pipe->close();
+		}
+	}
+};
+
+}  // namespace _impl
+
+TcpTransport::TcpTransport(boost::asio::ip::tcp::endpoint server_address) : server_address{std::move(server_address)} {}
+
+auto TcpTransport::connection(const boost::asio::any_io_executor& executor) const -> std::unique_ptr<Connection> {
+	return std::make_unique<_impl::SocketConnection<boost::asio::ip::tcp>>(executor, server_address);
+}
+
+std::string TcpTransport::host() const {
+	return server_address.address().to_string();
+}
+
+boost::asio::ip::port_type TcpTransport::port() const {
+	return server_address.port();
+}
+
+std::string TcpTransport::to_string() const {
+	return server_address.address().to_string() + ":" + std::to_string(server_address.port());
+}
+
+UnixTransport::UnixTransport(std::string path) : path{std::move(path)} {}
+
+auto UnixTransport::connection(const boost::asio::any_io_executor& executor) const -> std::unique_ptr<Connection> {
+	return std::make_unique<_impl::SocketConnection<boost::asio::local::stream_protocol>>(executor, path);
+}
+
+// There is no meaningful address to announce, so act like a local server on the default port
+std::string UnixTransport::host() const {
+	return "localhost";
+}
+
+boost::asio::ip::port_type UnixTransport::port() const {
+	return JavaServer::DEFAULT_PORT;
+}
+
+std::string UnixTransport::to_string() const {
+	return "unix:" + path;
+}
+
+MemoryTransport::MemoryTransport(handler_t handler) : handler{std::move(handler)} {}
+
+auto MemoryTransport::connection(const boost::asio::any_io_executor& executor) const -> std::unique_ptr<Connection> {
+	return std::make_unique<_impl::MemoryConnection>(executor, handler);
+}
+
+std::string MemoryTransport::host() const {
+	return "localhost";
+}
+
+boost::asio::ip::port_type MemoryTransport::port() const {
+	return JavaServer::DEFAULT_PORT;
+}
+
+std::string MemoryTransport::to_string() const {
+	return "memory";
+}
+
+}  // namespace libmcstatus
@@ -1,6 +1,15 @@
 #include "libmcstatus/impl/Utils.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <charconv>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace libmcstatus::_impl {
 
@@ -12,4 +21,228 @@ boost::asio::ip::port_type parse_port(std::string_view port_str) {
 	return (ec == std::errc()) ? port_value : 0;
 }
 
+namespace {
+
+// Value of every hex digit, 0xFF for anything else
+constexpr std::array<std::uint8_t, 256> HEX_VALUES = [] {
+	std::array<std::uint8_t, 256> values{};
+	values.fill(0xFF);
+
+	for (std::uint8_t digit = 0; digit < 10; ++digit) {
+		values['0' + digit] = digit;
+	}
+	for (std::uint8_t digit = 0; digit < 6; ++digit) {
+		values['a' + digit] = 10 + digit;
+		values['A' + digit] = 10 + digit;
+	}
+
+	return values;
+}();
+
+#if defined(__SSE2__)
+// Turns 16 hex digits into their values, and sets valid to false if any of them isn't one
+__m128i hex_values_sse2(__m128i digits, bool& valid) {
+	const __m128i lower = _mm_or_si128(digits, _mm_set1_epi8(0x20));
+
+	// Signed comparisons, which also rule out anything outside of ASCII
+	const __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(digits, _mm_set1_epi8('0' - 1)),
+	                                       _mm_cmplt_epi8(digits, _mm_set1_epi8('9' + 1)));
+	const __m128i is_letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+	                                        _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+
+	valid = valid && (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) == 0xFFFF);
+
+	return _mm_or_si128(_mm_and_si128(is_digit, _mm_sub_epi8(digits, _mm_set1_epi8('0'))),
+	                    _mm_and_si128(is_letter, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+}
+
+// Every pair of values (high nibble first) becomes one byte in the low half of its 16 bit lane
+__m128i pack_nibbles_sse2(__m128i values) {
+	return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x00FF)), 4), _mm_srli_epi16(values, 8));
+}
+#endif
+
+}  // namespace
+
+bool decode_hex_scalar(const char* digits, std::uint8_t* bytes) {
+	std::uint8_t invalid = 0;
+
+	for (std::size_t i = 0; i < 16; ++i) {
+		const std::uint8_t high = HEX_VALUES[static_cast<unsigned char>(digits[2 * i])];
+		const std::uint8_t low = HEX_VALUES[static_cast<unsigned char>(digits[(2 * i) + 1])];
+
+		// Invalid digits have the high bit set, checked once at the end instead of branching for every digit
+		invalid |= high | low;
+		bytes[i] = static_cast<std::uint8_t>((high << 4) | (low & 0x0F));
+	}
+
+	return (invalid & 0x80) == 0;
+}
+
+bool decode_hex(const char* digits, std::uint8_t* bytes) {
+#if defined(__SSE2__)
+	bool valid = true;
+	const __m128i first = hex_values_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)), valid);
+	const __m128i second = hex_values_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits + 16)), valid);
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(bytes),
+	                 _mm_packus_epi16(pack_nibbles_sse2(first), pack_nibbles_sse2(second)));
+	return valid;
+#else
+	return decode_hex_scalar(digits, bytes);
+#endif
+}
+
+std::optional<boost::uuids::uuid> parse_uuid(std::string_view uuid_str) {
+	char digits[32];
+
+	if (uuid_str.size() == 36) {
+		if ((uuid_str[8] != '-') || (uuid_str[13] != '-') || (uuid_str[18] != '-') || (uuid_str[23] != '-')) {
+			return std::nullopt;
+		}
+
+		// Drop the dashes of the 8-4-4-4-12 groups
+		std::memcpy(digits, uuid_str.data(), 8);
+		std::memcpy(digits + 8, uuid_str.data() + 9, 4);
+		std::memcpy(digits + 12, uuid_str.data() + 14, 4);
+		std::memcpy(digits + 16, uuid_str.data() + 19, 4);
+		std::memcpy(digits + 20, uuid_str.data() + 24, 12);
+	} else if (uuid_str.size() == 32) {
+		std::memcpy(digits, uuid_str.data(), 32);
+	} else {
+		return std::nullopt;
+	}
+
+	boost::uuids::uuid uuid;
+	if (!decode_hex(digits, uuid.data)) {
+		return std::nullopt;
+	}
+
+	return uuid;
+}
+
+std::uint64_t hash_bytes(std::string_view data, std::uint64_t seed) {
+	static constexpr std::uint64_t MULTIPLIER{0x9E3779B97F4A7C15};
+	static constexpr std::uint64_t FINAL_MULTIPLIER{0xD6E8FEB86659FD93};
+
+	const auto absorb = [](std::uint64_t hash, std::uint64_t word) {
+		hash = (hash ^ word) * MULTIPLIER;
+		return hash ^ (hash >> 29);
+	};
+
+	std::uint64_t hash = seed ^ (data.size() * MULTIPLIER);
+	std::size_t offset = 0;
+
+	for (; (offset + sizeof(std::uint64_t)) <= data.size(); offset += sizeof(std::uint64_t)) {
+		std::uint64_t word;
+		std::memcpy(&word, data.data() + offset, sizeof(word));
+		hash = absorb(hash, word);
+	}
+
+	if (offset != data.size()) {
+		std::uint64_t word = 0;
+		std::memcpy(&word, data.data() + offset, data.size() - offset);
+		hash = absorb(hash, word);
+	}
+
+	hash ^= hash >> 32;
+	hash *= FINAL_MULTIPLIER;
+	return hash ^ (hash >> 32);
+}
+
+std::size_t find_section_sign_scalar(std::string_view text, std::size_t from) {
+	const std::size_t found = text.find("\xC2\xA7", from);
+
+	return (found != std::string_view::npos) ? found : text.size();
+}
+
+std::size_t find_section_sign(std::string_view text, std::size_t from) {
+#if defined(__SSE2__)
+	const __m128i lead = _mm_set1_epi8(static_cast<char>(0xC2));
+	const __m128i trail = _mm_set1_epi8(static_cast<char>(0xA7));
+
+	// Compares every byte and the one after it at once, 16 positions per step
+	for (; (from + 17) <= text.size(); from += 16) {
+		const __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + from));
+		const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + from + 1));
+		const auto matches = static_cast<unsigned int>(
+		    _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, lead), _mm_cmpeq_epi8(second, trail))));
+
+		if (matches != 0) {
+			return from + static_cast<std::size_t>(std::countr_zero(matches));
+		}
+	}
+#endif
+
+	return find_section_sign_scalar(text, from);
+}
+
+std::size_t find_json_escape_scalar(std::string_view text, std::size_t from) {
+	for (; from < text.size(); ++from) {
+		const auto byte = static_cast<std::uint8_t>(text[from]);
+
+		if ((byte < 0x20) || (byte == '"') || (byte == '\\')) {
+			return from;
+		}
+	}
+
+	return text.size();
+}
+
+std::size_t find_json_escape(std::string_view text, std::size_t from) {
+#if defined(__SSE2__)
+	const __m128i quote = _mm_set1_epi8('"');
+	const __m128i backslash = _mm_set1_epi8('\\');
+	const __m128i last_control = _mm_set1_epi8(0x1F);
+
+	for (; (from + 16) <= text.size(); from += 16) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + from));
+		// Unsigned, so UTF-8 sequences don't count as control characters
+		const __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, last_control), chunk);
+		const auto matches = static_cast<unsigned int>(_mm_movemask_epi8(
+		    _mm_or_si128(control, _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)))));
+
+		if (matches != 0) {
+			return from + static_cast<std::size_t>(std::countr_zero(matches));
+		}
+	}
+#endif
+
+	return find_json_escape_scalar(text, from);
+}
+
+std::size_t utf8_length(char lead) {
+	const auto byte = static_cast<std::uint8_t>(lead);
+
+	if (byte >= 0xF0) {
+		return 4;
+	}
+	if (byte >= 0xE0) {
+		return 3;
+	}
+	return (byte >= 0xC0) ? 2 : 1;
+}
+
+std::string strip_formatting_codes(std::string_view text) {
+	std::string stripped;
+	stripped.reserve(text.size());
+
+	for (std::size_t offset = 0; offset < text.size();) {
+		const std::size_t code = find_section_sign(text, offset);
+		stripped.append(text.substr(offset, code - offset));
+
+		if (code == text.size()) {
+			break;
+		}
+
+		// The code itself may be any character, not only a single byte
+		offset = code + 2;
+		if (offset < text.size()) {
+			offset = std::min(offset + utf8_length(text[offset]), text.size());
+		}
+	}
+
+	return stripped;
+}
+
 }  // namespace libmcstatus::_impl
@@ -0,0 +1,100 @@
+#include "libmcstatus/impl/UuidSet.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace libmcstatus::_impl {
+
+namespace {
+
+// At most 3/4 of the slots are used, which keeps probe sequences short
+constexpr std::uint32_t capacity_for(std::size_t expected) {
+	return std::bit_ceil(std::max<std::uint32_t>(8, static_cast<std::uint32_t>(expected + (expected / 3) + 1)));
+}
+
+}  // namespace
+
+std::uint32_t UuidSet::slot_of(const boost::uuids::uuid& id) const {
+	// Player UUIDs are random or MD5 based, so folding them is enough to spread them
+	std::uint64_t high;
+	std::uint64_t low;
+	std::memcpy(&high, id.data, sizeof(high));
+	std::memcpy(&low, id.data + sizeof(high), sizeof(low));
+
+	const std::uint64_t hash = (high ^ std::rotl(low, 29)) * 0x9E3779B97F4A7C15;
+	return static_cast<std::uint32_t>(hash >> 32) & (capacity - 1);
+}
+
+void UuidSet::rehash(std::uint32_t new_capacity) {
+	std::unique_ptr<boost::uuids::uuid[]> old_slots = std::move(slots);
+	const std::uint32_t old_capacity = capacity;
+
+	slots = std::make_unique<boost::uuids::uuid[]>(new_capacity);  // Value initialized, so all nil
+	capacity = new_capacity;
+	count = 0;
+
+	for (std::uint32_t slot = 0; slot < old_capacity; ++slot) {
+		if (!old_slots[slot].is_nil()) {
+			insert(old_slots[slot]);
+		}
+	}
+}
+
+bool UuidSet::insert(const boost::uuids::uuid& id) {
+	if (((count + 1) * 4) > (capacity * 3)) {
+		rehash(capacity_for(count + 1));
+	}
+
+	for (std::uint32_t slot = slot_of(id);; slot = (slot + 1) & (capacity - 1)) {
+		if (slots[slot] == id) {
+			return false;
+		}
+
+		if (slots[slot].is_nil()) {
+			slots[slot] = id;
+			++count;
+			return true;
+		}
+	}
+}
+
+bool UuidSet::contains(const boost::uuids::uuid& id) const {
+	if (count == 0) {
+		return false;
+	}
+
+	for (std::uint32_t slot = slot_of(id);; slot = (slot + 1) & (capacity - 1)) {
+		if (slots[slot] == id) {
+			return true;
+		}
+
+		if (slots[slot].is_nil()) {
+			return false;
+		}
+	}
+}
+
+void UuidSet::clear(std::size_t expected) {
+	count = 0;
+
+	// Empty sets are the most common ones by far, so they don't hold any memory
+	if (expected == 0) {
+		slots.reset();
+		capacity = 0;
+		return;
+	}
+
+	const std::uint32_t needed = capacity_for(expected);
+
+	// Shrink as well, so a set that once held a huge sample doesn't keep its memory forever
+	if ((capacity < needed) || (capacity > (needed * 4))) {
+		slots = std::make_unique<boost::uuids::uuid[]>(needed);
+		capacity = needed;
+		return;
+	}
+
+	std::fill_n(slots.get(), capacity, boost::uuids::uuid{});
+}
+
+}  // namespace libmcstatus::_impl
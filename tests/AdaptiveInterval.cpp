@@ -0,0 +1,89 @@
+#include "libmcstatus/AdaptiveInterval.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr AdaptivePolicy POLICY{.min_interval = 1s, .max_interval = 64s};
+
+}  // namespace
+
+TEST(AdaptiveIntervalTest, ClampsInitialInterval) {
+	EXPECT_EQ(AdaptiveInterval(POLICY, 10ms).interval(), 1s);
+	EXPECT_EQ(AdaptiveInterval(POLICY, 10s).interval(), 10s);
+	EXPECT_EQ(AdaptiveInterval(POLICY, 1h).interval(), 64s);
+}
+
+TEST(AdaptiveIntervalTest, UnchangedServersSlowDown) {
+	AdaptiveInterval interval{POLICY, 4s};
+
+	interval.success(false);
+	EXPECT_GT(interval.interval(), 4s);
+
+	for (int i = 0; i < 20; ++i) {
+		interval.success(false);
+	}
+	EXPECT_EQ(interval.interval(), 64s);
+	EXPECT_LT(interval.change_rate(), 0.05);
+}
+
+TEST(AdaptiveIntervalTest, BusyServersSpeedUp) {
+	AdaptiveInterval interval{POLICY, 32s};
+
+	interval.success(true);
+	EXPECT_LT(interval.interval(), 32s);
+	// Never more than max_step at once
+	EXPECT_GE(interval.interval(), 16s);
+
+	for (int i = 0; i < 20; ++i) {
+		interval.success(true);
+	}
+	EXPECT_EQ(interval.interval(), 1s);
+}
+
+TEST(AdaptiveIntervalTest, SettlesAtTargetRate) {
+	AdaptiveInterval interval{POLICY, 8s};
+
+	// Half the polls see a change, which is just what the default policy aims for
+	for (int i = 0; i < 50; ++i) {
+		interval.success(i % 2 == 0);
+	}
+
+	EXPECT_GE(interval.interval(), 2s);
+	EXPECT_LE(interval.interval(), 32s);
+	EXPECT_NEAR(interval.change_rate(), 0.5, 0.15);
+}
+
+TEST(AdaptiveIntervalTest, UnknownChangeKeepsInterval) {
+	AdaptiveInterval interval{POLICY, 8s};
+
+	interval.success(std::nullopt);
+
+	EXPECT_EQ(interval.interval(), 8s);
+	EXPECT_DOUBLE_EQ(interval.change_rate(), POLICY.target_change_rate);
+}
+
+TEST(AdaptiveIntervalTest, ErrorsBackOff) {
+	AdaptiveInterval interval{POLICY, 4s};
+
+	interval.failure();
+	EXPECT_EQ(interval.next(), 8s);
+	interval.failure();
+	EXPECT_EQ(interval.next(), 16s);
+	EXPECT_EQ(interval.interval(), 4s);
+
+	for (int i = 0; i < 2000; ++i) {
+		interval.failure();
+	}
+	EXPECT_EQ(interval.next(), 64s);
+	EXPECT_EQ(interval.failures(), 2002u);
+
+	interval.success(std::nullopt);
+	EXPECT_EQ(interval.next(), 4s);
+	EXPECT_EQ(interval.failures(), 0u);
+}
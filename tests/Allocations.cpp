@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/JavaStatusView.hpp"
+#include "libmcstatus/McPacket.hpp"
+#include "StubServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+// The sanitizers bring their own operator new, which must not be replaced
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define LIBMCSTATUS_COUNT_ALLOCATIONS 0
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define LIBMCSTATUS_COUNT_ALLOCATIONS 0
+#endif
+#endif
+#ifndef LIBMCSTATUS_COUNT_ALLOCATIONS
+#define LIBMCSTATUS_COUNT_ALLOCATIONS 1
+#endif
+
+namespace {
+
+// Only allocations of the thread that is counting are recorded, so the stub server's thread doesn't interfere. The
+// blocking API runs the whole query on the calling thread
+thread_local bool counting = false;
+thread_local std::size_t allocations = 0;
+
+class AllocationCounter {
+public:
+	AllocationCounter() {
+		allocations = 0;
+		counting = true;
+	}
+	~AllocationCounter() {
+		counting = false;
+	}
+
+	AllocationCounter(const AllocationCounter&) = delete;
+	AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+	[[nodiscard]] std::size_t count() const {
+		return allocations;
+	}
+};
+
+// Allocation budgets per API, for one call after a warm-up call (so one-time allocations like thread-local
+// generators, metrics shards or DNS resolver state don't count). They leave some headroom for differences between
+// Boost versions. Raise them only together with a good reason
+//
+// ping(): ~50, most of them for the per-call io_context (its services and reactor), the socket, timers and coroutine
+// frames of the attempt engine, plus one packet buffer per write and read
+constexpr std::size_t PING_BUDGET{56};
+// status(): everything ping() needs, plus the JSON document, the response with its players and version objects and
+// the copied strings
+constexpr std::size_t STATUS_BUDGET{76};
+// status_view(): ~50, everything ping() needs plus the frame that the view keeps. No JSON document and no copied
+// strings
+constexpr std::size_t STATUS_VIEW_BUDGET{57};
+// JavaStatusView::try_parse(): nothing at all for a status without player sample, as the view takes over the buffer
+constexpr std::size_t PARSE_STATUS_VIEW_BUDGET{0};
+// write_to_buffer(): exactly the returned buffer
+constexpr std::size_t WRITE_TO_BUFFER_BUDGET{1};
+// read_utf(): exactly the returned string (none for strings short enough for the small string optimization)
+constexpr std::size_t READ_UTF_BUDGET{1};
+
+}  // namespace
+
+#if LIBMCSTATUS_COUNT_ALLOCATIONS
+void* operator new(std::size_t size) {
+	if (counting) {
+		++allocations;
+	}
+
+	if (void* pointer = std::malloc((size != 0) ? size : 1)) {
+		return pointer;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+	if (counting) {
+		++allocations;
+	}
+
+	const auto align = static_cast<std::size_t>(alignment);
+	if (void* pointer = std::aligned_alloc(align, ((size + align - 1) / align) * align)) {
+		return pointer;
+	}
+
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept {
+	std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+	std::free(pointer);
+}
+#endif
+
+class AllocationTest : public testing::Test {
+protected:
+	void SetUp() override {
+		if (!LIBMCSTATUS_COUNT_ALLOCATIONS) {
+			GTEST_SKIP() << "Allocations can't be counted in sanitizer builds";
+		}
+	}
+};
+
+TEST_F(AllocationTest, Status) {
+	StubServer stub;
+	const JavaServer server{stub.endpoint()};
+	const RetryPolicy policy{.max_attempts = 1};
+	std::ignore = server.status(1s, policy);
+
+	std::size_t count;
+	{
+		const AllocationCounter counter;
+		std::ignore = server.status(1s, policy);
+		count = counter.count();
+	}
+
+	RecordProperty("allocations", static_cast<int>(count));
+	EXPECT_LE(count, STATUS_BUDGET);
+}
+
+TEST_F(AllocationTest, StatusView) {
+	StubServer stub;
+	const JavaServer server{stub.endpoint()};
+	const RetryPolicy policy{.max_attempts = 1};
+	std::ignore = server.status_view(1s, policy);
+
+	std::size_t count;
+	{
+		const AllocationCounter counter;
+		std::ignore = server.status_view(1s, policy);
+		count = counter.count();
+	}
+
+	RecordProperty("allocations", static_cast<int>(count));
+	EXPECT_LE(count, STATUS_VIEW_BUDGET);
+}
+
+TEST_F(AllocationTest, ParseStatusView) {
+	McPacket::buffer_t buffer{StubServer::DEFAULT_STATUS.begin(), StubServer::DEFAULT_STATUS.end()};
+
+	std::size_t count;
+	{
+		const AllocationCounter counter;
+		std::ignore = JavaStatusView::try_parse(std::move(buffer), 0, StubServer::DEFAULT_STATUS.size());
+		count = counter.count();
+	}
+
+	EXPECT_LE(count, PARSE_STATUS_VIEW_BUDGET);
+}
+
+TEST_F(AllocationTest, Ping) {
+	StubServer stub;
+	const JavaServer server{stub.endpoint()};
+	const RetryPolicy policy{.max_attempts = 1};
+	std::ignore = server.ping(1s, policy);
+
+	std::size_t count;
+	{
+		const AllocationCounter counter;
+		std::ignore = server.ping(1s, policy);
+		count = counter.count();
+	}
+
+	RecordProperty("allocations", static_cast<int>(count));
+	EXPECT_LE(count, PING_BUDGET);
+}
+
+TEST_F(AllocationTest, WriteToBuffer) {
+	McPacket packet;
+	packet.write_varint(0);
+	packet.write_utf("localhost");
+	packet.write_ushort(25565);
+
+	std::size_t count;
+	{
+		const AllocationCounter counter;
+		std::ignore = packet.write_to_buffer();
+		count = counter.count();
+	}
+
+	EXPECT_LE(count, WRITE_TO_BUFFER_BUDGET);
+}
+
+TEST_F(AllocationTest, ReadUtf) {
+	McPacket packet;
+	packet.write_utf(std::string(1024, 'x'));
+	McPacket reconstructed = McPacket::read_from_buffer(packet.write_to_buffer());
+
+	std::size_t count;
+	{
+		const AllocationCounter counter;
+		std::ignore = reconstructed.read_utf();
+		count = counter.count();
+	}
+
+	EXPECT_LE(count, READ_UTF_BUDGET);
+}
@@ -0,0 +1,112 @@
+#include "libmcstatus/ChangeDetector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+#include "MemoryServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+namespace {
+
+JavaServer::RawStatus raw(std::string_view json) {
+	return JavaServer::RawStatus{.latency = 1ms, .buffer = {json.begin(), json.end()}, .size = json.size()};
+}
+
+std::string status_json(std::string_view online, std::string_view description = "Hello") {
+	return R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":100,"online":)" + std::string{online} +
+	       R"(},"description":{"text":")" + std::string{description} + R"(","online":5}})";
+}
+
+}  // namespace
+
+TEST(ChangeDetectorTest, FirstStatusIsParsed) {
+	ChangeDetector detector;
+
+	const auto update = detector.update("a", raw(status_json("7")));
+
+	ASSERT_TRUE(update.has_value());
+	EXPECT_EQ(update->change, ChangeDetector::Change::changed);
+	EXPECT_EQ(update->status->players->online, 7);
+	EXPECT_EQ(detector.size(), 1u);
+}
+
+TEST(ChangeDetectorTest, SamePayloadIsUnchanged) {
+	ChangeDetector detector;
+	const auto first = detector.update("a", raw(status_json("7")));
+
+	const auto second = detector.update("a", raw(status_json("7")));
+
+	ASSERT_TRUE(second.has_value());
+	EXPECT_EQ(second->change, ChangeDetector::Change::unchanged);
+	EXPECT_EQ(second->status, first->status);
+}
+
+TEST(ChangeDetectorTest, OnlyOnlinePlayersChanged) {
+	ChangeDetector detector;
+	const auto first = detector.update("a", raw(status_json("9")));
+
+	// The number may change its width, and the nested "online" in the description must not be mistaken for it
+	const auto second = detector.update("a", raw(status_json("10")));
+
+	ASSERT_TRUE(second.has_value());
+	EXPECT_EQ(second->change, ChangeDetector::Change::online_only);
+	EXPECT_EQ(second->status->players->online, 10);
+	EXPECT_EQ(second->status->players->max, 100);
+	EXPECT_EQ(second->status->version->name, "1.20.4");
+	EXPECT_EQ(second->status->motd, R"({"text":"Hello","online":5})");
+	EXPECT_EQ(first->status->players->online, 9);  // Handed out statuses never change
+
+	const auto third = detector.update("a", raw(status_json("-1")));
+	ASSERT_TRUE(third.has_value());
+	EXPECT_EQ(third->change, ChangeDetector::Change::online_only);
+	EXPECT_EQ(third->status->players->online, -1);
+}
+
+TEST(ChangeDetectorTest, OtherChangesAreParsed) {
+	ChangeDetector detector;
+	std::ignore = detector.update("a", raw(status_json("7")));
+
+	const auto update = detector.update("a", raw(status_json("8", "Bye")));
+
+	ASSERT_TRUE(update.has_value());
+	EXPECT_EQ(update->change, ChangeDetector::Change::changed);
+	EXPECT_EQ(update->status->players->online, 8);
+	EXPECT_EQ(update->status->motd, R"({"text":"Bye","online":5})");
+
+	// Anything that isn't a number in place of players.online needs a full parse, and fails it
+	const auto invalid = detector.update("a", raw(status_json(R"("8")", "Bye")));
+	ASSERT_FALSE(invalid.has_value());
+	EXPECT_EQ(invalid.error(), McError::bad_json);
+	EXPECT_EQ(detector.size(), 0u);
+}
+
+TEST(ChangeDetectorTest, EndpointsAreIndependent) {
+	ChangeDetector detector;
+	std::ignore = detector.update("a", raw(status_json("7")));
+
+	EXPECT_EQ(detector.update("b", raw(status_json("7")))->change, ChangeDetector::Change::changed);
+	EXPECT_EQ(detector.update("a", raw(status_json("7")))->change, ChangeDetector::Change::unchanged);
+
+	detector.forget("a");
+	EXPECT_EQ(detector.size(), 1u);
+	EXPECT_EQ(detector.update("a", raw(status_json("7")))->change, ChangeDetector::Change::changed);
+}
+
+TEST(ChangeDetectorTest, PollsServers) {
+	ChangeDetector detector;
+	const JavaServer server{memory_server::transport()};
+
+	const auto first = detector.try_poll(server, 1s, RetryPolicy{.max_attempts = 1});
+	const auto second = detector.try_poll(server, 1s, RetryPolicy{.max_attempts = 1});
+
+	ASSERT_TRUE(first.has_value()) << to_string(first.error());
+	ASSERT_TRUE(second.has_value()) << to_string(second.error());
+	EXPECT_EQ(first->change, ChangeDetector::Change::changed);
+	EXPECT_EQ(second->change, ChangeDetector::Change::unchanged);
+	EXPECT_EQ(second->status->players->online, 3);
+}
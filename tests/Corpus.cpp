@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <boost/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/JavaStatusView.hpp"
+
+using namespace libmcstatus;
+
+namespace {
+
+class StatusParser : public JavaServer {
+public:
+	using JavaServer::try_parse_status;
+};
+
+std::string read_payload(const std::string& name) {
+	std::ifstream file{std::filesystem::path{LIBMCSTATUS_CORPUS_DIR} / name, std::ios::binary};
+	return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+std::vector<std::filesystem::path> corpus_payloads() {
+	std::vector<std::filesystem::path> payloads;
+	for (const auto& entry : std::filesystem::directory_iterator{LIBMCSTATUS_CORPUS_DIR}) {
+		if (entry.path().extension() == ".json") {
+			payloads.push_back(entry.path());
+		}
+	}
+
+	return payloads;
+}
+
+// Raw JSON the way try_parse_status() reports it, strings unescaped and everything else serialized
+std::string normalize(std::string_view raw, bool unescape_strings) {
+	const boost::json::value value = boost::json::parse(raw);
+
+	if (const boost::json::string* string = value.if_string(); unescape_strings && (string != nullptr)) {
+		return std::string{*string};
+	}
+
+	return boost::json::serialize(value);
+}
+
+}  // namespace
+
+// Every payload of the benchmark corpus has to stay parseable, otherwise the benchmark measures error paths
+TEST(CorpusTest, EveryPayloadParses) {
+	const std::vector<std::filesystem::path> payloads = corpus_payloads();
+
+	ASSERT_GE(payloads.size(), 10u);
+	for (const std::filesystem::path& payload : payloads) {
+		EXPECT_TRUE(StatusParser::try_parse_status({}, read_payload(payload.filename().string())).has_value())
+		    << payload.filename();
+	}
+}
+
+TEST(CorpusTest, ShapesAreRecognized) {
+	const auto forge = StatusParser::try_parse_status({}, read_payload("forge_1.16.5.json"));
+	ASSERT_TRUE(forge.has_value());
+	EXPECT_TRUE((*forge)->forge_data.has_value());
+
+	const auto modinfo = StatusParser::try_parse_status({}, read_payload("forge_1.12.2_modinfo.json"));
+	ASSERT_TRUE(modinfo.has_value());
+	EXPECT_NE((*modinfo)->forge_data->find("modList"), std::string::npos);
+
+	const auto large_sample = StatusParser::try_parse_status({}, read_payload("large_sample.json"));
+	ASSERT_TRUE(large_sample.has_value());
+	EXPECT_EQ((*large_sample)->players->sample->size(), 600u);
+
+	const auto big_favicon = StatusParser::try_parse_status({}, read_payload("big_favicon.json"));
+	ASSERT_TRUE(big_favicon.has_value());
+	EXPECT_GT((*big_favicon)->icon->size(), 48u * 1024u);
+
+	const auto legacy = StatusParser::try_parse_status({}, read_payload("vanilla_1.8.9_legacy_motd.json"));
+	ASSERT_TRUE(legacy.has_value());
+	EXPECT_TRUE(legacy.value()->motd.starts_with("§6§l"));
+}
+
+// The status view has to agree with the regular parser on every payload
+TEST(CorpusTest, StatusViewMatchesParser) {
+	for (const std::filesystem::path& payload : corpus_payloads()) {
+		const std::string json = read_payload(payload.filename().string());
+		const auto expected = StatusParser::try_parse_status({}, json);
+		const auto view = JavaStatusView::try_parse(json);
+
+		ASSERT_TRUE(expected.has_value()) << payload.filename();
+		ASSERT_TRUE(view.has_value()) << payload.filename();
+
+		const JavaServer::JavaServerResponse& status = **expected;
+		EXPECT_EQ(view->version_name, status.version->name) << payload.filename();
+		EXPECT_EQ(view->protocol, status.version->protocol) << payload.filename();
+		EXPECT_EQ(view->online, status.players->online) << payload.filename();
+		EXPECT_EQ(view->max, status.players->max) << payload.filename();
+		EXPECT_EQ(view->enforces_secure_chat, status.enforces_secure_chat) << payload.filename();
+		EXPECT_EQ(view->icon, status.icon) << payload.filename();
+
+		ASSERT_EQ(view->sample.has_value(), status.players->sample.has_value()) << payload.filename();
+		if (view->sample) {
+			ASSERT_EQ(view->sample->size(), status.players->sample->size()) << payload.filename();
+			for (std::size_t i = 0; i < view->sample->size(); ++i) {
+				EXPECT_EQ((*view->sample)[i].name, (*status.players->sample)[i].name) << payload.filename();
+				EXPECT_EQ((*view->sample)[i].id, (*status.players->sample)[i].id) << payload.filename();
+			}
+		}
+
+		ASSERT_TRUE(view->description.has_value()) << payload.filename();
+		EXPECT_EQ(normalize(*view->description, true), status.motd) << payload.filename();
+		ASSERT_EQ(view->forge_data.has_value(), status.forge_data.has_value()) << payload.filename();
+		if (view->forge_data) {
+			EXPECT_EQ(normalize(*view->forge_data, false), *status.forge_data) << payload.filename();
+		}
+	}
+}
@@ -0,0 +1,122 @@
+#include "libmcstatus/InternPool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <boost/uuid/string_generator.hpp>
+#include <chrono>
+#include <string>
+#include <utility>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/JavaStatusView.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::string_view STATUS =
+    R"({"version":{"name":"Paper 1.20.4","protocol":765},)"
+    R"("players":{"max":100,"online":1,"sample":[{"name":"Notch","id":"069a79f4-44e9-4726-a5be-fca90e38aaf5"}]},)"
+    R"("description":"A \"Minecraft\" Server","favicon":"data:image/png;base64,AAAA"})";
+
+JavaServer::RawStatus raw(std::string_view json) {
+	return JavaServer::RawStatus{.latency = 5ms, .buffer = {json.begin(), json.end()}, .size = json.size()};
+}
+
+}  // namespace
+
+TEST(InternPoolTest, SharesEqualStrings) {
+	InternPool pool;
+
+	const InternPool::string_t first = pool.intern("Paper 1.20.4");
+	const InternPool::string_t second = pool.intern(std::string{"Paper 1.20.4"});
+	const InternPool::string_t other = pool.intern("Velocity 3.3.0");
+
+	EXPECT_EQ(first, second);
+	EXPECT_NE(first, other);
+	EXPECT_EQ(*first, "Paper 1.20.4");
+	EXPECT_EQ(*other, "Velocity 3.3.0");
+	EXPECT_EQ(pool.size(), 2u);
+	EXPECT_GE(pool.memory_usage(), first->size() + other->size());
+}
+
+TEST(InternPoolTest, PrunesUnusedStrings) {
+	InternPool pool;
+
+	const InternPool::string_t kept = pool.intern("kept");
+	std::ignore = pool.intern("dropped");
+	ASSERT_EQ(pool.size(), 2u);
+
+	EXPECT_EQ(pool.prune(), 1u);
+	EXPECT_EQ(pool.size(), 1u);
+	EXPECT_EQ(pool.intern("kept"), kept);
+}
+
+TEST(InternPoolTest, InternsParsedStatuses) {
+	InternPool pool;
+
+	const auto first = InternedStatus::try_parse(raw(STATUS), pool);
+	const auto second = InternedStatus::try_parse(raw(STATUS), pool);
+
+	ASSERT_TRUE(first.has_value());
+	ASSERT_TRUE(second.has_value());
+	EXPECT_EQ(first->latency, 5ms);
+	EXPECT_EQ(*first->version_name, "Paper 1.20.4");
+	EXPECT_EQ(first->protocol, 765);
+	EXPECT_EQ(first->online, 1);
+	EXPECT_EQ(first->max, 100);
+	EXPECT_EQ(*first->motd, R"(A "Minecraft" Server)");
+	EXPECT_EQ(*first->icon, "data:image/png;base64,AAAA");
+	EXPECT_EQ(first->forge_data, nullptr);
+	EXPECT_FALSE(first->enforces_secure_chat.has_value());
+	ASSERT_EQ(first->sample->size(), 1u);
+	EXPECT_EQ(*(*first->sample)[0].name, "Notch");
+	EXPECT_EQ((*first->sample)[0].id, boost::uuids::string_generator{}("069a79f4-44e9-4726-a5be-fca90e38aaf5"));
+
+	EXPECT_EQ(first->version_name, second->version_name);
+	EXPECT_EQ(first->motd, second->motd);
+	EXPECT_EQ(first->icon, second->icon);
+	EXPECT_EQ((*first->sample)[0].name, (*second->sample)[0].name);
+	EXPECT_EQ(pool.size(), 4u);
+}
+
+TEST(InternPoolTest, MatchesParsedResponses) {
+	InternPool pool;
+
+	const auto from_raw = InternedStatus::try_parse(raw(STATUS), pool);
+	const auto parsed = JavaServer::try_parse_status(raw(STATUS));
+	ASSERT_TRUE(from_raw.has_value());
+	ASSERT_TRUE(parsed.has_value());
+
+	const InternedStatus from_response = InternedStatus::from(**parsed, pool);
+
+	EXPECT_EQ(from_response.version_name, from_raw->version_name);
+	EXPECT_EQ(from_response.motd, from_raw->motd);
+	EXPECT_EQ(from_response.icon, from_raw->icon);
+	EXPECT_EQ(from_response.online, from_raw->online);
+	EXPECT_EQ((*from_response.sample)[0].name, (*from_raw->sample)[0].name);
+}
+
+TEST(InternPoolTest, KeepsChatComponentsAsJson) {
+	InternPool pool;
+
+	const auto status = JavaStatusView::try_parse(
+	    R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":0},"description":{"text":"Hi"}})");
+	ASSERT_TRUE(status.has_value());
+
+	const InternedStatus interned = InternedStatus::from(*status, pool);
+
+	EXPECT_EQ(*interned.motd, R"({"text":"Hi"})");
+	EXPECT_FALSE(interned.sample.has_value());
+}
+
+TEST(InternPoolTest, ReportsMalformedStatus) {
+	InternPool pool;
+
+	const auto status = InternedStatus::try_parse(raw(R"({"version":{}})"), pool);
+
+	ASSERT_FALSE(status.has_value());
+	EXPECT_EQ(status.error(), McError::bad_json);
+	EXPECT_EQ(pool.size(), 0u);
+}
@@ -0,0 +1,206 @@
+#include "libmcstatus/JavaServer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/system/system_error.hpp>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "libmcstatus/TrafficLog.hpp"
+#include "MemoryServer.hpp"
+#include "StubServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+namespace {
+
+boost::asio::ip::tcp::endpoint closed_endpoint() {
+	boost::asio::io_context io_context;
+	boost::asio::ip::tcp::acceptor acceptor{io_context, {boost::asio::ip::address_v4::loopback(), 0}};
+	return acceptor.local_endpoint();  // Nothing listens here once the acceptor is gone
+}
+
+}  // namespace
+
+TEST(JavaServerTest, TryStatusReturnsResponse) {
+	StubServer stub{
+	    R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":1,"sample":[)"
+	    R"({"name":"Notch","id":"069a79f4-44e9-4726-a5be-fca90e38aaf5"}]},"description":{"text":"Hi"}})"};
+	const JavaServer server{stub.endpoint()};
+
+	const auto status = server.try_status(1s);
+
+	ASSERT_TRUE(status.has_value());
+	EXPECT_EQ((*status)->version->protocol, 765);
+	EXPECT_EQ((*status)->players->online, 1);
+	ASSERT_TRUE((*status)->players->sample.has_value());
+	ASSERT_EQ((*status)->players->sample->size(), 1);
+	EXPECT_EQ((*status)->players->sample->front().name, "Notch");
+	EXPECT_EQ((*status)->motd, R"({"text":"Hi"})");
+}
+
+TEST(JavaServerTest, TryPingReturnsLatency) {
+	StubServer stub;
+	const JavaServer server{stub.endpoint()};
+
+	const auto latency = server.try_ping(1s);
+
+	ASSERT_TRUE(latency.has_value());
+	EXPECT_GE(*latency, McServer::latency_t::zero());
+}
+
+TEST(JavaServerTest, TryStatusReportsRefusedConnection) {
+	const JavaServer server{closed_endpoint()};
+
+	EXPECT_EQ(server.try_status(1s, RetryPolicy{.max_attempts = 1}).error(), McError::connection_refused);
+	EXPECT_EQ(server.try_ping(1s, RetryPolicy{.max_attempts = 1}).error(), McError::connection_refused);
+}
+
+TEST(JavaServerTest, TryStatusReportsBadJson) {
+	for (const std::string json : {R"({"version":)", R"([])", R"({"version":{"name":"1.20.4"},"players":{}})",
+	                               R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":1,)"
+	                               R"("sample":[{"name":"Notch","id":"not-a-uuid"}]}})"}) {
+		StubServer stub{json};
+		const JavaServer server{stub.endpoint()};
+
+		EXPECT_EQ(server.try_status(1s).error(), McError::bad_json) << json;
+	}
+}
+
+TEST(JavaServerTest, StatusThrowsSystemError) {
+	StubServer stub{"{}"};
+	const JavaServer server{stub.endpoint()};
+
+	try {
+		std::ignore = server.status(1s);
+		FAIL() << "Expected a boost::system::system_error";
+	} catch (const boost::system::system_error& error) {
+		EXPECT_EQ(error.code(), McError::bad_json);
+	}
+}
+
+TEST(JavaServerTest, TryLookupOfIpLiteral) {
+	const auto server = JavaServer::try_lookup("127.0.0.1:1234");
+
+	ASSERT_TRUE(server.has_value());
+	EXPECT_EQ(server->to_string(), "127.0.0.1:1234");
+}
+
+TEST(JavaServerTest, StatusHasTimings) {
+	StubServer stub{std::string{StubServer::DEFAULT_STATUS}, [](std::size_t) { return 20ms; }};
+	const JavaServer server{stub.endpoint()};
+
+	const auto status = server.status(1s);
+
+	ASSERT_TRUE(status->timings.has_value());
+	const McServer::McTimings& timings = *status->timings;
+	EXPECT_FALSE(timings.resolve.has_value());  // Not created by lookup()
+	EXPECT_GE(timings.connect, McServer::latency_t::zero());
+	EXPECT_GE(timings.handshake, McServer::latency_t::zero());
+	EXPECT_GE(timings.first_byte, 20ms);
+	EXPECT_LE(timings.first_byte, timings.response);
+	EXPECT_EQ(timings.response, status->latency);
+	EXPECT_GE(timings.parse, McServer::latency_t::zero());
+}
+
+TEST(JavaServerTest, LookupRecordsResolveTime) {
+	StubServer stub;
+	const auto server = JavaServer::try_lookup("localhost:" + std::to_string(stub.endpoint().port()));
+	ASSERT_TRUE(server.has_value());
+
+	const auto status = server->try_status(1s);
+
+	ASSERT_TRUE(status.has_value());
+	EXPECT_TRUE((*status)->timings->resolve.has_value());
+}
+
+TEST(JavaServerTest, StatusRawSkipsParsing) {
+	// Not a valid status at all, which only matters once it gets parsed
+	const JavaServer server{memory_server::transport("not json")};
+
+	const auto raw_status = server.try_status_raw(1s);
+
+	ASSERT_TRUE(raw_status.has_value()) << to_string(raw_status.error());
+	EXPECT_EQ(raw_status->json(), "not json");
+	EXPECT_GE(raw_status->latency, McServer::latency_t::zero());
+	EXPECT_EQ(JavaServer::try_parse_status(*raw_status).error(), McError::bad_json);
+	EXPECT_THROW(std::ignore = JavaServer::parse_status(*raw_status), boost::system::system_error);
+}
+
+TEST(JavaServerTest, ParseStatusOfRawStatus) {
+	const JavaServer server{memory_server::transport()};
+
+	const JavaServer::RawStatus raw_status = server.status_raw(1s);
+	EXPECT_EQ(raw_status.json(), memory_server::DEFAULT_STATUS);
+
+	const std::unique_ptr<JavaServer::JavaServerResponse> status = JavaServer::parse_status(raw_status);
+	EXPECT_EQ(status->players->online, 3);
+	EXPECT_EQ(status->latency, raw_status.latency);
+	ASSERT_TRUE(status->timings.has_value());
+	EXPECT_EQ(status->timings->response, raw_status.timings->response);
+
+	// The view can take the buffer over without copying it
+	JavaServer::RawStatus moved = raw_status;
+	const auto view = JavaStatusView::try_parse(std::move(moved.buffer), moved.offset, moved.size);
+	ASSERT_TRUE(view.has_value());
+	EXPECT_EQ(view->description, R"("In memory")");
+}
+
+TEST(JavaServerTest, AsyncStatusRaw) {
+	const JavaServer server{memory_server::transport()};
+	boost::asio::io_context io_context;
+	std::optional<McServer::result_t<JavaServer::RawStatus>> raw_status;
+
+	boost::asio::co_spawn(io_context, server.async_try_status_raw(1s),
+	                      [&](std::exception_ptr, McServer::result_t<JavaServer::RawStatus> result) {
+		                      raw_status = std::move(result);
+	                      });
+	io_context.run();
+
+	ASSERT_TRUE(raw_status.has_value());
+	ASSERT_TRUE(raw_status->has_value()) << to_string(raw_status->error());
+	EXPECT_EQ((*raw_status)->json(), memory_server::DEFAULT_STATUS);
+}
+
+TEST(JavaServerTest, AsyncPing) {
+	const JavaServer server{memory_server::transport()};
+	boost::asio::io_context io_context;
+	std::optional<McServer::result_t<McServer::latency_t>> latency;
+
+	boost::asio::co_spawn(io_context, server.async_try_ping(1s),
+	                      [&](std::exception_ptr, McServer::result_t<McServer::latency_t> result) {
+		                      latency = result;
+	                      });
+	io_context.run();
+
+	ASSERT_TRUE(latency.has_value());
+	ASSERT_TRUE(latency->has_value()) << to_string(latency->error());
+	EXPECT_GE(**latency, McServer::latency_t::zero());
+}
+
+TEST(JavaServerTest, StatusRawBatchKeepsOrder) {
+	const std::vector<JavaServer> servers{
+	    JavaServer{memory_server::transport(R"({"first":1})")},
+	    JavaServer{std::make_shared<ReplayTransport>(std::vector<TrafficRecord>{})},
+	    JavaServer{memory_server::transport(R"({"third":3})")},
+	};
+
+	for (const std::size_t concurrency : {1u, 2u, 8u}) {
+		const auto results = JavaServer::try_status_raw_batch(servers, 1s, RetryPolicy{.max_attempts = 1}, concurrency);
+
+		ASSERT_EQ(results.size(), 3u);
+		ASSERT_TRUE(results[0].has_value());
+		EXPECT_EQ(results[0]->json(), R"({"first":1})");
+		EXPECT_EQ(results[1].error(), McError::connection_refused);
+		ASSERT_TRUE(results[2].has_value());
+		EXPECT_EQ(results[2]->json(), R"({"third":3})");
+	}
+
+	EXPECT_TRUE(JavaServer::try_status_raw_batch({}, 1s).empty());
+}
@@ -0,0 +1,145 @@
+#include "libmcstatus/JavaStatusView.hpp"
+
+#include <gtest/gtest.h>
+
+#include <boost/uuid/string_generator.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "MemoryServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+TEST(JavaStatusViewTest, ParsesAllFields) {
+	const auto status = JavaStatusView::try_parse(
+	    R"({"version":{"name":"Paper 1.20.4","protocol":765},)"
+	    R"("players":{"max":100,"online":2,"sample":[{"name":"Notch","id":"069a79f4-44e9-4726-a5be-fca90e38aaf5"},)"
+	    R"({"id":"853c80ef-3c37-49fd-aa49-938b674adae6","name":"jeb_"}]},)"
+	    R"("description":{"text":"Hello","extra":[{"text":" world","bold":true}]},)"
+	    R"("enforcesSecureChat":true,"favicon":"data:image/png;base64,AAAA","forgeData":{"fmlNetworkVersion":3}})");
+
+	ASSERT_TRUE(status.has_value());
+	EXPECT_EQ(status->version_name, "Paper 1.20.4");
+	EXPECT_EQ(status->protocol, 765);
+	EXPECT_EQ(status->online, 2);
+	EXPECT_EQ(status->max, 100);
+	ASSERT_EQ(status->sample->size(), 2u);
+	EXPECT_EQ((*status->sample)[0].name, "Notch");
+	EXPECT_EQ((*status->sample)[0].id, boost::uuids::string_generator{}("069a79f4-44e9-4726-a5be-fca90e38aaf5"));
+	EXPECT_EQ((*status->sample)[1].name, "jeb_");
+	EXPECT_EQ(status->description, R"({"text":"Hello","extra":[{"text":" world","bold":true}]})");
+	EXPECT_EQ(status->enforces_secure_chat, true);
+	EXPECT_EQ(status->icon, "data:image/png;base64,AAAA");
+	EXPECT_EQ(status->forge_data, R"({"fmlNetworkVersion":3})");
+}
+
+TEST(JavaStatusViewTest, UnescapesStrings) {
+	const auto status = JavaStatusView::try_parse(
+	    R"({"version":{"name":"a\"b\\c\/d\né€😀","protocol":1},"players":{"max":1,"online":0}})");
+
+	ASSERT_TRUE(status.has_value());
+	EXPECT_EQ(status->version_name, "a\"b\\c/d\né€\U0001F600");
+}
+
+TEST(JavaStatusViewTest, KeepsRawValuesUntouched) {
+	// Escapes inside raw values must survive, otherwise the slices wouldn't be valid JSON anymore
+	const auto status = JavaStatusView::try_parse(
+	    R"({"description" : {"text":"§cRed \"quoted\""},"version":{"name":"1","protocol":1},)"
+	    R"("players":{"max":1,"online":0},"modinfo":{"type":"FML"}})");
+
+	ASSERT_TRUE(status.has_value());
+	EXPECT_EQ(status->description, R"({"text":"§cRed \"quoted\""})");
+	EXPECT_EQ(status->forge_data, R"({"type":"FML"})");
+}
+
+TEST(JavaStatusViewTest, ForgeDataTakesPrecedenceOverModinfo) {
+	const auto status = JavaStatusView::try_parse(
+	    R"({"forgeData":{"d":1},"modinfo":{"m":1},"version":{"name":"1","protocol":1},)"
+	    R"("players":{"max":1,"online":0}})");
+
+	ASSERT_TRUE(status.has_value());
+	EXPECT_EQ(status->forge_data, R"({"d":1})");
+}
+
+TEST(JavaStatusViewTest, IgnoresOptionalFieldsOfWrongType) {
+	const auto status = JavaStatusView::try_parse(
+	    R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":0,"sample":"none"},)"
+	    R"("enforcesSecureChat":"yes","favicon":42,"unknown":[1.5e3,null,{"a":[]}]})");
+
+	ASSERT_TRUE(status.has_value());
+	EXPECT_FALSE(status->sample.has_value());
+	EXPECT_FALSE(status->enforces_secure_chat.has_value());
+	EXPECT_FALSE(status->icon.has_value());
+	EXPECT_FALSE(status->description.has_value());
+}
+
+TEST(JavaStatusViewTest, RejectsInvalidStatus) {
+	const std::string_view invalid[] = {
+	    "",
+	    "[]",
+	    R"({"players":{"max":1,"online":0}})",
+	    R"({"version":{"name":"1","protocol":1}})",
+	    R"({"version":{"name":1,"protocol":1},"players":{"max":1,"online":0}})",
+	    R"({"version":{"name":"1","protocol":1.5},"players":{"max":1,"online":0}})",
+	    R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":18446744073709551615}})",
+	    R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":0,"sample":[{"name":"a"}]}})",
+	    R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":0,"sample":[{"name":"a","id":"x"}]}})",
+	    R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":0,"sample":[1]}})",
+	    R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":0}} trailing)",
+	    R"({"version":{"name":"1","protocol":01},"players":{"max":1,"online":0}})",
+	    R"({"version":{"name":"\ud83d","protocol":1},"players":{"max":1,"online":0}})",
+	    R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":0},"description":{"text":"a",}})",
+	};
+
+	for (const std::string_view json : invalid) {
+		const auto status = JavaStatusView::try_parse(json);
+
+		ASSERT_FALSE(status.has_value()) << json;
+		EXPECT_EQ(status.error(), McError::bad_json) << json;
+	}
+
+	const std::string too_deep = R"({"version":{"name":"1","protocol":1},"players":{"max":1,"online":0},)"
+	                             R"("description":)" +
+	                             std::string(40, '[') + std::string(40, ']') + "}";
+	EXPECT_FALSE(JavaStatusView::try_parse(too_deep).has_value());
+}
+
+TEST(JavaStatusViewTest, ViewsSurviveMoves) {
+	auto status = JavaStatusView::try_parse(std::string{memory_server::DEFAULT_STATUS});
+	ASSERT_TRUE(status.has_value());
+
+	const std::string_view name = status->version_name;
+	const JavaStatusView moved = std::move(*status);
+
+	EXPECT_EQ(moved.version_name.data(), name.data());
+	EXPECT_EQ(moved.version_name, "1.20.4");
+	EXPECT_GE(moved.memory_usage(), memory_server::DEFAULT_STATUS.size());
+}
+
+TEST(JavaStatusViewTest, QueriesServer) {
+	const JavaServer server{memory_server::transport()};
+
+	const auto status = server.try_status_view(1s);
+
+	ASSERT_TRUE(status.has_value()) << to_string(status.error());
+	EXPECT_EQ(status->version_name, "1.20.4");
+	EXPECT_EQ(status->online, 3);
+	EXPECT_EQ(status->description, R"("In memory")");
+	EXPECT_GE(status->latency, 0ns);
+	ASSERT_TRUE(status->timings.has_value());
+	EXPECT_EQ(status->timings->response, status->latency);
+}
+
+TEST(JavaStatusViewTest, ReportsMalformedStatus) {
+	const JavaServer server{memory_server::transport(R"({"version":{}})")};
+
+	const auto status = server.try_status_view(1s, RetryPolicy{.max_attempts = 1});
+
+	ASSERT_FALSE(status.has_value());
+	EXPECT_EQ(status.error(), McError::bad_json);
+	EXPECT_THROW(std::ignore = server.status_view(1s, RetryPolicy{.max_attempts = 1}), boost::system::system_error);
+}
@@ -334,6 +334,45 @@ TEST(McPacketTest, MixedWriteRead) {
 	EXPECT_EQ(packet.read_varlong(), 123456789012345LL);
 }
 
+// Test the non-throwing readers
+TEST(McPacketTest, TryReadersReturnValues) {
+	McPacket packet{};
+	packet.write_varint(-42);
+	packet.write_varlong(123456789012345LL);
+	packet.write_utf("Hello");
+	packet.write_long(-9876543210LL);
+
+	McPacket reconstructed = *McPacket::try_read_from_buffer(packet.write_to_buffer());
+
+	EXPECT_EQ(reconstructed.try_read_varint(), -42);
+	EXPECT_EQ(reconstructed.try_read_varlong(), 123456789012345LL);
+	EXPECT_EQ(reconstructed.try_read_utf(), "Hello");
+	EXPECT_EQ(reconstructed.try_read_long(), -9876543210LL);
+}
+
+TEST(McPacketTest, TryReadersReportBadFrame) {
+	McPacketAccessor truncated_varint{{0x80, 0x80}};
+	EXPECT_EQ(truncated_varint.try_read_varint().error(), McError::bad_frame);
+
+	McPacketAccessor oversized_varint{{0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}};
+	EXPECT_EQ(oversized_varint.try_read_varint().error(), McError::bad_frame);
+
+	McPacketAccessor truncated_utf{{0x05, 'a', 'b'}};
+	EXPECT_EQ(truncated_utf.try_read_utf().error(), McError::bad_frame);
+
+	McPacketAccessor truncated_long{{0x01, 0x02, 0x03}};
+	EXPECT_EQ(truncated_long.try_read_long().error(), McError::bad_frame);
+	EXPECT_THROW(McPacketAccessor({0x01, 0x02, 0x03}).read_long(), std::runtime_error);
+}
+
+TEST(McPacketTest, TryReadFromBufferRejectsBadFrames) {
+	EXPECT_EQ(McPacket::try_read_from_buffer({0x05, 0x00}).error(), McError::bad_frame);  // Too short
+
+	// Longer than MAX_PACKET_SIZE
+	EXPECT_EQ(McPacket::try_read_from_buffer({0x80, 0x80, 0x80, 0x01}).error(), McError::bad_frame);
+	EXPECT_THROW(McPacket::read_from_buffer({0x80, 0x80, 0x80, 0x01}), std::runtime_error);
+}
+
 // Test edge cases
 TEST(McPacketTest, EmptyBuffer) {
 	McPacket packet{};
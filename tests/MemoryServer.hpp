@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "libmcstatus/McPacket.hpp"
+#include "libmcstatus/Transport.hpp"
+
+// In-memory counterpart of StubServer, answering status and ping requests over a MemoryTransport
+namespace memory_server {
+
+using libmcstatus::McError;
+using libmcstatus::McPacket;
+using libmcstatus::Transport;
+
+constexpr std::string_view DEFAULT_STATUS{
+    R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":3},"description":"In memory"})"};
+
+// Server end of one connection. The client sends the handshake and its request back to back, so packets have to be
+// split off the byte stream one by one
+inline boost::asio::awaitable<void> serve(std::shared_ptr<Transport::Connection> connection, std::string status) {
+	McPacket::buffer_t received;
+	std::array<std::uint8_t, 256> buffer;
+	bool handshake_done = false;
+
+	while (const std::expected<std::size_t, McError> read =
+	           co_await connection->async_read_some(boost::asio::buffer(buffer))) {
+		received.insert(received.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(*read));
+
+		while (true) {
+			const std::expected<std::size_t, McError> size = McPacket::try_frame_size(received);
+			if (!size || (*size == 0)) {
+				break;
+			}
+
+			McPacket request = McPacket::read_from_buffer({received.begin(), received.begin() + *size});
+			received.erase(received.begin(), received.begin() + static_cast<std::ptrdiff_t>(*size));
+
+			const std::int32_t packet_id = request.read_varint();
+			McPacket response;
+
+			if (!handshake_done) {
+				handshake_done = true;
+				continue;
+			} else if (packet_id == 0) {
+				response.write_varint(0);
+				response.write_utf(status);
+			} else if (packet_id == 1) {
+				response.write_varint(1);
+				response.write_long(request.read_long());
+			} else {
+				co_return;
+			}
+
+			if (!co_await response.async_try_write(*connection)) {
+				co_return;
+			}
+		}
+	}
+}
+
+inline std::shared_ptr<libmcstatus::MemoryTransport> transport(std::string status = std::string{DEFAULT_STATUS}) {
+	return std::make_shared<libmcstatus::MemoryTransport>(
+	    [status](std::shared_ptr<Transport::Connection> connection) { return serve(std::move(connection), status); });
+}
+
+}  // namespace memory_server
@@ -0,0 +1,147 @@
+#include "libmcstatus/Metrics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libmcstatus/Histogram.hpp"
+#include "libmcstatus/JavaServer.hpp"
+#include "StubServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+TEST(HistogramTest, BucketsAreContiguous) {
+	EXPECT_EQ(Histogram::bucket_index(0), 0);
+	EXPECT_EQ(Histogram::bucket_index(15), 15);
+
+	for (std::size_t i = 0; i < Histogram::BUCKETS - 1; ++i) {
+		const std::uint64_t limit = Histogram::bucket_limit(i);
+		EXPECT_EQ(Histogram::bucket_index(limit - 1), i);
+		EXPECT_EQ(Histogram::bucket_index(limit), i + 1);
+	}
+
+	EXPECT_EQ(Histogram::bucket_index(~std::uint64_t{0}), Histogram::BUCKETS - 1);
+}
+
+TEST(HistogramTest, RelativeErrorIsBounded) {
+	for (std::uint64_t value = 1; value < (std::uint64_t{1} << 36); value = (value * 3) + 1) {
+		const std::uint64_t limit = Histogram::bucket_limit(Histogram::bucket_index(value));
+		EXPECT_GT(limit, value);
+		EXPECT_LE(static_cast<double>(limit - 1 - value), static_cast<double>(value) / Histogram::SUB_BUCKETS);
+	}
+}
+
+TEST(HistogramTest, PercentilesAndMerge) {
+	Histogram first;
+	Histogram second;
+	EXPECT_EQ(first.percentile(0.5), Histogram::duration_t::zero());
+
+	for (int i = 1; i <= 50; ++i) {
+		first.record(std::chrono::milliseconds{i});
+		second.record(std::chrono::milliseconds{50 + i});
+	}
+	first.merge(second);
+
+	using milliseconds_t = std::chrono::duration<double, std::milli>;
+
+	EXPECT_EQ(first.count, 100);
+	EXPECT_NEAR(milliseconds_t{first.percentile(0.5)}.count(), 50.0, 50.0 / 16);
+	EXPECT_NEAR(milliseconds_t{first.percentile(0.99)}.count(), 99.0, 99.0 / 16);
+	EXPECT_NEAR(milliseconds_t{first.mean()}.count(), 50.5, 0.01);
+	EXPECT_EQ(first.count_below(1ms), 0);
+	EXPECT_EQ(first.count_below(1h), 100);
+}
+
+TEST(MetricsTest, HistogramCountUpToIsExact) {
+	Histogram histogram;
+
+	// 1ms falls into the middle of a bucket, which reaches up to 1015807ns
+	histogram.record(1ms);
+	histogram.record(std::chrono::nanoseconds{1015807});
+	histogram.record(std::chrono::nanoseconds{1015808});
+
+	const Histogram::CumulativeCount bucket = histogram.count_up_to(1ms);
+	EXPECT_EQ(bucket.limit, std::chrono::nanoseconds{1015807});
+	EXPECT_EQ(bucket.count, 2);
+	EXPECT_EQ(histogram.count_below(1ms), 0);
+
+	// Values right at the limit are counted, as Prometheus' le means at most
+	EXPECT_EQ(histogram.count_up_to(bucket.limit).count, 2);
+	EXPECT_EQ(histogram.count_up_to(bucket.limit + std::chrono::nanoseconds{1}).count, 3);
+}
+
+TEST(MetricsTest, CountsFromAllThreads) {
+	const Metrics::Snapshot before = Metrics::snapshot();
+
+	std::vector<std::thread> threads;
+	for (int i = 0; i < 4; ++i) {
+		threads.emplace_back([] {
+			for (int j = 0; j < 1000; ++j) {
+				Metrics::increment(Metrics::Counter::srv_queries);
+				Metrics::record(Metrics::Timer::lookup, 1ms);
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	const Metrics::Snapshot after = Metrics::snapshot();
+	EXPECT_EQ(after.counter(Metrics::Counter::srv_queries) - before.counter(Metrics::Counter::srv_queries), 4000);
+	EXPECT_EQ(after.timer(Metrics::Timer::lookup).count - before.timer(Metrics::Timer::lookup).count, 4000);
+}
+
+TEST(MetricsTest, QueriesAreInstrumented) {
+	StubServer stub;
+	const JavaServer server{stub.endpoint()};
+	const Metrics::Snapshot before = Metrics::snapshot();
+
+	std::ignore = server.status(1s);
+
+	const Metrics::Snapshot after = Metrics::snapshot();
+	const auto delta = [&](Metrics::Counter counter) { return after.counter(counter) - before.counter(counter); };
+
+	EXPECT_EQ(delta(Metrics::Counter::queries_started), 1);
+	EXPECT_EQ(delta(Metrics::Counter::queries_succeeded), 1);
+	EXPECT_EQ(delta(Metrics::Counter::attempts), 1);
+	EXPECT_GT(delta(Metrics::Counter::bytes_out), 0);
+	EXPECT_GT(delta(Metrics::Counter::bytes_in), StubServer::DEFAULT_STATUS.size());
+	EXPECT_EQ(after.timer(Metrics::Timer::query).count - before.timer(Metrics::Timer::query).count, 1);
+}
+
+TEST(MetricsTest, FailuresAndRetriesAreCounted) {
+	boost::asio::ip::tcp::endpoint closed;
+	{
+		boost::asio::io_context io_context;
+		boost::asio::ip::tcp::acceptor acceptor{io_context, {boost::asio::ip::address_v4::loopback(), 0}};
+		closed = acceptor.local_endpoint();
+	}
+	const JavaServer server{closed};
+	const Metrics::Snapshot before = Metrics::snapshot();
+
+	const RetryPolicy policy{.max_attempts = 3, .initial_backoff = 1ms, .retryable = McErrorSet::all()};
+
+	std::ignore = server.try_ping(1s, policy);
+
+	const Metrics::Snapshot after = Metrics::snapshot();
+	EXPECT_EQ(after.failed(McError::connection_refused) - before.failed(McError::connection_refused), 1);
+	EXPECT_EQ(after.failed() - before.failed(), 1);
+	EXPECT_EQ(after.counter(Metrics::Counter::attempts) - before.counter(Metrics::Counter::attempts), 3);
+	EXPECT_EQ(after.counter(Metrics::Counter::retries) - before.counter(Metrics::Counter::retries), 2);
+}
+
+TEST(MetricsTest, PrometheusText) {
+	Metrics::increment(Metrics::Counter::queries_started, 0);  // Make sure there is at least one shard
+	const std::string text = Metrics::snapshot().to_prometheus();
+
+	EXPECT_NE(text.find("# TYPE libmcstatus_queries_started_total counter\n"), std::string::npos);
+	EXPECT_NE(text.find("libmcstatus_queries_failed_total{error=\"timeout\"} "), std::string::npos);
+	EXPECT_NE(text.find("# TYPE libmcstatus_query_duration_seconds histogram\n"), std::string::npos);
+	EXPECT_NE(text.find("libmcstatus_query_duration_seconds_bucket{le=\"0.001015807\"} "), std::string::npos);
+	EXPECT_NE(text.find("libmcstatus_query_duration_seconds_bucket{le=\"+Inf\"} "), std::string::npos);
+	EXPECT_NE(text.find("libmcstatus_lookup_duration_seconds_count "), std::string::npos);
+}
@@ -0,0 +1,245 @@
+#include "libmcstatus/Monitor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "libmcstatus/TrafficLog.hpp"
+#include "MemoryServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr Monitor::Options FAST{.tick = 1ms, .max_in_flight = 16};
+
+}  // namespace
+
+TEST(MonitorTest, PollsPeriodically) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), FAST};
+	std::vector<Monitor::Result> results;
+
+	monitor.subscribe([&](const Monitor::Result& result) { results.push_back(result); });
+	const Monitor::target_id_t target = monitor.add(JavaServer{memory_server::transport()}, {.interval = 10ms});
+	EXPECT_EQ(monitor.size(), 1u);
+
+	io_context.run_for(200ms);
+
+	// About 20, but timers on a busy machine may be late
+	EXPECT_GE(results.size(), 5u);
+	EXPECT_LE(results.size(), 21u);
+	for (const Monitor::Result& result : results) {
+		EXPECT_EQ(result.target, target);
+		EXPECT_EQ(result.query, Monitor::Query::status);
+		ASSERT_TRUE(result.latency.has_value());
+		ASSERT_TRUE(result.status.has_value());
+		EXPECT_EQ(result.status->json(), memory_server::DEFAULT_STATUS);
+		EXPECT_EQ(result.status->latency, *result.latency);
+	}
+}
+
+TEST(MonitorTest, Ping) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), FAST};
+	std::vector<Monitor::Result> results;
+
+	monitor.subscribe([&](const Monitor::Result& result) { results.push_back(result); });
+	monitor.add(JavaServer{memory_server::transport()}, {.query = Monitor::Query::ping, .interval = 10ms});
+	io_context.run_for(50ms);
+
+	ASSERT_FALSE(results.empty());
+	EXPECT_EQ(results.front().query, Monitor::Query::ping);
+	EXPECT_TRUE(results.front().latency.has_value());
+	EXPECT_FALSE(results.front().status.has_value());
+}
+
+TEST(MonitorTest, PublishesErrors) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), FAST};
+	std::vector<Monitor::Result> results;
+
+	monitor.subscribe([&](const Monitor::Result& result) { results.push_back(result); });
+	monitor.add(JavaServer{std::make_shared<ReplayTransport>(std::vector<TrafficRecord>{})}, {.interval = 10ms});
+	io_context.run_for(50ms);
+
+	ASSERT_FALSE(results.empty());
+	EXPECT_EQ(results.front().latency.error(), McError::connection_refused);
+	EXPECT_FALSE(results.front().status.has_value());
+}
+
+TEST(MonitorTest, RemoveStopsPolling) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), FAST};
+	std::size_t results = 0;
+
+	const Monitor::target_id_t target = monitor.add(JavaServer{memory_server::transport()}, {.interval = 5ms});
+	monitor.subscribe([&](const Monitor::Result& result) {
+		++results;
+		EXPECT_TRUE(monitor.remove(result.target));
+	});
+	io_context.run_for(100ms);
+
+	EXPECT_EQ(results, 1u);
+	EXPECT_EQ(monitor.size(), 0u);
+	EXPECT_FALSE(monitor.remove(target));
+	EXPECT_FALSE(monitor.update(target, {}));
+}
+
+TEST(MonitorTest, UpdateChangesInterval) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), FAST};
+	std::size_t results = 0;
+
+	monitor.subscribe([&](const Monitor::Result&) { ++results; });
+	const Monitor::target_id_t target = monitor.add(JavaServer{memory_server::transport()}, {.interval = 1h});
+	EXPECT_TRUE(monitor.update(target, {.interval = 5ms}));
+	io_context.run_for(100ms);
+
+	EXPECT_GE(results, 3u);
+
+	// Back to once an hour, the poll scheduled with the short interval is dropped
+	EXPECT_TRUE(monitor.update(target, {.interval = 1h}));
+	const std::size_t before = results;
+	io_context.restart();
+	io_context.run_for(50ms);
+
+	EXPECT_LE(results, before + 1);
+}
+
+TEST(MonitorTest, Unsubscribe) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), FAST};
+	std::size_t first = 0;
+	std::size_t second = 0;
+
+	const Monitor::subscription_id_t subscription = monitor.subscribe([&](const Monitor::Result&) { ++first; });
+	monitor.subscribe([&](const Monitor::Result&) { ++second; });
+	monitor.unsubscribe(subscription);
+	monitor.add(JavaServer{memory_server::transport()}, {.interval = 5ms});
+	io_context.run_for(50ms);
+
+	EXPECT_EQ(first, 0u);
+	EXPECT_GT(second, 0u);
+}
+
+TEST(MonitorTest, LimitsPollsInFlight) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), {.tick = 1ms, .max_in_flight = 2}};
+	std::size_t connections = 0;
+	std::size_t most_connections = 0;
+	std::size_t results = 0;
+
+	// Keeps every connection open for a moment, so that polls overlap
+	const auto transport = std::make_shared<MemoryTransport>([&](std::shared_ptr<Transport::Connection> connection)
+	                                                             -> boost::asio::awaitable<void> {
+		most_connections = std::max(most_connections, ++connections);
+		boost::asio::steady_timer delay{co_await boost::asio::this_coro::executor, 5ms};
+		co_await delay.async_wait(boost::asio::use_awaitable);
+		co_await memory_server::serve(connection, std::string{memory_server::DEFAULT_STATUS});
+		--connections;
+	});
+
+	monitor.subscribe([&](const Monitor::Result& result) {
+		EXPECT_TRUE(result.latency.has_value());
+		++results;
+	});
+	for (int i = 0; i < 10; ++i) {
+		monitor.add(JavaServer{transport}, {.interval = 2ms});
+	}
+	io_context.run_for(100ms);
+
+	EXPECT_GT(results, 10u);
+	EXPECT_LE(most_connections, 2u);
+}
+
+TEST(MonitorTest, DestroyedWhilePolling) {
+	boost::asio::io_context io_context;
+	std::size_t results = 0;
+	{
+		Monitor monitor{io_context.get_executor(), FAST};
+		monitor.subscribe([&](const Monitor::Result&) { ++results; });
+		monitor.add(JavaServer{memory_server::transport()}, {.interval = 1ms});
+		io_context.run_for(20ms);
+	}
+	const std::size_t before = results;
+
+	// The polls still in flight finish without publishing anything, then the io_context runs out of work
+	io_context.restart();
+	io_context.run_for(1s);
+
+	EXPECT_EQ(results, before);
+	EXPECT_TRUE(io_context.stopped());
+}
+
+TEST(MonitorTest, AdaptiveSlowsDownUnchangedServers) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), FAST};
+	std::vector<Monitor::Result> results;
+
+	monitor.subscribe([&](const Monitor::Result& result) { results.push_back(result); });
+	monitor.add(JavaServer{memory_server::transport()},
+	            {.interval = 2ms, .adaptive = AdaptivePolicy{.min_interval = 2ms, .max_interval = 40ms}});
+	io_context.run_for(300ms);
+
+	ASSERT_GE(results.size(), 3u);
+	// Nothing to compare the first status to
+	EXPECT_FALSE(results.front().changed.has_value());
+	for (auto result = results.begin() + 1; result != results.end(); ++result) {
+		EXPECT_EQ(result->changed, false);
+	}
+	EXPECT_EQ(results.back().interval, 40ms);
+}
+
+TEST(MonitorTest, AdaptiveSeesChanges) {
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), FAST};
+	std::vector<Monitor::Result> results;
+	int online = 0;
+
+	// Every status has one more player online
+	const auto transport =
+	    std::make_shared<MemoryTransport>([&](std::shared_ptr<Transport::Connection> connection) {
+		    return memory_server::serve(std::move(connection),
+		                                R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":)" +
+		                                    std::to_string(online++) + R"(},"description":"x"})");
+	    });
+
+	monitor.subscribe([&](const Monitor::Result& result) { results.push_back(result); });
+	monitor.add(JavaServer{transport},
+	            {.interval = 20ms, .adaptive = AdaptivePolicy{.min_interval = 2ms, .max_interval = 20ms}});
+	io_context.run_for(300ms);
+
+	ASSERT_GE(results.size(), 3u);
+	EXPECT_EQ(results[1].changed, true);
+	EXPECT_EQ(results.back().interval, 2ms);
+}
+
+TEST(MonitorTest, QueryBudgetStretchesIntervals) {
+	boost::asio::io_context io_context;
+	// 10 targets every 10ms would be 1000 polls per second
+	Monitor monitor{io_context.get_executor(), {.tick = 1ms, .max_queries_per_second = 100.0}};
+	std::vector<Monitor::Result> results;
+
+	monitor.subscribe([&](const Monitor::Result& result) { results.push_back(result); });
+	for (int i = 0; i < 10; ++i) {
+		monitor.add(JavaServer{memory_server::transport()}, {.interval = 10ms});
+	}
+	io_context.run_for(300ms);
+
+	ASSERT_FALSE(results.empty());
+	// About 30, without the budget about 300
+	EXPECT_LE(results.size(), 50u);
+	for (const Monitor::Result& result : results) {
+		EXPECT_EQ(result.interval, 100ms);
+	}
+}
@@ -0,0 +1,113 @@
+#include "libmcstatus/Motd.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace libmcstatus;
+
+namespace {
+
+std::vector<std::string_view> texts(const Motd& motd) {
+	std::vector<std::string_view> result;
+	for (const Motd::Component& component : motd.components()) {
+		result.push_back(component.text);
+	}
+	return result;
+}
+
+}  // namespace
+
+TEST(MotdTest, PlainTextIsUntouched) {
+	const Motd motd{"A Minecraft Server"};
+
+	EXPECT_EQ(motd.plain_text(), "A Minecraft Server");
+	ASSERT_EQ(motd.components().size(), 1u);
+	EXPECT_EQ(motd.components()[0].text, "A Minecraft Server");
+	EXPECT_FALSE(motd.components()[0].color.has_value());
+	EXPECT_EQ(motd.components()[0].end, 1u);
+}
+
+TEST(MotdTest, StripsLegacyCodes) {
+	EXPECT_EQ(Motd{"§aGreen §lbold§r plain"}.plain_text(), "Green bold plain");
+	EXPECT_EQ(Motd{"§§xy"}.plain_text(), "xy");
+	EXPECT_EQ(Motd{"trailing§"}.plain_text(), "trailing");
+	EXPECT_EQ(Motd{"multibyte§éafter"}.plain_text(), "multibyteafter");
+	EXPECT_EQ(Motd{"no codes, but long enough to take the vectorized path §"}.plain_text(),
+	          "no codes, but long enough to take the vectorized path ");
+}
+
+TEST(MotdTest, TurnsLegacyCodesIntoComponents) {
+	const Motd motd{"Hi §cred §lbold§r reset"};
+	const auto components = motd.components();
+
+	ASSERT_EQ(texts(motd), (std::vector<std::string_view>{"Hi ", "red ", "bold", " reset"}));
+	EXPECT_EQ(components[0].end, 4u);
+	EXPECT_EQ(components[1].color, 0xFF5555u);
+	EXPECT_EQ(components[1].format, 0);
+	EXPECT_EQ(components[2].color, 0xFF5555u);
+	EXPECT_EQ(components[2].format, Motd::bold);
+	EXPECT_FALSE(components[3].color.has_value());
+	EXPECT_EQ(components[3].format, 0);
+}
+
+TEST(MotdTest, ParsesChatComponents) {
+	const Motd motd{R"({"extra":[{"text":" world","bold":true},"!"],"text":"Hello","color":"gold","italic":true})"};
+	const auto components = motd.components();
+
+	EXPECT_EQ(motd.plain_text(), "Hello world!");
+	ASSERT_EQ(texts(motd), (std::vector<std::string_view>{"Hello", " world", "!"}));
+	EXPECT_EQ(components[0].color, 0xFFAA00u);
+	EXPECT_EQ(components[0].format, Motd::italic);
+	EXPECT_EQ(components[0].end, 3u);
+	// Children inherit the style, even though extra came first
+	EXPECT_EQ(components[1].color, 0xFFAA00u);
+	EXPECT_EQ(components[1].format, Motd::italic | Motd::bold);
+	EXPECT_EQ(components[1].end, 2u);
+	EXPECT_EQ(components[2].format, Motd::italic);
+}
+
+TEST(MotdTest, ParsesArraysAndColors) {
+	const Motd motd{R"([{"text":"a","color":"#12ab34"},{"text":"bé\"","color":"reset","underlined":true},1])"};
+	const auto components = motd.components();
+
+	ASSERT_EQ(texts(motd), (std::vector<std::string_view>{"a", "bé\"", "1"}));
+	EXPECT_EQ(components[0].color, 0x12AB34u);
+	EXPECT_EQ(components[0].end, 3u);
+	EXPECT_FALSE(components[1].color.has_value());
+	EXPECT_EQ(components[1].format, Motd::underlined);
+	EXPECT_EQ(components[2].color, 0x12AB34u);
+}
+
+TEST(MotdTest, LegacyCodesInsideComponents) {
+	const Motd motd{R"({"text":"§4Red","extra":[{"text":"x"}],"bold":true})"};
+	const auto components = motd.components();
+
+	EXPECT_EQ(motd.plain_text(), "Redx");
+	ASSERT_EQ(components.size(), 3u);
+	EXPECT_EQ(components[1].color, 0xAA0000u);
+	EXPECT_EQ(components[1].format, 0);
+	EXPECT_EQ(components[2].format, Motd::bold);
+}
+
+TEST(MotdTest, MalformedJsonIsPlainText) {
+	const Motd motd{R"({"text":"§6unterminated)"};
+
+	EXPECT_EQ(motd.plain_text(), R"({"text":"unterminated)");
+	EXPECT_EQ(motd.components()[0].text, R"({"text":")");
+}
+
+TEST(MotdTest, CopiesAndMoves) {
+	Motd motd{R"({"text":"a\nb"})"};
+	ASSERT_EQ(motd.components()[0].text, "a\nb");
+
+	const Motd copy = motd;
+	const Motd moved = std::move(motd);
+
+	EXPECT_EQ(copy.components()[0].text, "a\nb");
+	EXPECT_EQ(moved.components()[0].text, "a\nb");
+	EXPECT_EQ(moved.raw(), R"({"text":"a\nb"})");
+	EXPECT_TRUE(Motd{}.plain_text().empty());
+}
@@ -0,0 +1,102 @@
+#include "libmcstatus/PlayerTracker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <boost/uuid/string_generator.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace libmcstatus;
+
+namespace {
+
+const boost::uuids::uuid NOTCH = boost::uuids::string_generator{}("069a79f4-44e9-4726-a5be-fca90e38aaf5");
+const boost::uuids::uuid JEB = boost::uuids::string_generator{}("853c80ef-3c37-49fd-aa49-938b674adae6");
+const boost::uuids::uuid DINNERBONE = boost::uuids::string_generator{}("61699b2e-d327-4a01-9f1e-0ea8c3f06bc6");
+
+JavaStatusView status(std::string_view sample, int online = 3) {
+	const std::string json = R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":)" +
+	                         std::to_string(online) + std::string{sample} + "}}";
+	return JavaStatusView::try_parse(json).value();
+}
+
+constexpr std::string_view NOTCH_AND_JEB{
+    R"(,"sample":[{"name":"Notch","id":"069a79f4-44e9-4726-a5be-fca90e38aaf5"},)"
+    R"({"name":"jeb_","id":"853c80ef-3c37-49fd-aa49-938b674adae6"}])"};
+constexpr std::string_view JEB_AND_DINNERBONE{
+    R"(,"sample":[{"name":"jeb_","id":"853c80ef-3c37-49fd-aa49-938b674adae6"},)"
+    R"({"name":"Dinnerbone","id":"61699b2e-d327-4a01-9f1e-0ea8c3f06bc6"},)"
+    R"({"name":"§6Welcome!","id":"00000000-0000-0000-0000-000000000000"}])"};
+
+}  // namespace
+
+TEST(PlayerTrackerTest, FirstSampleIsAllJoins) {
+	PlayerTracker tracker;
+
+	const std::vector<PlayerEvent> events = tracker.update("a", status(NOTCH_AND_JEB));
+
+	ASSERT_EQ(events.size(), 2u);
+	EXPECT_EQ(events[0].type, PlayerEvent::Type::join);
+	EXPECT_EQ(events[0].id, NOTCH);
+	EXPECT_EQ(events[0].name, "Notch");
+	EXPECT_EQ(events[1].id, JEB);
+	EXPECT_EQ(tracker.size(), 1u);
+}
+
+TEST(PlayerTrackerTest, ReportsJoinsAndLeaves) {
+	PlayerTracker tracker;
+	std::ignore = tracker.update("a", status(NOTCH_AND_JEB));
+
+	EXPECT_TRUE(tracker.update("a", status(NOTCH_AND_JEB)).empty());
+
+	// The nil UUID of the text line is no player
+	const std::vector<PlayerEvent> events = tracker.update("a", status(JEB_AND_DINNERBONE));
+
+	ASSERT_EQ(events.size(), 2u);
+	EXPECT_EQ(events[0].type, PlayerEvent::Type::join);
+	EXPECT_EQ(events[0].id, DINNERBONE);
+	EXPECT_EQ(events[0].name, "Dinnerbone");
+	EXPECT_EQ(events[1].type, PlayerEvent::Type::leave);
+	EXPECT_EQ(events[1].id, NOTCH);
+	EXPECT_TRUE(events[1].name.empty());
+}
+
+TEST(PlayerTrackerTest, MissingSample) {
+	PlayerTracker tracker;
+	std::ignore = tracker.update("a", status(NOTCH_AND_JEB));
+
+	// Players are online, but the server doesn't tell who
+	EXPECT_TRUE(tracker.update("a", status("", 2)).empty());
+
+	const std::vector<PlayerEvent> events = tracker.update("a", status("", 0));
+	ASSERT_EQ(events.size(), 2u);
+	EXPECT_EQ(events[0].type, PlayerEvent::Type::leave);
+	EXPECT_EQ(events[1].type, PlayerEvent::Type::leave);
+	EXPECT_EQ(tracker.memory_usage(), 0u);
+}
+
+TEST(PlayerTrackerTest, EndpointsAreIndependent) {
+	PlayerTracker tracker;
+	std::ignore = tracker.update("a", status(NOTCH_AND_JEB));
+
+	EXPECT_EQ(tracker.update("b", status(NOTCH_AND_JEB)).size(), 2u);
+	EXPECT_TRUE(tracker.update("a", status(NOTCH_AND_JEB)).empty());
+
+	tracker.forget("a");
+	EXPECT_EQ(tracker.size(), 1u);
+	EXPECT_EQ(tracker.update("a", status(NOTCH_AND_JEB)).size(), 2u);
+}
+
+TEST(PlayerTrackerTest, AcceptsParsedStatus) {
+	PlayerTracker tracker;
+	JavaServer::JavaServerResponse response;
+	response.players->online = 1;
+	response.players->sample.emplace().push_back({"Notch", NOTCH});
+
+	const std::vector<PlayerEvent> events = tracker.update("a", response);
+
+	ASSERT_EQ(events.size(), 1u);
+	EXPECT_EQ(events[0].name, "Notch");
+	EXPECT_EQ(tracker.update("a", status(NOTCH_AND_JEB)).size(), 1u);  // jeb_ joined
+}
@@ -0,0 +1,172 @@
+#include "libmcstatus/ResultStore.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "libmcstatus/JavaServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+namespace {
+
+using JavaServerResponse = JavaServer::JavaServerResponse;
+
+JavaServerResponse status(std::string version, std::int64_t online, std::optional<std::string> icon = std::nullopt) {
+	JavaServerResponse response;
+	response.version->name = std::move(version);
+	response.version->protocol = 765;
+	response.players->online = online;
+	response.players->max = 500;
+	response.motd = "A Minecraft Server";
+	response.latency = 42ms;
+	response.icon = std::move(icon);
+	return response;
+}
+
+class ResultStoreTest : public testing::Test {
+protected:
+	const std::filesystem::path path{std::filesystem::temp_directory_path() /
+	                                 ("libmcstatus-test-" + std::to_string(getpid()) + ".store")};
+	const std::chrono::system_clock::time_point time{std::chrono::sys_days{std::chrono::year{2024} / 1 / 2} + 3h};
+
+	void SetUp() override {
+		std::filesystem::remove(path);
+	}
+	void TearDown() override {
+		std::filesystem::remove(path);
+	}
+
+	void write_sample() const {
+		ResultStoreWriter writer;
+		writer.append("a.example:25565", time, status("Paper 1.20.4", 150, "data:image/png;base64,AAAA"));
+		writer.append("b.example:25565", time + 1s, status("Velocity 3.3.0", 12));
+		writer.append("c.example:25565", time + 2s, status("Paper 1.20.4", 101, "data:image/png;base64,AAAA"));
+		ASSERT_EQ(writer.size(), 3u);
+
+		writer.write(path);
+	}
+
+	// Overwrites part of the written file
+	void patch(std::size_t offset, std::string_view bytes) const {
+		std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+		file.seekp(static_cast<std::streamoff>(offset));
+		file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+};
+
+}  // namespace
+
+TEST_F(ResultStoreTest, RoundTripsResults) {
+	write_sample();
+	const auto store = ResultStore::try_open(path);
+
+	ASSERT_TRUE(store.has_value());
+	ASSERT_EQ(store->size(), 3u);
+
+	const StoredResult first = (*store)[0];
+	EXPECT_EQ(first.endpoint, "a.example:25565");
+	EXPECT_EQ(first.time, time);
+	EXPECT_EQ(first.latency, 42ms);
+	EXPECT_EQ(first.online, 150);
+	EXPECT_EQ(first.max, 500);
+	EXPECT_EQ(first.protocol, 765);
+	EXPECT_EQ(first.version_name, "Paper 1.20.4");
+	EXPECT_EQ(first.motd, "A Minecraft Server");
+	EXPECT_EQ(first.icon, "data:image/png;base64,AAAA");
+
+	const StoredResult second = (*store)[1];
+	EXPECT_EQ(second.endpoint, "b.example:25565");
+	EXPECT_EQ(second.time, time + 1s);
+	EXPECT_EQ(second.version_name, "Velocity 3.3.0");
+	EXPECT_FALSE(second.icon.has_value());
+}
+
+TEST_F(ResultStoreTest, DeduplicatesStrings) {
+	write_sample();
+	const auto store = ResultStore::try_open(path);
+	ASSERT_TRUE(store.has_value());
+
+	EXPECT_EQ(store->version_count(), 2u);
+	EXPECT_EQ(store->motd_count(), 1u);
+	EXPECT_EQ(store->icon_count(), 1u);
+	EXPECT_EQ(store->version_ids()[0], store->version_ids()[2]);
+	EXPECT_EQ(store->icon_ids()[1], ResultStore::NO_ICON);
+}
+
+TEST_F(ResultStoreTest, FiltersSingleColumns) {
+	write_sample();
+	const auto store = ResultStore::try_open(path);
+	ASSERT_TRUE(store.has_value());
+
+	EXPECT_EQ(ResultStore::filter(store->online(), [](std::int64_t online) { return online > 100; }),
+	          (std::vector<std::size_t>{0, 2}));
+
+	const std::optional<std::uint32_t> velocity = store->find_version("Velocity 3.3.0");
+	ASSERT_TRUE(velocity.has_value());
+	EXPECT_EQ(ResultStore::filter(store->version_ids(), [&](std::uint32_t id) { return id == *velocity; }),
+	          (std::vector<std::size_t>{1}));
+	EXPECT_FALSE(store->find_version("Spigot").has_value());
+}
+
+TEST_F(ResultStoreTest, StoresNothing) {
+	ResultStoreWriter{}.write(path);
+	const auto store = ResultStore::try_open(path);
+
+	ASSERT_TRUE(store.has_value());
+	EXPECT_EQ(store->size(), 0u);
+	EXPECT_TRUE(store->online().empty());
+	EXPECT_EQ(store->version_count(), 0u);
+}
+
+TEST_F(ResultStoreTest, SurvivesMoves) {
+	write_sample();
+	auto store = ResultStore::try_open(path);
+	ASSERT_TRUE(store.has_value());
+
+	ResultStore moved = std::move(*store);
+	EXPECT_EQ(moved.endpoint(2), "c.example:25565");
+	EXPECT_EQ(store->size(), 0u);
+}
+
+TEST_F(ResultStoreTest, RejectsBrokenFiles) {
+	EXPECT_EQ(ResultStore::try_open(path).error(), McError::bad_frame);
+
+	write_sample();
+	const std::uintmax_t size = std::filesystem::file_size(path);
+
+	std::filesystem::resize_file(path, size - 1);
+	EXPECT_FALSE(ResultStore::try_open(path).has_value());
+
+	write_sample();
+	patch(0, "NOSTORE");
+	EXPECT_FALSE(ResultStore::try_open(path).has_value());
+
+	// Row count that doesn't match the columns
+	write_sample();
+	patch(ResultStore::MAGIC.size(), "\x04");
+	EXPECT_FALSE(ResultStore::try_open(path).has_value());
+
+	// Version id out of range, at the offset in the section table
+	write_sample();
+	std::uint64_t version_ids = 0;
+	{
+		const auto section = static_cast<std::size_t>(_impl::StoreSection::version_ids);
+		const std::size_t entry = section * 2 * sizeof(std::uint64_t);
+		std::ifstream file{path, std::ios::binary};
+		file.seekg(static_cast<std::streamoff>(ResultStore::MAGIC.size() + sizeof(std::uint64_t) + entry));
+		file.read(reinterpret_cast<char*>(&version_ids), sizeof(version_ids));
+	}
+	patch(static_cast<std::size_t>(version_ids), "\x09");
+	EXPECT_FALSE(ResultStore::try_open(path).has_value());
+
+	write_sample();
+	EXPECT_TRUE(ResultStore::try_open(path).has_value());
+}
@@ -0,0 +1,285 @@
+#include "libmcstatus/RetryPolicy.hpp"
+
+#include <gtest/gtest.h>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/system_error.hpp>
+#include <atomic>
+#include <chrono>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "MemoryServer.hpp"
+#include "StubServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+TEST(McErrorSetTest, InsertEraseContains) {
+	McErrorSet set{McError::timeout, McError::bad_frame};
+
+	EXPECT_TRUE(set.contains(McError::timeout));
+	EXPECT_TRUE(set.contains(McError::bad_frame));
+	EXPECT_FALSE(set.contains(McError::connection_refused));
+
+	set.insert(McError::connection_refused).erase(McError::timeout);
+	EXPECT_TRUE(set.contains(McError::connection_refused));
+	EXPECT_FALSE(set.contains(McError::timeout));
+
+	EXPECT_TRUE(McErrorSet::all().contains(McError::unknown));
+	EXPECT_FALSE(McErrorSet{}.contains(McError::unknown));
+}
+
+TEST(RetryPolicyTest, ShouldRetry) {
+	const RetryPolicy policy{.max_attempts = 3};
+
+	EXPECT_TRUE(policy.should_retry(1, McError::timeout));
+	EXPECT_TRUE(policy.should_retry(2, McError::connection_reset));
+	EXPECT_FALSE(policy.should_retry(3, McError::timeout));  // Out of attempts
+	EXPECT_FALSE(policy.should_retry(1, McError::connection_refused));
+	EXPECT_FALSE(policy.should_retry(1, McError::bad_json));
+	EXPECT_FALSE(policy.should_retry(1, McError::bad_frame));
+
+	EXPECT_FALSE(RetryPolicy{.max_attempts = 0}.should_retry(1, McError::timeout));
+}
+
+TEST(RetryPolicyTest, BackoffWithoutJitterIsExponentialAndCapped) {
+	const RetryPolicy policy{.initial_backoff = 10ms, .max_backoff = 50ms, .backoff_multiplier = 2.0, .jitter = 0.0};
+
+	EXPECT_EQ(policy.backoff(1), 10ms);
+	EXPECT_EQ(policy.backoff(2), 20ms);
+	EXPECT_EQ(policy.backoff(3), 40ms);
+	EXPECT_EQ(policy.backoff(4), 50ms);
+	EXPECT_EQ(policy.backoff(10), 50ms);
+}
+
+TEST(RetryPolicyTest, BackoffJitterStaysInRange) {
+	const RetryPolicy policy{.initial_backoff = 100ms, .max_backoff = 100ms, .jitter = 0.5};
+
+	for (int i = 0; i < 1000; ++i) {
+		const auto backoff = policy.backoff(1);
+		EXPECT_GE(backoff, 50ms);
+		EXPECT_LE(backoff, 100ms);
+	}
+}
+
+TEST(LatencyWindowTest, Percentiles) {
+	LatencyWindow window;
+	EXPECT_FALSE(window.percentile(0.5).has_value());
+
+	for (int i = 1; i <= 100; ++i) {
+		window.record(std::chrono::milliseconds{i});
+	}
+
+	EXPECT_EQ(window.size(), 100);
+	EXPECT_EQ(*window.percentile(0.0), 1ms);
+	EXPECT_EQ(*window.percentile(0.5), 50ms);
+	EXPECT_EQ(*window.percentile(1.0), 100ms);
+}
+
+TEST(LatencyWindowTest, KeepsOnlyMostRecentSamples) {
+	LatencyWindow window;
+
+	for (std::size_t i = 0; i < 2 * LatencyWindow::CAPACITY; ++i) {
+		window.record(i < LatencyWindow::CAPACITY ? 1000ms : 1ms);
+	}
+
+	EXPECT_EQ(window.size(), LatencyWindow::CAPACITY);
+	EXPECT_EQ(*window.percentile(1.0), 1ms);
+}
+
+TEST(HedgePolicyTest, DelayUsesInitialDelayUntilEnoughSamples) {
+	const HedgePolicy hedge{.percentile = 0.5, .initial_delay = 200ms, .min_samples = 3};
+	EXPECT_EQ(hedge.delay(), 200ms);
+
+	hedge.latencies->record(10ms);
+	hedge.latencies->record(20ms);
+	EXPECT_EQ(hedge.delay(), 200ms);
+
+	hedge.latencies->record(30ms);
+	EXPECT_EQ(hedge.delay(), 20ms);
+}
+
+// =====================================================================================================================
+
+namespace {
+
+boost::asio::ip::tcp::endpoint closed_endpoint() {
+	boost::asio::io_context io_context;
+	boost::asio::ip::tcp::acceptor acceptor{io_context, {boost::asio::ip::address_v4::loopback(), 0}};
+	return acceptor.local_endpoint();  // Nothing listens here once the acceptor is gone
+}
+
+// In-memory server whose first connection takes a while to report that it connected, even if it is closed meanwhile
+class SlowFirstConnectTransport : public Transport {
+private:
+	std::shared_ptr<const Transport> transport{memory_server::transport()};
+	mutable std::atomic_size_t connections{0};
+
+	class Connection : public Transport::Connection {
+	private:
+		std::unique_ptr<Transport::Connection> connection;
+		std::shared_ptr<std::atomic_size_t> writes;
+		std::optional<std::chrono::milliseconds> delay;
+
+	public:
+		Connection(std::unique_ptr<Transport::Connection> connection, std::shared_ptr<std::atomic_size_t> writes,
+		           std::optional<std::chrono::milliseconds> delay)
+		    : connection{std::move(connection)}, writes{std::move(writes)}, delay{delay} {}
+
+		// Connected before the delay, so closing the connection can't make it fail anymore
+		boost::asio::awaitable<std::expected<void, McError>> async_connect() override {
+			const std::expected<void, McError> connected = co_await connection->async_connect();
+			if (delay) {
+				boost::asio::steady_timer timer{co_await boost::asio::this_coro::executor, *delay};
+				co_await timer.async_wait(boost::asio::use_awaitable);
+			}
+			co_return connected;
+		}
+		boost::asio::awaitable<std::expected<std::size_t, McError>> async_read_some(
+		    boost::asio::mutable_buffer buffer) override {
+			co_return co_await connection->async_read_some(buffer);
+		}
+		boost::asio::awaitable<std::expected<void, McError>> async_write(boost::asio::const_buffer buffer) override {
+			++*writes;
+			co_return co_await connection->async_write(buffer);
+		}
+		void close() override {
+			connection->close();
+		}
+	};
+
+public:
+	// Of the first connection
+	const std::shared_ptr<std::atomic_size_t> first_writes{std::make_shared<std::atomic_size_t>(0)};
+
+	[[nodiscard]] std::unique_ptr<Transport::Connection> connection(
+	    const boost::asio::any_io_executor& executor) const override {
+		const bool first = connections++ == 0;
+		return std::make_unique<Connection>(transport->connection(executor),
+		                                    first ? first_writes : std::make_shared<std::atomic_size_t>(0),
+		                                    first ? std::optional{100ms} : std::nullopt);
+	}
+	[[nodiscard]] std::string host() const override {
+		return transport->host();
+	}
+	[[nodiscard]] boost::asio::ip::port_type port() const override {
+		return transport->port();
+	}
+	[[nodiscard]] std::string to_string() const override {
+		return transport->to_string();
+	}
+};
+
+McError query_error(const JavaServer& server, std::chrono::milliseconds timeout, const RetryPolicy& policy) {
+	try {
+		std::ignore = server.status(timeout, policy);
+	} catch (const boost::system::system_error& error) {
+		return classify_error(error.code());
+	}
+
+	return McError{};
+}
+
+}  // namespace
+
+TEST(RetryPolicyQueryTest, RefusedConnectionIsNotRetriedByDefault) {
+	const JavaServer server{closed_endpoint()};
+	const RetryPolicy policy{.max_attempts = 5, .initial_backoff = 500ms, .jitter = 0.0};
+
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_EQ(query_error(server, 1000ms, policy), McError::connection_refused);
+	EXPECT_LT(std::chrono::steady_clock::now() - start, 400ms);
+}
+
+TEST(RetryPolicyQueryTest, RetryableErrorsBackOff) {
+	const JavaServer server{closed_endpoint()};
+	const RetryPolicy policy{
+	    .max_attempts = 3, .initial_backoff = 50ms, .jitter = 0.0, .retryable = McErrorSet::all()};
+
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_EQ(query_error(server, 1000ms, policy), McError::connection_refused);
+	EXPECT_GE(std::chrono::steady_clock::now() - start, 150ms);  // 50ms + 100ms
+}
+
+TEST(RetryPolicyQueryTest, TimeoutCutsAttemptShort) {
+	StubServer stub{std::string{StubServer::DEFAULT_STATUS}, [](std::size_t) { return 10s; }};
+	const JavaServer server{stub.endpoint()};
+
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_EQ(query_error(server, 100ms, RetryPolicy{.max_attempts = 2, .initial_backoff = 0ms}), McError::timeout);
+	EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+	EXPECT_EQ(stub.connections(), 2);
+}
+
+TEST(RetryPolicyQueryTest, HedgedAttemptWinsOverSlowOne) {
+	// Only the very first connection is slow
+	StubServer stub{std::string{StubServer::DEFAULT_STATUS},
+	                [](std::size_t connection) { return (connection == 0) ? 5s : 0s; }};
+	const JavaServer server{stub.endpoint()};
+	const RetryPolicy policy{.max_attempts = 1, .hedge = HedgePolicy{.initial_delay = 50ms}};
+
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_GE(server.ping(10s, policy), McServer::latency_t::zero());
+	EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+	EXPECT_EQ(stub.connections(), 2);
+	EXPECT_EQ(policy.hedge->latencies->size(), 1);
+}
+
+TEST(RetryPolicyQueryTest, FastResponseNeedsNoHedge) {
+	StubServer stub;
+	const JavaServer server{stub.endpoint()};
+	const RetryPolicy policy{.hedge = HedgePolicy{.initial_delay = 5s}};
+
+	EXPECT_EQ(server.status(1s, policy)->version->name, "1.20.4");
+	EXPECT_EQ(stub.connections(), 1);
+}
+
+TEST(RetryPolicyQueryTest, AdaptiveTimeoutDetectsStalledServerEarly) {
+	// Answers right away at first, then stalls
+	StubServer stub{std::string{StubServer::DEFAULT_STATUS},
+	                [](std::size_t connection) { return (connection < 5) ? 0s : 10s; }};
+	const JavaServer server{stub.endpoint()};
+	const RetryPolicy policy{.max_attempts = 1, .adaptive_timeout = TimeoutPolicy{.min_timeout = 50ms}};
+
+	for (int i = 0; i < 5; ++i) {
+		EXPECT_GE(server.ping(5s, policy), McServer::latency_t::zero());
+	}
+	const std::string endpoint = server.get_transport()->to_string();
+	const std::optional<RttEstimator> estimator = policy.adaptive_timeout->rtts->get(endpoint);
+	ASSERT_TRUE(estimator.has_value());
+	EXPECT_LT(estimator->srtt(), 50ms);
+
+	// Loopback round trips are well below the floor, so that's the timeout instead of the 5s asked for
+	const auto start = std::chrono::steady_clock::now();
+	EXPECT_EQ(query_error(server, 5s, policy), McError::timeout);
+	EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+	EXPECT_EQ(policy.adaptive_timeout->rtts->get(endpoint)->timeouts(), 1u);
+}
+
+TEST(RetryPolicyQueryTest, HedgeLoserConnectingLateIsDropped) {
+	const auto transport = std::make_shared<SlowFirstConnectTransport>();
+	boost::asio::io_context io_context;
+	std::optional<McServer::result_t<JavaServer::RawStatus>> result;
+
+	// The server only lives as long as the query, while the first attempt connects long after the hedge won
+	const auto query = [&]() -> boost::asio::awaitable<void> {
+		const JavaServer server{transport};
+		result = co_await server.async_try_status_raw(
+		    5s, RetryPolicy{.max_attempts = 1, .hedge = HedgePolicy{.initial_delay = 10ms}});
+	};
+	boost::asio::co_spawn(io_context, query(), boost::asio::detached);
+	io_context.run();
+
+	ASSERT_TRUE(result.has_value());
+	ASSERT_TRUE(result->has_value()) << to_string(result->error());
+	EXPECT_EQ(*transport->first_writes, 0u);
+}
@@ -0,0 +1,83 @@
+#include "libmcstatus/RttEstimator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+TEST(RttEstimatorTest, FirstSample) {
+	RttEstimator estimator;
+	EXPECT_FALSE(estimator.has_samples());
+	EXPECT_EQ(estimator.timeout(10ms, 3s), 3s);
+
+	estimator.sample(100ms);
+
+	EXPECT_TRUE(estimator.has_samples());
+	EXPECT_EQ(estimator.srtt(), 100ms);
+	EXPECT_EQ(estimator.rttvar(), 50ms);
+	EXPECT_EQ(estimator.timeout(10ms, 3s), 300ms);  // 100ms + 4 * 50ms
+}
+
+TEST(RttEstimatorTest, SmoothsSamples) {
+	RttEstimator estimator;
+	estimator.sample(100ms);
+	estimator.sample(180ms);
+
+	// RTTVAR = 3/4 * 50ms + 1/4 * 80ms, SRTT = 7/8 * 100ms + 1/8 * 180ms
+	EXPECT_EQ(estimator.rttvar(), 57500us);
+	EXPECT_EQ(estimator.srtt(), 110ms);
+
+	// Steady round trip times make the variation decay, down to the floor eventually
+	for (int i = 0; i < 100; ++i) {
+		estimator.sample(110ms);
+	}
+	EXPECT_LT(estimator.rttvar(), 1ms);
+	EXPECT_EQ(estimator.timeout(200ms, 3s), 200ms);
+	EXPECT_EQ(estimator.timeout(10ms, 3s), 111ms);
+}
+
+TEST(RttEstimatorTest, TimeoutsBackOff) {
+	RttEstimator estimator;
+	estimator.sample(100ms);
+
+	estimator.timed_out();
+	EXPECT_EQ(estimator.timeout(10ms, 3s), 600ms);
+	estimator.timed_out();
+	EXPECT_EQ(estimator.timeout(10ms, 3s), 1200ms);
+
+	for (int i = 0; i < 100; ++i) {
+		estimator.timed_out();
+	}
+	EXPECT_EQ(estimator.timeout(10ms, 3s), 3s);
+	EXPECT_EQ(estimator.timeouts(), 102u);
+
+	// The next sample ends the backoff
+	estimator.sample(100ms);
+	EXPECT_EQ(estimator.timeouts(), 0u);
+	EXPECT_LT(estimator.timeout(10ms, 3s), 600ms);
+}
+
+TEST(RttTableTest, PerEndpoint) {
+	RttTable table;
+	EXPECT_EQ(table.timeout("a", 10ms, 3s), 3s);
+
+	table.sample("a", 10ms);
+	table.sample("b", 1s);
+
+	EXPECT_EQ(table.size(), 2u);
+	EXPECT_EQ(table.timeout("a", 10ms, 3s), 30ms);
+	EXPECT_EQ(table.timeout("b", 10ms, 5s), 3s);
+	EXPECT_EQ(table.timeout("b", 10ms, 2s), 2s);
+	EXPECT_EQ(table.timeout("c", 10ms, 3s), 3s);
+	ASSERT_TRUE(table.get("a").has_value());
+	EXPECT_EQ(table.get("a")->srtt(), 10ms);
+
+	table.timed_out("a");
+	EXPECT_EQ(table.get("a")->timeouts(), 1u);
+
+	table.forget("a");
+	EXPECT_FALSE(table.get("a").has_value());
+	EXPECT_EQ(table.size(), 1u);
+}
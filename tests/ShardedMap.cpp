@@ -0,0 +1,75 @@
+#include "libmcstatus/impl/ShardedMap.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace libmcstatus::_impl;
+
+TEST(ShardedMapTest, PutGetErase) {
+	ShardedMap<int> map;
+	EXPECT_FALSE(map.get("a").has_value());
+
+	map.put("a", 1);
+	map.put("b", 2);
+	map.put("a", 3);
+
+	EXPECT_EQ(map.get("a"), 3);
+	EXPECT_EQ(map.get("b"), 2);
+	EXPECT_EQ(map.size(), 2u);
+
+	map.erase("a");
+	map.erase("missing");
+	EXPECT_FALSE(map.get("a").has_value());
+	EXPECT_EQ(map.size(), 1u);
+}
+
+TEST(ShardedMapTest, WithDefaultConstructs) {
+	ShardedMap<std::vector<int>> map;
+
+	map.with("a", [](std::vector<int>& values) { values.push_back(1); });
+	const std::size_t size = map.with("a", [](std::vector<int>& values) {
+		values.push_back(2);
+		return values.size();
+	});
+
+	EXPECT_EQ(size, 2u);
+	EXPECT_EQ(map.get("a"), (std::vector<int>{1, 2}));
+}
+
+TEST(ShardedMapTest, ForEach) {
+	ShardedMap<int> map;
+	for (int i = 0; i < 100; ++i) {
+		map.put(std::to_string(i), i);
+	}
+
+	int sum = 0;
+	map.for_each([&](const std::string& key, int value) {
+		EXPECT_EQ(key, std::to_string(value));
+		sum += value;
+	});
+	EXPECT_EQ(sum, 4950);
+}
+
+TEST(ShardedMapTest, Concurrent) {
+	ShardedMap<int> map;
+	std::vector<std::thread> threads;
+
+	for (int thread = 0; thread < 4; ++thread) {
+		threads.emplace_back([&] {
+			for (int i = 0; i < 1000; ++i) {
+				map.with(std::to_string(i % 50), [](int& value) { ++value; });
+			}
+		});
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	EXPECT_EQ(map.size(), 50u);
+	int sum = 0;
+	map.for_each([&](const std::string&, int value) { sum += value; });
+	EXPECT_EQ(sum, 4000);
+}
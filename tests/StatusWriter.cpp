@@ -0,0 +1,153 @@
+#include "libmcstatus/StatusWriter.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <array>
+#include <boost/uuid/string_generator.hpp>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/JavaStatusView.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+namespace {
+
+constexpr std::string_view STATUS =
+    R"({"version":{"name":"Paper 1.20.4","protocol":765},)"
+    R"("players":{"max":100,"online":2,"sample":[{"name":"Notch","id":"069a79f4-44e9-4726-a5be-fca90e38aaf5"}]},)"
+    R"("description":{"text":"Hello","extra":[{"text":" world","bold":true}]},"enforcesSecureChat":true,)"
+    R"("favicon":"data:image/png;base64,AAAA","forgeData":{"fmlNetworkVersion":3}})";
+
+}  // namespace
+
+TEST(StatusWriterTest, WritesResponsesTheParserCanRead) {
+	auto status = JavaServer::try_parse_status(JavaServer::RawStatus{
+	    .latency = 1500us, .buffer = {STATUS.begin(), STATUS.end()}, .size = STATUS.size()});
+	ASSERT_TRUE(status.has_value());
+
+	std::string output;
+	StatusWriter{output}.write("mc.example:25565", **status);
+
+	ASSERT_TRUE(output.ends_with("}\n"));
+	EXPECT_EQ(output.find('\n'), output.size() - 1);
+	EXPECT_TRUE(
+	    output.starts_with(R"({"endpoint":"mc.example:25565","version":{"name":"Paper 1.20.4","protocol":765})"));
+	EXPECT_NE(output.find(R"("latency_us":1500})"), std::string::npos);
+
+	const auto parsed = JavaStatusView::try_parse(output);
+	ASSERT_TRUE(parsed.has_value()) << output;
+	EXPECT_EQ(parsed->version_name, "Paper 1.20.4");
+	EXPECT_EQ(parsed->online, 2);
+	EXPECT_EQ(parsed->max, 100);
+	ASSERT_EQ(parsed->sample->size(), 1u);
+	EXPECT_EQ((*parsed->sample)[0].name, "Notch");
+	EXPECT_EQ((*parsed->sample)[0].id, boost::uuids::string_generator{}("069a79f4-44e9-4726-a5be-fca90e38aaf5"));
+	EXPECT_EQ(parsed->description, (*status)->motd);
+	EXPECT_EQ(parsed->enforces_secure_chat, true);
+	EXPECT_EQ(parsed->icon, "data:image/png;base64,AAAA");
+	EXPECT_EQ(parsed->forge_data, R"({"fmlNetworkVersion":3})");
+}
+
+TEST(StatusWriterTest, WritesViewsLikeResponses) {
+	auto view = JavaStatusView::try_parse(STATUS);
+	auto response = JavaServer::try_parse_status(JavaServer::RawStatus{
+	    .latency = 0ns, .buffer = {STATUS.begin(), STATUS.end()}, .size = STATUS.size()});
+	ASSERT_TRUE(view.has_value());
+	ASSERT_TRUE(response.has_value());
+	view->latency = 0ns;
+
+	std::string from_view;
+	std::string from_response;
+	StatusWriter{from_view}.write("a", *view);
+	StatusWriter{from_response}.write("a", **response);
+
+	EXPECT_EQ(from_view, from_response);
+}
+
+TEST(StatusWriterTest, EscapesStrings) {
+	JavaServer::JavaServerResponse status;
+	status.version->name = "a\"b\\c\n\t\x01\x1F long enough for the vectorized scan é😀";
+	status.motd = "{not json";
+
+	std::string output;
+	StatusWriter{output, {StatusField::version, StatusField::description}}.write("e", status);
+
+	EXPECT_EQ(output, R"({"endpoint":"e","version":{"name":"a\"b\\c\n\t\u0001\u001f long enough for the vectorized )"
+	                  R"(scan é😀","protocol":-1},"description":"{not json"})"
+	                  "\n");
+
+	std::string full;
+	StatusWriter{full}.write("e", status);
+	const auto parsed = JavaStatusView::try_parse(full);
+	ASSERT_TRUE(parsed.has_value()) << full;
+	EXPECT_EQ(parsed->version_name, status.version->name);
+}
+
+TEST(StatusWriterTest, WritesOnlySelectedFields) {
+	const auto status = JavaStatusView::try_parse(STATUS);
+	ASSERT_TRUE(status.has_value());
+
+	std::string output;
+	StatusWriter writer{output, {StatusField::sample}};
+	writer.write("a", *status);
+	writer.write("b", McError::timeout);
+
+	EXPECT_EQ(output,
+	          R"({"endpoint":"a","players":{"sample":[{"name":"Notch","id":"069a79f4-44e9-4726-a5be-fca90e38aaf5"}]}})"
+	          "\n"
+	          R"({"endpoint":"b","error":"timeout"})"
+	          "\n");
+}
+
+TEST(StatusWriterTest, PutsRawJsonOnOneLine) {
+	const auto status = JavaStatusView::try_parse(
+	    "{\"version\":{\"name\":\"1\",\"protocol\":1},\"players\":{\"max\":1,\"online\":0},\n"
+	    "\"forgeData\": {\n\t\"mods\": [ \"a b\" ]\n}, \"description\": \"x\"}");
+	ASSERT_TRUE(status.has_value());
+
+	std::string output;
+	StatusWriter{output, {StatusField::description, StatusField::forge_data}}.write("a", *status);
+
+	EXPECT_EQ(output, R"({"endpoint":"a","description":"x","forgeData":{"mods":["a b"]}})"
+	                  "\n");
+}
+
+TEST(StatusWriterTest, WritesToStreamsAndFileDescriptors) {
+	JavaServer::JavaServerResponse status;
+	std::string expected;
+	StatusWriter{expected}.write("a", status);
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+	{
+		StatusWriter writer{file};
+		writer.write("a", status);
+	}
+	std::rewind(file);
+	std::array<char, 256> contents{};
+	EXPECT_EQ(std::string_view(contents.data(), std::fread(contents.data(), 1, contents.size(), file)), expected);
+	std::fclose(file);
+
+	std::array<int, 2> pipe_fds{};
+	ASSERT_EQ(pipe(pipe_fds.data()), 0);
+	{
+		StatusWriter writer{pipe_fds[1]};
+		writer.write("a", status);
+		writer.flush();
+	}
+	close(pipe_fds[1]);
+	const ssize_t size = read(pipe_fds[0], contents.data(), contents.size());
+	close(pipe_fds[0]);
+	EXPECT_EQ(std::string_view(contents.data(), static_cast<std::size_t>(size)), expected);
+
+	StatusWriter closed{-1};
+	closed.write("a", status);
+	EXPECT_THROW(closed.flush(), std::system_error);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "libmcstatus/McPacket.hpp"
+
+// Minimal in-process Minecraft server that answers status and ping requests on localhost
+class StubServer {
+public:
+	// Delay before answering any request on the connection with the given (0-based) index
+	using response_delay_t = std::function<std::chrono::milliseconds(std::size_t connection)>;
+
+	static constexpr std::string_view DEFAULT_STATUS{
+	    R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":0},)"
+	    R"("description":"A Minecraft Server"})"};
+
+	explicit StubServer(std::string status_json = std::string{DEFAULT_STATUS}, response_delay_t response_delay = {})
+	    : status_json{std::move(status_json)},
+	      response_delay{std::move(response_delay)},
+	      acceptor{io_context, {boost::asio::ip::address_v4::loopback(), 0}},
+	      io_thread{[this] {
+		      boost::asio::co_spawn(io_context, accept_loop(), boost::asio::detached);
+		      io_context.run();
+	      }} {}
+
+	~StubServer() {
+		io_context.stop();
+		io_thread.join();
+	}
+
+	StubServer(const StubServer&) = delete;
+	StubServer& operator=(const StubServer&) = delete;
+
+	[[nodiscard]] boost::asio::ip::tcp::endpoint endpoint() const {
+		return acceptor.local_endpoint();
+	}
+
+	[[nodiscard]] std::size_t connections() const {
+		return connection_count.load();
+	}
+
+private:
+	std::string status_json;
+	response_delay_t response_delay;
+	std::atomic_size_t connection_count{0};
+	boost::asio::io_context io_context;
+	boost::asio::ip::tcp::acceptor acceptor;
+	std::thread io_thread;
+
+	// Returns the size of the first complete frame in the buffer (length prefix included), if there is one
+	static std::optional<std::size_t> frame_size(const libmcstatus::McPacket::buffer_t& buffer) {
+		std::uint32_t length = 0;
+
+		for (std::size_t i = 0; (i < 5) && (i < buffer.size()); ++i) {
+			length |= static_cast<std::uint32_t>(buffer[i] & 0x7F) << (7 * i);
+
+			if ((buffer[i] & 0x80) == 0) {
+				const std::size_t size = i + 1 + length;
+				return (buffer.size() >= size) ? std::optional{size} : std::nullopt;
+			}
+		}
+
+		return std::nullopt;
+	}
+
+	boost::asio::awaitable<void> accept_loop() {
+		while (true) {
+			boost::asio::ip::tcp::socket socket = co_await acceptor.async_accept(boost::asio::use_awaitable);
+			const std::size_t connection = connection_count++;
+			const std::chrono::milliseconds delay =
+			    response_delay ? response_delay(connection) : std::chrono::milliseconds{0};
+			boost::asio::co_spawn(io_context, session(std::move(socket), delay), boost::asio::detached);
+		}
+	}
+
+	boost::asio::awaitable<void> session(boost::asio::ip::tcp::socket socket, std::chrono::milliseconds delay) {
+		libmcstatus::McPacket::buffer_t buffer;
+		std::uint8_t chunk[4096];
+		bool handshake_done = false;
+
+		while (true) {
+			std::optional<std::size_t> size;
+
+			while (!(size = frame_size(buffer))) {
+				const std::size_t read =
+				    co_await socket.async_read_some(boost::asio::buffer(chunk), boost::asio::use_awaitable);
+				buffer.insert(buffer.end(), chunk, chunk + read);
+			}
+
+			libmcstatus::McPacket request = libmcstatus::McPacket::read_from_buffer(
+			    libmcstatus::McPacket::buffer_t{buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(*size)});
+			buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(*size));
+
+			const std::int32_t packet_id = request.read_varint();
+			libmcstatus::McPacket response;
+
+			if (!handshake_done) {
+				handshake_done = true;
+				continue;
+			} else if (packet_id == 0) {
+				response.write_varint(0);
+				response.write_utf(status_json);
+			} else if (packet_id == 1) {
+				response.write_varint(1);
+				response.write_long(request.read_long());
+			} else {
+				co_return;
+			}
+
+			if (delay.count() > 0) {
+				boost::asio::steady_timer timer{socket.get_executor(), delay};
+				co_await timer.async_wait(boost::asio::use_awaitable);
+			}
+
+			co_await boost::asio::async_write(socket, boost::asio::buffer(response.write_to_buffer()),
+			                                  boost::asio::use_awaitable);
+		}
+	}
+};
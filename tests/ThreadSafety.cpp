@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libmcstatus/ChangeDetector.hpp"
+#include "libmcstatus/impl/SrvResolver.hpp"
+#include "libmcstatus/InternPool.hpp"
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/Monitor.hpp"
+#include "libmcstatus/Motd.hpp"
+#include "libmcstatus/PlayerTracker.hpp"
+#include "StubServer.hpp"
+
+using namespace libmcstatus;
+
+// These tests are meant to be run with -DLIBMCSTATUS_ENABLE_TSAN=ON, where any data race fails the test run. Without
+// TSan they still check that concurrent queries all succeed and return correct results.
+
+namespace {
+
+const std::size_t num_threads = std::max(4u, std::thread::hardware_concurrency());
+constexpr int iterations = 25;
+
+template <typename Func>
+void run_concurrently(Func func) {
+	std::vector<std::thread> threads;
+	threads.reserve(num_threads);
+
+	for (std::size_t i = 0; i < num_threads; ++i) {
+		threads.emplace_back(func);
+	}
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+}
+
+}  // namespace
+
+TEST(ThreadSafetyTest, ConcurrentPingAndStatusOnSharedServer) {
+	StubServer stub;
+	const JavaServer server{stub.endpoint()};
+	std::atomic_size_t successes{0};
+
+	run_concurrently([&] {
+		for (int i = 0; i < iterations; ++i) {
+			EXPECT_GE(server.ping(), McServer::latency_t::zero());
+
+			const auto status = server.status();
+			EXPECT_EQ(status->version->name, "1.20.4");
+			EXPECT_EQ(status->version->protocol, 765);
+			EXPECT_EQ(status->players->max, 20);
+			EXPECT_EQ(status->motd, "A Minecraft Server");
+
+			++successes;
+		}
+	});
+
+	EXPECT_EQ(successes.load(), num_threads * iterations);
+	EXPECT_EQ(stub.connections(), 2 * num_threads * iterations);
+}
+
+TEST(ThreadSafetyTest, ConcurrentLookupAndQueries) {
+	StubServer stub;
+	const std::string address = "127.0.0.1:" + std::to_string(stub.endpoint().port());
+
+	run_concurrently([&] {
+		for (int i = 0; i < iterations; ++i) {
+			const JavaServer server = JavaServer::lookup(address);
+			EXPECT_EQ(server.to_string(), address);
+			EXPECT_EQ(server.status(McServer::DEFAULT_TIMEOUT, RetryPolicy{.max_attempts = 1})->players->online, 0);
+		}
+	});
+}
+
+TEST(ThreadSafetyTest, RetriesChangedWhileQuerying) {
+	StubServer stub;
+	const JavaServer server{stub.endpoint()};
+	std::atomic_bool done{false};
+
+	std::thread writer{[&] {
+		for (std::size_t i = 0; !done; ++i) {
+			McServer::RETRIES = 1 + (i % 5);
+		}
+	}};
+
+	run_concurrently([&] {
+		for (int i = 0; i < iterations; ++i) {
+			EXPECT_GE(server.ping(), McServer::latency_t::zero());
+		}
+	});
+
+	done = true;
+	writer.join();
+	McServer::RETRIES = 3;
+}
+
+TEST(ThreadSafetyTest, ConcurrentPickRecord) {
+	_impl::records_t records;
+	records.emplace(10, 10, 80, "server1.example.com");
+	records.emplace(10, 20, 443, "server2.example.com");
+	records.emplace(20, 30, 8080, "server3.example.com");
+
+	run_concurrently([&] {
+		for (int i = 0; i < 1000 * iterations; ++i) {
+			const _impl::SrvRecord& record = _impl::pick_record(records);
+			EXPECT_EQ(record.priority, 10);
+		}
+	});
+}
+
+TEST(ThreadSafetyTest, SharedChangeDetector) {
+	ChangeDetector detector;
+	std::atomic_size_t next_thread{0};
+
+	run_concurrently([&] {
+		const std::string own_endpoint = "server" + std::to_string(next_thread++);
+
+		for (int i = 0; i < iterations; ++i) {
+			const std::string json = R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":)" +
+			                         std::to_string(i) + "}}";
+			const JavaServer::RawStatus raw_status{.buffer = {json.begin(), json.end()}, .size = json.size()};
+
+			// One endpoint of its own and one that all threads share
+			const auto own = detector.update(own_endpoint, raw_status);
+			ASSERT_TRUE(own.has_value());
+			EXPECT_EQ(own->status->players->online, i);
+			EXPECT_TRUE(detector.update("shared", raw_status).has_value());
+		}
+	});
+
+	EXPECT_EQ(detector.size(), num_threads + 1);
+}
+
+TEST(ThreadSafetyTest, SharedPlayerTracker) {
+	PlayerTracker tracker;
+	std::atomic_size_t next_thread{0};
+
+	run_concurrently([&] {
+		const std::string own_endpoint = "server" + std::to_string(next_thread++);
+
+		for (int i = 0; i < iterations; ++i) {
+			// Everybody leaves and somebody else joins on every update
+			const auto status = JavaStatusView::try_parse(
+			    R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":1,"sample":[)"
+			    R"({"name":"Notch","id":"069a79f4-44e9-4726-a5be-fca90e38a)" +
+			    std::to_string(100 + i) + R"("}]}})");
+			ASSERT_TRUE(status.has_value());
+
+			EXPECT_EQ(tracker.update(own_endpoint, *status).size(), (i == 0) ? 1u : 2u);
+			std::ignore = tracker.update("shared", *status);
+		}
+	});
+
+	EXPECT_EQ(tracker.size(), num_threads + 1);
+}
+
+TEST(ThreadSafetyTest, SharedInternPool) {
+	InternPool pool;
+	std::atomic_size_t next_thread{0};
+
+	const InternPool::string_t shared = pool.intern("Paper 1.20.4");
+
+	run_concurrently([&] {
+		const std::string own_prefix = "thread" + std::to_string(next_thread++) + "-";
+
+		for (int i = 0; i < iterations; ++i) {
+			EXPECT_EQ(pool.intern("Paper 1.20.4"), shared);
+			EXPECT_EQ(*pool.intern(own_prefix + std::to_string(i % 10)), own_prefix + std::to_string(i % 10));
+			if (i % 50 == 0) {
+				std::ignore = pool.prune();
+			}
+		}
+	});
+
+	std::ignore = pool.prune();
+	EXPECT_EQ(pool.size(), 1u);
+}
+
+TEST(ThreadSafetyTest, SharedMotd) {
+	for (int i = 0; i < 20; ++i) {
+		// Every thread may be the first to parse
+		const Motd motd{R"({"text":"Hello","extra":[{"text":" world","color":"gold"}]})"};
+
+		run_concurrently([&] {
+			ASSERT_EQ(motd.components().size(), 2u);
+			EXPECT_EQ(motd.components()[1].text, " world");
+			EXPECT_EQ(motd.plain_text(), "Hello world");
+		});
+	}
+}
+
+TEST(ThreadSafetyTest, SharedMonitor) {
+	using std::chrono::milliseconds;
+	StubServer stub{
+	    R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":1},"description":"x"})"};
+	boost::asio::io_context io_context;
+	Monitor monitor{io_context.get_executor(), {.tick = milliseconds{1}}};
+	std::atomic<std::size_t> results{0};
+
+	monitor.subscribe([&](const Monitor::Result& result) {
+		EXPECT_TRUE(result.latency.has_value());
+		++results;
+	});
+	// Keeps the io_context running while targets come and go
+	const Monitor::target_id_t steady = monitor.add(JavaServer{stub.endpoint()}, {.interval = milliseconds{5}});
+	std::thread runner{[&] { io_context.run_for(milliseconds{500}); }};
+
+	run_concurrently([&] {
+		for (int i = 0; i < iterations; ++i) {
+			const Monitor::target_id_t target = monitor.add(JavaServer{stub.endpoint()}, {.interval = milliseconds{2}});
+			EXPECT_TRUE(monitor.update(target, {.query = Monitor::Query::ping, .interval = milliseconds{1}}));
+			std::this_thread::sleep_for(milliseconds{2});
+			EXPECT_TRUE(monitor.remove(target));
+		}
+	});
+
+	runner.join();
+	EXPECT_EQ(monitor.size(), 1u);
+	EXPECT_TRUE(monitor.remove(steady));
+	EXPECT_GT(results, 0u);
+}
@@ -0,0 +1,119 @@
+#include "libmcstatus/impl/TimerWheel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace libmcstatus::_impl;
+
+TEST(TimerWheelTest, ExpiresInOrder) {
+	TimerWheel wheel;
+	wheel.schedule(5, {.id = 2});
+	wheel.schedule(3, {.id = 1});
+	wheel.schedule(300, {.id = 3});
+	EXPECT_EQ(wheel.size(), 3u);
+
+	std::vector<TimerWheel::Timer> expired;
+	wheel.advance(4, expired);
+	ASSERT_EQ(expired.size(), 1u);
+	EXPECT_EQ(expired[0].id, 1u);
+
+	wheel.advance(299, expired);
+	ASSERT_EQ(expired.size(), 2u);
+	EXPECT_EQ(expired[1].id, 2u);
+
+	wheel.advance(300, expired);
+	ASSERT_EQ(expired.size(), 3u);
+	EXPECT_EQ(expired[2].id, 3u);
+	EXPECT_EQ(wheel.size(), 0u);
+	EXPECT_EQ(wheel.now(), 300u);
+}
+
+TEST(TimerWheelTest, PastTimersAreDueNextTick) {
+	TimerWheel wheel{100};
+	wheel.schedule(50, {.id = 1, .generation = 7});
+
+	std::vector<TimerWheel::Timer> expired;
+	wheel.advance(101, expired);
+
+	ASSERT_EQ(expired.size(), 1u);
+	EXPECT_EQ(expired[0].generation, 7u);
+}
+
+TEST(TimerWheelTest, CascadesAcrossAllLevels) {
+	// Every timer has to come out exactly at its tick, including the ones that pass through several levels
+	std::mt19937_64 rng{42};
+	TimerWheel wheel{12345};
+	std::vector<std::pair<TimerWheel::tick_t, std::uint64_t>> timers;
+
+	for (std::uint64_t id = 0; id < 2000; ++id) {
+		const int bits = static_cast<int>(rng() % 26);
+		const TimerWheel::tick_t due = wheel.now() + 1 + (rng() & ((TimerWheel::tick_t{1} << bits) - 1));
+		timers.emplace_back(due, id);
+		wheel.schedule(due, {.id = id});
+	}
+	std::ranges::sort(timers);
+
+	std::vector<TimerWheel::Timer> expired;
+	for (auto first = timers.begin(); first != timers.end();) {
+		const TimerWheel::tick_t due = first->first;
+		const auto last =
+		    std::ranges::find_if(first, timers.end(), [&](const auto& timer) { return timer.first != due; });
+
+		// Jump right before the tick, then step onto it
+		wheel.advance(due - 1, expired);
+		ASSERT_TRUE(expired.empty()) << "Timer " << expired.front().id << " expired before " << due;
+
+		wheel.advance(due, expired);
+		std::vector<std::uint64_t> ids;
+		for (const TimerWheel::Timer& timer : expired) {
+			ids.push_back(timer.id);
+		}
+		std::ranges::sort(ids);
+
+		std::vector<std::uint64_t> expected;
+		for (auto timer = first; timer != last; ++timer) {
+			expected.push_back(timer->second);
+		}
+		ASSERT_EQ(ids, expected) << "at " << due;
+
+		expired.clear();
+		first = last;
+	}
+
+	EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST(TimerWheelTest, NextTick) {
+	TimerWheel wheel;
+	EXPECT_FALSE(wheel.next_tick().has_value());
+
+	wheel.schedule(10, {.id = 1});
+	EXPECT_EQ(wheel.next_tick(), 10u);
+
+	// Timers of the upper levels are cascaded once the wheel below comes around to them
+	TimerWheel far;
+	far.schedule(1000, {.id = 1});
+	EXPECT_EQ(far.next_tick(), 768u);
+
+	std::vector<TimerWheel::Timer> expired;
+	far.advance(768, expired);
+	EXPECT_TRUE(expired.empty());
+	EXPECT_EQ(far.next_tick(), 1000u);
+}
+
+TEST(TimerWheelTest, FarTimersAreClamped) {
+	TimerWheel wheel;
+	wheel.schedule(~TimerWheel::tick_t{0}, {.id = 1});
+
+	std::vector<TimerWheel::Timer> expired;
+	wheel.advance(TimerWheel::MAX_DELAY - 1, expired);
+	EXPECT_TRUE(expired.empty());
+
+	wheel.advance(TimerWheel::MAX_DELAY, expired);
+	EXPECT_EQ(expired.size(), 1u);
+}
@@ -0,0 +1,141 @@
+#include "libmcstatus/TrafficLog.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "MemoryServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+namespace {
+
+class TrafficLogTest : public testing::Test {
+protected:
+	const std::filesystem::path path{std::filesystem::temp_directory_path() /
+	                                 ("libmcstatus-test-" + std::to_string(getpid()) + ".log")};
+
+	void SetUp() override {
+		std::filesystem::remove(path);
+	}
+	void TearDown() override {
+		std::filesystem::remove(path);
+	}
+
+	// Queries the in-memory server once through a RecordingTransport
+	void record_status(const std::string& status) const {
+		const auto log = std::make_shared<TrafficLog>(path);
+		const JavaServer server{std::make_shared<RecordingTransport>(memory_server::transport(status), log)};
+
+		ASSERT_TRUE(server.try_status(1s).has_value());
+	}
+};
+
+}  // namespace
+
+TEST_F(TrafficLogTest, RecordsRawBytes) {
+	const auto before = std::chrono::system_clock::now();
+	record_status(std::string{memory_server::DEFAULT_STATUS});
+
+	const auto records = TrafficLog::try_read(path);
+
+	ASSERT_TRUE(records.has_value());
+	ASSERT_EQ(records->size(), 1u);
+
+	const TrafficRecord& record = records->front();
+	McPacket status_frame;
+	status_frame.write_varint(0);
+	status_frame.write_utf(memory_server::DEFAULT_STATUS);
+
+	EXPECT_EQ(record.endpoint, "memory");
+	EXPECT_GE(record.time, std::chrono::time_point_cast<std::chrono::microseconds>(before));
+	EXPECT_EQ(record.received, status_frame.write_to_buffer());
+	EXPECT_EQ(record.sent.back(), 0);  // The status request is the last thing sent, after the handshake
+}
+
+TEST_F(TrafficLogTest, AppendsToExistingLogs) {
+	record_status(std::string{memory_server::DEFAULT_STATUS});
+	record_status(std::string{memory_server::DEFAULT_STATUS});
+
+	const auto records = TrafficLog::try_read(path);
+
+	ASSERT_TRUE(records.has_value());
+	EXPECT_EQ(records->size(), 2u);
+}
+
+TEST_F(TrafficLogTest, ReplaysRecordedStatus) {
+	const std::string status =
+	    R"({"version":{"name":"Replayed","protocol":765},"players":{"max":10,"online":7},"description":"Old"})";
+	record_status(status);
+
+	const JavaServer server{std::make_shared<ReplayTransport>(TrafficLog::try_read(path).value())};
+
+	for (int i = 0; i < 3; ++i) {
+		const auto replayed = server.try_status(1s);
+
+		ASSERT_TRUE(replayed.has_value()) << to_string(replayed.error());
+		EXPECT_EQ((*replayed)->version->name, "Replayed");
+		EXPECT_EQ((*replayed)->players->online, 7);
+	}
+}
+
+TEST_F(TrafficLogTest, KeepsRecordsLargerThanPackets) {
+	const auto size = static_cast<std::size_t>(McPacket::MAX_PACKET_SIZE) * 2;
+	const TrafficRecord large{.endpoint = "large", .sent = {1, 2, 3}, .received = McPacket::buffer_t(size, 7)};
+	TrafficLog{path}.append(large);
+	record_status(std::string{memory_server::DEFAULT_STATUS});
+
+	std::vector<std::string> endpoints;
+	const auto count = TrafficLog::try_for_each(path, [&](TrafficRecord&& record) {
+		if (record.endpoint == "large") {
+			EXPECT_EQ(record.sent, large.sent);
+			EXPECT_EQ(record.received, large.received);
+		}
+		endpoints.push_back(std::move(record.endpoint));
+	});
+
+	ASSERT_TRUE(count.has_value());
+	EXPECT_EQ(*count, 2u);
+	EXPECT_EQ(endpoints, (std::vector<std::string>{"large", "memory"}));
+}
+
+TEST(TrafficLogFailureTest, FlushReportsWriteErrors) {
+	if (!std::filesystem::exists("/dev/full")) {
+		GTEST_SKIP() << "Needs /dev/full";
+	}
+
+	TrafficLog log{"/dev/full"};
+	log.append({.endpoint = "full"});
+
+	EXPECT_THROW(log.flush(), std::system_error);
+}
+
+TEST_F(TrafficLogTest, RejectsCorruptLogs) {
+	EXPECT_EQ(TrafficLog::try_read(path).error(), McError::bad_frame);  // Missing
+
+	std::ofstream{path} << "not a traffic log";
+	EXPECT_EQ(TrafficLog::try_read(path).error(), McError::bad_frame);
+
+	std::filesystem::remove(path);
+	record_status(std::string{memory_server::DEFAULT_STATUS});
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+	EXPECT_EQ(TrafficLog::try_read(path).error(), McError::bad_frame);
+}
+
+TEST(ReplayTransportTest, NothingToReplay) {
+	const JavaServer server{std::make_shared<ReplayTransport>(std::vector<TrafficRecord>{})};
+
+	const auto result = server.try_status(1s, RetryPolicy{.max_attempts = 1});
+
+	ASSERT_FALSE(result.has_value());
+	EXPECT_EQ(result.error(), McError::connection_refused);
+}
@@ -0,0 +1,123 @@
+#include "libmcstatus/Transport.hpp"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <array>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/McPacket.hpp"
+#include "MemoryServer.hpp"
+
+using namespace libmcstatus;
+using namespace std::chrono_literals;
+
+TEST(TransportTest, MemoryTransportStatus) {
+	const JavaServer server{memory_server::transport()};
+
+	const auto status = server.try_status(1s);
+
+	ASSERT_TRUE(status.has_value()) << to_string(status.error());
+	EXPECT_EQ((*status)->players->online, 3);
+	EXPECT_EQ((*status)->motd, "In memory");
+	EXPECT_EQ(server.to_string(), "memory");
+}
+
+TEST(TransportTest, MemoryTransportPing) {
+	const JavaServer server{memory_server::transport()};
+
+	EXPECT_TRUE(server.try_ping(1s).has_value());
+}
+
+TEST(TransportTest, MemoryTransportReadsLargeFrames) {
+	const std::string status = R"({"version":{"name":"1.20.4","protocol":765},"players":{"max":20,"online":0},)"
+	                           R"("favicon":")" +
+	                           std::string(256 * 1024, 'x') + R"("})";
+	const JavaServer server{memory_server::transport(status)};
+
+	const auto result = server.try_status(1s);
+
+	ASSERT_TRUE(result.has_value()) << to_string(result.error());
+	EXPECT_EQ((*result)->icon->size(), 256u * 1024u);
+}
+
+TEST(TransportTest, MemoryTransportTimesOut) {
+	const auto silent = std::make_shared<MemoryTransport>(
+	    [](std::shared_ptr<Transport::Connection> connection) -> boost::asio::awaitable<void> {
+		    std::array<std::uint8_t, 256> buffer;
+		    while (co_await connection->async_read_some(boost::asio::buffer(buffer))) {
+		    }
+	    });
+	const JavaServer server{silent};
+
+	const auto result = server.try_status(50ms, RetryPolicy{.max_attempts = 1});
+
+	ASSERT_FALSE(result.has_value());
+	EXPECT_EQ(result.error(), McError::timeout);
+}
+
+TEST(TransportTest, MemoryTransportReportsClosedConnection) {
+	const auto closing = std::make_shared<MemoryTransport>(
+	    [](std::shared_ptr<Transport::Connection> connection) -> boost::asio::awaitable<void> {
+		    connection->close();
+		    co_return;
+	    });
+	const JavaServer server{closing};
+
+	const auto result = server.try_status(1s, RetryPolicy{.max_attempts = 1});
+
+	ASSERT_FALSE(result.has_value());
+	EXPECT_EQ(result.error(), McError::connection_reset);
+}
+
+TEST(TransportTest, UnixTransportStatus) {
+	const std::string path = "/tmp/libmcstatus-test-" + std::to_string(getpid()) + ".sock";
+	::unlink(path.c_str());
+
+	boost::asio::io_context io_context;
+	boost::asio::local::stream_protocol::acceptor acceptor{io_context, path};
+
+	// Answers a single status request, which ends with the request packet (length 1, id 0)
+	std::thread server_thread{[&] {
+		boost::asio::local::stream_protocol::socket socket{io_context};
+		acceptor.accept(socket);
+
+		std::vector<std::uint8_t> received;
+		std::array<std::uint8_t, 256> buffer;
+		while ((received.size() < 2) || (received[received.size() - 2] != 1) || (received.back() != 0)) {
+			const std::size_t read = socket.read_some(boost::asio::buffer(buffer));
+			received.insert(received.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(read));
+		}
+
+		McPacket response;
+		response.write_varint(0);
+		response.write_utf(memory_server::DEFAULT_STATUS);
+		boost::asio::write(socket, boost::asio::buffer(response.write_to_buffer()));
+	}};
+
+	const JavaServer server{std::make_shared<UnixTransport>(path)};
+	const auto status = server.try_status(1s, RetryPolicy{.max_attempts = 1});
+	server_thread.join();
+	::unlink(path.c_str());
+
+	ASSERT_TRUE(status.has_value()) << to_string(status.error());
+	EXPECT_EQ((*status)->players->online, 3);
+	EXPECT_EQ(server.to_string(), "unix:" + path);
+}
+
+TEST(TransportTest, UnixTransportConnectionRefused) {
+	const JavaServer server{std::make_shared<UnixTransport>("/tmp/libmcstatus-test-nonexistent.sock")};
+
+	const auto result = server.try_status(1s, RetryPolicy{.max_attempts = 1});
+
+	ASSERT_FALSE(result.has_value());
+	EXPECT_NE(result.error(), McError::timeout);
+}
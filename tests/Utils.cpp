@@ -2,7 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <boost/uuid/uuid_io.hpp>
+#include <cctype>
+#include <cstring>
+#include <random>
 #include <string>
+#include <string_view>
 
 using namespace libmcstatus::_impl;
 
@@ -77,3 +82,113 @@ TEST(ParsePortTest, LeadingZeros) {
 	EXPECT_EQ(parse_port("00443"), 443);
 	EXPECT_EQ(parse_port("000000000025565"), 25565);
 }
+
+TEST(ParseUuidTest, DashedAndPlainForms) {
+	const std::optional<boost::uuids::uuid> dashed = parse_uuid("069a79f4-44e9-4726-a5be-fca90e38aaf5");
+	const std::optional<boost::uuids::uuid> plain = parse_uuid("069A79F444E94726A5BEFCA90E38AAF5");
+
+	ASSERT_TRUE(dashed.has_value());
+	ASSERT_TRUE(plain.has_value());
+	EXPECT_EQ(*dashed, *plain);
+	EXPECT_EQ(boost::uuids::to_string(*dashed), "069a79f4-44e9-4726-a5be-fca90e38aaf5");
+}
+
+TEST(ParseUuidTest, InvalidInputs) {
+	EXPECT_FALSE(parse_uuid("").has_value());
+	EXPECT_FALSE(parse_uuid("069a79f4-44e9-4726-a5be-fca90e38aaf").has_value());    // Too short
+	EXPECT_FALSE(parse_uuid("069a79f4044e9-4726-a5be-fca90e38aaf5").has_value());   // Wrong separator
+	EXPECT_FALSE(parse_uuid("069a79f4-44e9-4726-a5be-fca90e38aazz").has_value());   // No hex digits
+	EXPECT_FALSE(parse_uuid("+69a79f444e94726a5befca90e38aaf5").has_value());      // Sign
+}
+
+TEST(HashBytesTest, TellsPayloadsApart) {
+	const std::string payload = R"({"players":{"max":20,"online":7}})";
+
+	EXPECT_EQ(hash_bytes(payload), hash_bytes(std::string{payload}));
+	EXPECT_NE(hash_bytes(payload), hash_bytes(R"({"players":{"max":20,"online":8}})"));
+	EXPECT_NE(hash_bytes(payload), hash_bytes(payload.substr(0, payload.size() - 1)));
+	EXPECT_NE(hash_bytes(""), hash_bytes(std::string_view{"\0", 1}));
+	EXPECT_NE(hash_bytes(payload, 1), hash_bytes(payload, 2));
+}
+
+TEST(DecodeHexTest, MatchesScalarDecoder) {
+	std::minstd_rand rng{42};
+	std::uniform_int_distribution<int> digit{0, 21};
+	static constexpr std::string_view HEX_DIGITS{"0123456789abcdefABCDEF"};
+
+	for (int i = 0; i < 1000; ++i) {
+		std::string digits(32, '0');
+		for (char& c : digits) {
+			c = HEX_DIGITS[static_cast<std::size_t>(digit(rng))];
+		}
+
+		std::uint8_t bytes[16];
+		std::uint8_t scalar_bytes[16];
+		ASSERT_TRUE(decode_hex(digits.data(), bytes)) << digits;
+		ASSERT_TRUE(decode_hex_scalar(digits.data(), scalar_bytes)) << digits;
+		EXPECT_EQ(std::memcmp(bytes, scalar_bytes, sizeof(bytes)), 0) << digits;
+	}
+}
+
+TEST(DecodeHexTest, RejectsEveryNonHexCharacterAnywhere) {
+	const std::string valid = "069a79f444e94726a5befca90e38aaf5";
+	std::uint8_t bytes[16];
+
+	for (int c = 0; c < 256; ++c) {
+		if (std::isxdigit(c)) {
+			continue;
+		}
+
+		for (const std::size_t position : {std::size_t{0}, std::size_t{15}, std::size_t{16}, std::size_t{31}}) {
+			std::string digits = valid;
+			digits[position] = static_cast<char>(c);
+
+			EXPECT_FALSE(decode_hex(digits.data(), bytes)) << c << " at " << position;
+			EXPECT_FALSE(decode_hex_scalar(digits.data(), bytes)) << c << " at " << position;
+		}
+	}
+}
+
+TEST(SectionSignTest, MatchesScalarSearch) {
+	for (std::size_t length = 0; length < 40; ++length) {
+		for (std::size_t position = 0; (position + 1) < length; ++position) {
+			std::string text(length, 'a');
+			text[position] = '\xC2';
+			text[position + 1] = '\xA7';
+
+			EXPECT_EQ(find_section_sign(text), position) << length;
+			EXPECT_EQ(find_section_sign_scalar(text), position) << length;
+			EXPECT_EQ(find_section_sign(text, position + 1), length) << length;
+		}
+	}
+
+	// Only the whole sequence counts
+	EXPECT_EQ(find_section_sign("\xC2\xC2\xA8\xA7 no section sign here, and some more"), 40u);
+}
+
+TEST(SectionSignTest, StripsFormattingCodes) {
+	EXPECT_EQ(strip_formatting_codes(""), "");
+	EXPECT_EQ(strip_formatting_codes("plain"), "plain");
+	EXPECT_EQ(strip_formatting_codes("\u00A7a\u00A7lA long line of green bold text \u00A7rand more"),
+	          "A long line of green bold text and more");
+	EXPECT_EQ(strip_formatting_codes("\u00A7\u20AC\u00A7"), "");
+}
+
+TEST(JsonEscapeTest, MatchesScalarSearch) {
+	for (std::size_t length = 1; length < 40; ++length) {
+		for (std::size_t position = 0; position < length; ++position) {
+			for (const char c : {'"', '\\', '\n', '\x01', '\x1F'}) {
+				std::string text(length, 'a');
+				text[position] = c;
+
+				EXPECT_EQ(find_json_escape(text), position) << length;
+				EXPECT_EQ(find_json_escape_scalar(text), position) << length;
+			}
+		}
+	}
+
+	// Neither UTF-8 nor DEL need escaping
+	const std::string text = "\x7F\xC3\xA9\xF0\x9F\x98\x80 nothing to escape here at all";
+	EXPECT_EQ(find_json_escape(text), text.size());
+	EXPECT_EQ(find_json_escape_scalar(text), text.size());
+}
@@ -0,0 +1,58 @@
+#include "libmcstatus/impl/UuidSet.hpp"
+
+#include <gtest/gtest.h>
+
+#include <boost/uuid/random_generator.hpp>
+#include <vector>
+
+using namespace libmcstatus::_impl;
+
+TEST(UuidSetTest, InsertAndContains) {
+	boost::uuids::random_generator generate;
+	std::vector<boost::uuids::uuid> ids;
+	for (int i = 0; i < 1000; ++i) {
+		ids.push_back(generate());
+	}
+
+	UuidSet set;
+	EXPECT_FALSE(set.contains(ids.front()));
+
+	for (const boost::uuids::uuid& id : ids) {
+		EXPECT_TRUE(set.insert(id));
+	}
+	for (const boost::uuids::uuid& id : ids) {
+		EXPECT_FALSE(set.insert(id));
+		EXPECT_TRUE(set.contains(id));
+	}
+
+	EXPECT_EQ(set.size(), ids.size());
+	EXPECT_FALSE(set.contains(generate()));
+
+	std::size_t visited = 0;
+	set.for_each([&](const boost::uuids::uuid&) { ++visited; });
+	EXPECT_EQ(visited, ids.size());
+}
+
+TEST(UuidSetTest, ClearKeepsOrFreesMemory) {
+	boost::uuids::random_generator generate;
+	UuidSet set;
+	set.clear(12);
+
+	const std::size_t memory = set.memory_usage();
+	EXPECT_GE(memory, 12 * sizeof(boost::uuids::uuid));
+	for (int i = 0; i < 12; ++i) {
+		set.insert(generate());
+	}
+	EXPECT_EQ(set.memory_usage(), memory);  // Reserved up front, no growing
+
+	set.clear(10);
+	EXPECT_EQ(set.size(), 0u);
+	EXPECT_EQ(set.memory_usage(), memory);
+
+	set.clear(0);
+	EXPECT_EQ(set.memory_usage(), 0u);
+
+	set.clear(100000);
+	set.clear(12);
+	EXPECT_EQ(set.memory_usage(), memory);  // Shrinks again after a huge sample
+}
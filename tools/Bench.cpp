@@ -0,0 +1,293 @@
+// Load generator for a single server. Runs ping() or status() against it from --concurrency threads for --duration
+// seconds, through the same blocking calls applications use, and reports the latency distribution and every error.
+//
+// Without --rate, every thread sends its next request as soon as the previous one is done. With --rate, requests are
+// started on a fixed schedule of that many per second, spread over all threads, and latencies are measured from the
+// time a request was scheduled to start rather than from when it was actually sent. A stalled server then shows up in
+// the latencies of all the requests it held up, not only in the one it stalled on, which corrects for coordinated
+// omission the way wrk2 does. The time the requests themselves took is reported separately as the service time.
+//
+// Usage: mcstatus-bench <host[:port]> [--mode=status|ping] [--concurrency=<n>] [--rate=<requests per second>]
+//                       [--duration=<seconds>] [--timeout=<milliseconds>]
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "libmcstatus/Histogram.hpp"
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/McError.hpp"
+
+using namespace libmcstatus;
+
+namespace {
+
+enum class Mode { status, ping };
+
+struct Options {
+	std::string target{};
+	Mode mode{Mode::status};
+	std::size_t concurrency{1};
+	std::optional<double> rate{};
+	std::chrono::duration<double> duration{10.0};
+	std::chrono::milliseconds timeout{McServer::DEFAULT_TIMEOUT};
+};
+
+struct ClientResult {
+	Histogram latencies{};  // Since the scheduled start with --rate, otherwise the same as service_times
+	Histogram service_times{};
+	// Exact, unlike the histograms
+	Histogram::duration_t min{Histogram::duration_t::max()};
+	Histogram::duration_t max{Histogram::duration_t::zero()};
+	Histogram::duration_t service_min{Histogram::duration_t::max()};
+	Histogram::duration_t service_max{Histogram::duration_t::zero()};
+	std::array<std::uint64_t, static_cast<std::size_t>(McError::unknown) + 1> errors{};
+};
+
+// The whole text has to be the number, std::nullopt otherwise
+template <typename Number>
+std::optional<Number> parse_number(std::string_view text) {
+	Number number{};
+	const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), number);
+
+	if ((ec != std::errc{}) || (end != text.data() + text.size())) {
+		return std::nullopt;
+	}
+	return number;
+}
+
+std::optional<Options> parse_options(int argc, char** argv) {
+	Options options;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+		const std::size_t equals = arg.find('=');
+		const std::string_view name = arg.substr(0, equals);
+		const std::string value{(equals == std::string_view::npos) ? "" : arg.substr(equals + 1)};
+
+		if (!arg.starts_with("--") && options.target.empty()) {
+			options.target = arg;
+		} else if ((arg == "--mode=status") || (arg == "--mode=ping")) {
+			options.mode = (value == "ping") ? Mode::ping : Mode::status;
+		} else if (name == "--concurrency") {
+			const std::optional<std::size_t> concurrency = parse_number<std::size_t>(value);
+			if (!concurrency) {
+				std::cerr << "Invalid number in " << arg << "\n";
+				return std::nullopt;
+			}
+			options.concurrency = std::max<std::size_t>(*concurrency, 1);
+		} else if (name == "--rate") {
+			options.rate = parse_number<double>(value);
+			if (!options.rate) {
+				std::cerr << "Invalid number in " << arg << "\n";
+				return std::nullopt;
+			}
+		} else if (name == "--duration") {
+			const std::optional<double> duration = parse_number<double>(value);
+			if (!duration || (*duration < 0.0)) {
+				std::cerr << "Invalid duration in " << arg << "\n";
+				return std::nullopt;
+			}
+			options.duration = std::chrono::duration<double>{*duration};
+		} else if (name == "--timeout") {
+			const std::optional<std::chrono::milliseconds::rep> timeout =
+			    parse_number<std::chrono::milliseconds::rep>(value);
+			if (!timeout || (*timeout < 0)) {
+				std::cerr << "Invalid timeout in " << arg << "\n";
+				return std::nullopt;
+			}
+			options.timeout = std::chrono::milliseconds{*timeout};
+		} else {
+			std::cerr << "Unknown option " << arg << "\n";
+			return std::nullopt;
+		}
+	}
+
+	if (options.target.empty() || (options.rate && (*options.rate <= 0.0))) {
+		std::cerr << "Usage: mcstatus-bench <host[:port]> [--mode=status|ping] [--concurrency=<n>] [--rate=<n>] "
+		             "[--duration=<seconds>] [--timeout=<milliseconds>]\n";
+		return std::nullopt;
+	}
+
+	return options;
+}
+
+// Requests handed out to all threads. Without a rate, they are due right away
+class Schedule {
+public:
+	Schedule(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end,
+	         std::optional<double> rate)
+	    : start{start}, end{end} {
+		if (rate) {
+			interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			    std::chrono::duration<double>{1.0 / *rate});
+		}
+	}
+
+	// When the next request should be sent, empty once the duration is over
+	std::optional<std::chrono::steady_clock::time_point> next() {
+		if (!interval) {
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			return (now < end) ? std::optional{now} : std::nullopt;
+		}
+
+		const std::chrono::steady_clock::time_point due =
+		    start + (*interval * static_cast<std::int64_t>(requests.fetch_add(1, std::memory_order_relaxed)));
+		return (due < end) ? std::optional{due} : std::nullopt;
+	}
+
+private:
+	std::chrono::steady_clock::time_point start;
+	std::chrono::steady_clock::time_point end;
+	std::optional<std::chrono::steady_clock::duration> interval{};
+	std::atomic<std::uint64_t> requests{0};
+};
+
+ClientResult run_client(const JavaServer& server, const Options& options, Schedule& schedule) {
+	const RetryPolicy no_retries{.max_attempts = 1};
+	ClientResult result;
+
+	while (const std::optional<std::chrono::steady_clock::time_point> due = schedule.next()) {
+		std::this_thread::sleep_until(*due);
+
+		const std::chrono::steady_clock::time_point sent = std::chrono::steady_clock::now();
+		std::optional<McError> error;
+		if (options.mode == Mode::ping) {
+			if (const McServer::result_t<McServer::latency_t> latency = server.try_ping(options.timeout, no_retries);
+			    !latency) {
+				error = latency.error();
+			}
+		} else {
+			if (const auto status = server.try_status(options.timeout, no_retries); !status) {
+				error = status.error();
+			}
+		}
+		const std::chrono::steady_clock::time_point done = std::chrono::steady_clock::now();
+
+		if (error) {
+			++result.errors[static_cast<std::size_t>(*error)];
+			continue;
+		}
+
+		const Histogram::duration_t latency = done - std::min(*due, sent);
+		result.latencies.record(latency);
+		result.min = std::min(result.min, latency);
+		result.max = std::max(result.max, latency);
+		result.service_times.record(done - sent);
+		result.service_min = std::min(result.service_min, done - sent);
+		result.service_max = std::max(result.service_max, done - sent);
+	}
+
+	return result;
+}
+
+std::string format_latency(Histogram::duration_t latency) {
+	std::ostringstream out;
+	out << std::fixed << std::setprecision(1) << std::chrono::duration<double, std::milli>{latency}.count() << "ms";
+	return out.str();
+}
+
+void print_distribution(std::string_view label, const Histogram& histogram, Histogram::duration_t min,
+                        Histogram::duration_t max) {
+	std::cout << std::left << std::setw(10) << label << std::right;
+
+	// Percentiles are the upper bounds of their buckets, which may lie past the largest value in them
+	for (const double percentile : {0.0, 0.5, 0.9, 0.99, 0.999, 1.0}) {
+		std::cout << std::setw(11) << format_latency(std::clamp(histogram.percentile(percentile), min, max));
+	}
+	std::cout << "\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	const std::optional<Options> options = parse_options(argc, argv);
+	if (!options) {
+		return 1;
+	}
+
+	const McServer::result_t<JavaServer> server = JavaServer::try_lookup(options->target);
+	if (!server) {
+		std::cerr << "Failed to resolve " << options->target << ": " << to_string(server.error()) << "\n";
+		return 1;
+	}
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	Schedule schedule{start, start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(options->duration),
+	                  options->rate};
+	std::vector<ClientResult> results(options->concurrency);
+	std::vector<std::thread> threads;
+
+	for (std::size_t i = 0; i < options->concurrency; ++i) {
+		threads.emplace_back([&, i] { results[i] = run_client(*server, *options, schedule); });
+	}
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	const std::chrono::duration<double> wall_time = std::chrono::steady_clock::now() - start;
+	ClientResult total;
+	for (const ClientResult& result : results) {
+		total.latencies.merge(result.latencies);
+		total.service_times.merge(result.service_times);
+		total.min = std::min(total.min, result.min);
+		total.max = std::max(total.max, result.max);
+		total.service_min = std::min(total.service_min, result.service_min);
+		total.service_max = std::max(total.service_max, result.service_max);
+		for (std::size_t error = 0; error < total.errors.size(); ++error) {
+			total.errors[error] += result.errors[error];
+		}
+	}
+	if (total.latencies.count == 0) {
+		total.min = Histogram::duration_t::zero();
+		total.service_min = Histogram::duration_t::zero();
+	}
+
+	std::uint64_t failures = 0;
+	for (const std::uint64_t count : total.errors) {
+		failures += count;
+	}
+	const std::uint64_t requests = total.latencies.count + failures;
+
+	std::cout << server->to_string() << " mode=" << ((options->mode == Mode::ping) ? "ping" : "status")
+	          << " concurrency=" << options->concurrency;
+	if (options->rate) {
+		std::cout << " rate=" << *options->rate << "/s";
+	}
+	std::cout << std::fixed << std::setprecision(1) << " duration=" << wall_time.count() << "s\n"
+	          << requests << " requests, " << total.latencies.count << " succeeded, " << failures << " failed, "
+	          << static_cast<double>(requests) / wall_time.count() << " requests/s\n\n";
+
+	std::cout << std::left << std::setw(10) << "" << std::right;
+	for (const std::string_view column : {"min", "p50", "p90", "p99", "p99.9", "max"}) {
+		std::cout << std::setw(11) << column;
+	}
+	std::cout << "\n";
+	print_distribution("latency", total.latencies, total.min, total.max);
+	if (options->rate) {
+		print_distribution("service", total.service_times, total.service_min, total.service_max);
+	}
+
+	if (failures > 0) {
+		std::cout << "\nErrors:\n";
+		for (std::size_t error = 1; error < total.errors.size(); ++error) {
+			if (total.errors[error] > 0) {
+				std::cout << "  " << std::left << std::setw(20) << to_string(static_cast<McError>(error)) << std::right
+				          << total.errors[error] << "\n";
+			}
+		}
+	}
+
+	return 0;
+}
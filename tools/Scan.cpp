@@ -0,0 +1,696 @@
+// Command-line scanner. Reads targets, one per line, from a file (memory-mapped) or stdin (streamed), queries their
+// status and writes every result as it comes in, as NDJSON (see StatusWriter.hpp) or, with --format=store, as a
+// ResultStore file (see ResultStore.hpp, failures are left out) once the scan is done. A target is either host[:port],
+// which is looked up like JavaServer::try_lookup() does (SRV records included when there is no port), or an IPv4 range
+// a.b.c.d/prefix[:port]. Ranges and addresses without a port are queried on every port of --ports. Empty lines and
+// lines starting with # are skipped.
+//
+// At most --concurrency queries run at a time, spread over --threads io_contexts. Lookups of host names block, so they
+// run on --resolvers threads of their own. After --deadline no new queries are started, the ones in flight still end
+// within their timeout. Throughput is printed to stderr every second, unless --quiet is given.
+//
+// Targets from stdin are read on a thread of their own, so a slow producer never holds up the queries in flight.
+//
+// Usage: mcstatus-scan [--input=<file>] [--output=<file>] [--format=ndjson|store] [--ports=<port>[,<port>...]]
+//                      [--concurrency=<n>] [--threads=<n>] [--resolvers=<n>] [--timeout=<milliseconds>]
+//                      [--attempts=<n>] [--deadline=<seconds>] [--quiet]
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <expected>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "libmcstatus/JavaServer.hpp"
+#include "libmcstatus/JavaStatusView.hpp"
+#include "libmcstatus/ResultStore.hpp"
+#include "libmcstatus/StatusWriter.hpp"
+
+using namespace libmcstatus;
+
+namespace {
+
+using boost::asio::ip::port_type;
+
+struct Target {
+	std::string address;  // As written to the results, host:port for ranges
+	// Set for IP addresses, which need no lookup
+	std::optional<boost::asio::ip::tcp::endpoint> endpoint{};
+};
+
+std::optional<port_type> parse_port(std::string_view text) {
+	port_type port = 0;
+	const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), port);
+
+	if ((ec != std::errc{}) || (end != text.data() + text.size()) || (port == 0)) {
+		return std::nullopt;
+	}
+	return port;
+}
+
+// Same as parse_port(), for the other numeric options
+template <typename Number>
+std::optional<Number> parse_number(std::string_view text) {
+	Number number{};
+	const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), number);
+
+	if ((ec != std::errc{}) || (end != text.data() + text.size())) {
+		return std::nullopt;
+	}
+	return number;
+}
+
+// Parses the value of --name=<value> into value, printing an error if it isn't a number of at least minimum
+template <typename Number>
+bool parse_option(std::string_view arg, Number minimum, Number& value) {
+	const std::optional<Number> number = parse_number<Number>(arg.substr(arg.find('=') + 1));
+
+	if (!number || (*number < minimum)) {
+		std::cerr << "Invalid value in " << arg << "\n";
+		return false;
+	}
+	value = *number;
+	return true;
+}
+
+// Reads stdin line by line on a thread of its own into a bounded queue. Workers waiting for the next line park a timer,
+// which gets cancelled once there is one, instead of blocking their io_context
+class StdinLines {
+public:
+	static constexpr std::size_t CAPACITY{4096};
+
+	enum class Next : std::uint8_t { line, empty, end };
+
+	// The reader thread may still be blocked on stdin when the scan ends (at the deadline), so it is detached and keeps
+	// the queue alive on its own
+	StdinLines() : queue{std::make_shared<Queue>()} {
+		std::thread{[queue = queue] { queue->read(); }}.detach();
+	}
+
+	// Never blocks. If the queue is empty, the waiter gets cancelled on its own executor once a line arrives or stdin
+	// ends
+	Next try_pop(std::string& line, const std::shared_ptr<boost::asio::steady_timer>& waiter) {
+		std::lock_guard lock{queue->mutex};
+
+		if (!queue->lines.empty()) {
+			line = std::move(queue->lines.front());
+			queue->lines.pop_front();
+			queue->not_full.notify_one();
+			return Next::line;
+		}
+		if (queue->ended) {
+			return Next::end;
+		}
+
+		queue->waiters.push_back(waiter);
+		return Next::empty;
+	}
+
+private:
+	struct Queue {
+		std::mutex mutex{};
+		std::condition_variable not_full{};
+		std::deque<std::string> lines{};
+		std::vector<std::shared_ptr<boost::asio::steady_timer>> waiters{};
+		bool ended{false};
+
+		void read() {
+			std::string line;
+
+			while (true) {
+				const bool read_line = static_cast<bool>(std::getline(std::cin, line));
+				std::vector<std::shared_ptr<boost::asio::steady_timer>> woken;
+				{
+					std::unique_lock lock{mutex};
+					if (read_line) {
+						not_full.wait(lock, [&] { return lines.size() < CAPACITY; });
+						lines.push_back(std::move(line));
+					} else {
+						ended = true;
+					}
+					woken.swap(waiters);
+				}
+
+				// Timers aren't thread-safe, so they're cancelled on the io_context they wait on
+				for (const std::shared_ptr<boost::asio::steady_timer>& waiter : woken) {
+					boost::asio::post(waiter->get_executor(), [waiter] { waiter->cancel(); });
+				}
+				if (!read_line) {
+					return;
+				}
+			}
+		}
+	};
+
+	std::shared_ptr<Queue> queue;
+};
+
+// Lines of the input, expanded into targets. Thread-safe, every target is handed out once
+class Targets {
+public:
+	Targets(const std::string& path, std::vector<port_type> ports, std::chrono::steady_clock::time_point deadline)
+	    : ports{std::move(ports)}, deadline{deadline} {
+		if (path.empty()) {
+			stdin_lines.emplace();
+			return;
+		}
+
+		const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		struct stat file_stat{};
+		if ((fd < 0) || (fstat(fd, &file_stat) != 0)) {
+			throw std::runtime_error{"Failed to open \"" + path + "\""};
+		}
+
+		length = static_cast<std::size_t>(file_stat.st_size);
+		mapping = (length > 0) ? mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+		close(fd);
+
+		if (mapping == MAP_FAILED) {
+			throw std::runtime_error{"Failed to map \"" + path + "\""};
+		}
+		madvise(mapping, length, MADV_SEQUENTIAL);
+		remaining = {static_cast<const char*>(mapping), length};
+	}
+
+	Targets(const Targets&) = delete;
+	Targets& operator=(const Targets&) = delete;
+
+	~Targets() {
+		if ((mapping != nullptr) && (mapping != MAP_FAILED)) {
+			munmap(mapping, length);
+		}
+	}
+
+	// Empty once the input is exhausted or the deadline has passed. While stdin has nothing new, the calling coroutine
+	// waits for it without blocking its io_context
+	boost::asio::awaitable<std::optional<Target>> next() {
+		while (std::chrono::steady_clock::now() < deadline) {
+			// Expires at the deadline at the latest, so waiting workers still stop on time
+			const auto waiter =
+			    std::make_shared<boost::asio::steady_timer>(co_await boost::asio::this_coro::executor, deadline);
+
+			if (std::optional<Target> target = try_next(waiter)) {
+				co_return target;
+			}
+			if (exhausted()) {
+				co_return std::nullopt;
+			}
+
+			boost::system::error_code ignored;
+			co_await waiter->async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ignored));
+		}
+
+		co_return std::nullopt;
+	}
+
+	[[nodiscard]] std::size_t invalid() const {
+		std::lock_guard lock{mutex};
+		return invalid_lines;
+	}
+
+private:
+	std::vector<port_type> ports;
+	std::chrono::steady_clock::time_point deadline;
+
+	void* mapping{nullptr};
+	std::size_t length{0};
+	std::string_view remaining{};
+	std::optional<StdinLines> stdin_lines{};
+	std::string stdin_line{};
+
+	mutable std::mutex mutex{};
+	bool ended{false};
+	std::size_t line_number{0};
+	std::size_t invalid_lines{0};
+	// Targets of the current line, in reverse order
+	std::vector<Target> pending{};
+	// The current range, walked address by address for every port (so consecutive queries go to different hosts)
+	std::uint64_t range_first{1};
+	std::uint64_t range_next{1};
+	std::uint64_t range_last{0};
+	std::size_t range_port{0};
+	std::optional<port_type> range_explicit_port{};
+
+	// Empty if stdin has nothing new for now (then the waiter gets cancelled once it has) or the input is exhausted
+	std::optional<Target> try_next(const std::shared_ptr<boost::asio::steady_timer>& waiter) {
+		std::lock_guard lock{mutex};
+
+		while (true) {
+			if (range_next <= range_last) {
+				return next_in_range();
+			}
+			if (!pending.empty()) {
+				Target target = std::move(pending.back());
+				pending.pop_back();
+				return target;
+			}
+
+			const std::optional<std::string_view> line = next_line(waiter);
+			if (!line) {
+				return std::nullopt;
+			}
+			add(*line);
+		}
+	}
+
+	[[nodiscard]] bool exhausted() const {
+		std::lock_guard lock{mutex};
+		return ended && (range_next > range_last) && pending.empty();
+	}
+
+	// Sets ended once the input is exhausted
+	std::optional<std::string_view> next_line(const std::shared_ptr<boost::asio::steady_timer>& waiter) {
+		while (true) {
+			std::string_view line;
+
+			if (mapping != nullptr) {
+				if (remaining.empty()) {
+					ended = true;
+					return std::nullopt;
+				}
+				const std::size_t newline = remaining.find('\n');
+				line = remaining.substr(0, newline);
+				remaining.remove_prefix((newline == std::string_view::npos) ? remaining.size() : newline + 1);
+			} else if (stdin_lines) {
+				const StdinLines::Next next = stdin_lines->try_pop(stdin_line, waiter);
+				if (next != StdinLines::Next::line) {
+					ended = next == StdinLines::Next::end;
+					return std::nullopt;
+				}
+				line = stdin_line;
+			} else {
+				// An empty file, which isn't mapped
+				ended = true;
+				return std::nullopt;
+			}
+			++line_number;
+
+			while (!line.empty() && ((line.back() == '\r') || (line.back() == ' ') || (line.back() == '\t'))) {
+				line.remove_suffix(1);
+			}
+			while (!line.empty() && ((line.front() == ' ') || (line.front() == '\t'))) {
+				line.remove_prefix(1);
+			}
+
+			if (!line.empty() && !line.starts_with('#')) {
+				return line;
+			}
+		}
+	}
+
+	void add(std::string_view line) {
+		const std::size_t colon = line.find(':');
+		const std::string_view host = line.substr(0, colon);
+		std::optional<port_type> port;
+
+		if (colon != std::string_view::npos) {
+			port = parse_port(line.substr(colon + 1));
+			if (!port) {
+				return skip(line);
+			}
+		}
+
+		if (const std::size_t slash = host.find('/'); slash != std::string_view::npos) {
+			return add_range(host.substr(0, slash), host.substr(slash + 1), port, line);
+		}
+
+		boost::system::error_code ec;
+		const boost::asio::ip::address address = boost::asio::ip::make_address(host, ec);
+
+		if (ec.failed()) {
+			// Looked up later on, with the port left out SRV records are tried first
+			pending.push_back({.address = std::string{line}});
+		} else if (port) {
+			pending.push_back(
+			    {.address = std::string{line}, .endpoint = boost::asio::ip::tcp::endpoint{address, *port}});
+		} else {
+			for (auto each = ports.rbegin(); each != ports.rend(); ++each) {
+				pending.push_back({.address = std::string{host} + ':' + std::to_string(*each),
+				                   .endpoint = boost::asio::ip::tcp::endpoint{address, *each}});
+			}
+		}
+	}
+
+	void add_range(std::string_view address, std::string_view prefix, std::optional<port_type> port,
+	               std::string_view line) {
+		boost::system::error_code ec;
+		const boost::asio::ip::address_v4 first = boost::asio::ip::make_address_v4(std::string{address}, ec);
+		unsigned bits = 33;
+		std::from_chars(prefix.data(), prefix.data() + prefix.size(), bits);
+
+		if (ec.failed() || (bits > 32)) {
+			return skip(line);
+		}
+
+		const std::uint64_t size = std::uint64_t{1} << (32 - bits);
+		range_first = first.to_uint() & ~(size - 1);
+		range_next = range_first;
+		range_last = range_first + size - 1;
+		range_port = 0;
+		range_explicit_port = port;
+	}
+
+	Target next_in_range() {
+		const port_type port = range_explicit_port ? *range_explicit_port : ports[range_port];
+		const boost::asio::ip::address_v4 address{static_cast<std::uint32_t>(range_next)};
+
+		if (range_next < range_last) {
+			++range_next;
+		} else if (!range_explicit_port && (++range_port < ports.size())) {
+			range_next = range_first;
+		} else {
+			range_next = range_last + 1;
+		}
+
+		return {.address = address.to_string() + ':' + std::to_string(port),
+		        .endpoint = boost::asio::ip::tcp::endpoint{address, port}};
+	}
+
+	void skip(std::string_view line) {
+		++invalid_lines;
+		std::cerr << "Skipping invalid target on line " << line_number << ": " << line << "\n";
+	}
+};
+
+// Where results go, shared by all threads
+class Output {
+public:
+	Output(const std::string& path, bool store) : path{path}, store{store} {
+		if (store) {
+			if (path.empty()) {
+				throw std::runtime_error{"--format=store needs an --output file"};
+			}
+			return;
+		}
+
+		fd = path.empty() ? STDOUT_FILENO : open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd < 0) {
+			throw std::runtime_error{"Failed to open \"" + path + "\""};
+		}
+		writer.emplace(fd);
+	}
+
+	Output(const Output&) = delete;
+	Output& operator=(const Output&) = delete;
+
+	~Output() {
+		writer.reset();
+		if (fd > STDOUT_FILENO) {
+			close(fd);
+		}
+	}
+
+	// Parses outside of the lock, so that threads only wait for each other while appending
+	void write(const std::string& address, McServer::result_t<JavaServer::RawStatus> raw_status, bool& online) {
+		if (!raw_status) {
+			online = false;
+			if (writer) {
+				std::lock_guard lock{mutex};
+				writer->write(address, raw_status.error());
+			}
+			return;
+		}
+
+		if (store) {
+			const McServer::result_t<std::unique_ptr<JavaServer::JavaServerResponse>> status =
+			    JavaServer::try_parse_status(*raw_status);
+			online = status.has_value();
+			if (status) {
+				std::lock_guard lock{mutex};
+				results.append(address, std::chrono::system_clock::now(), **status);
+			}
+			return;
+		}
+
+		const McServer::latency_t latency = raw_status->latency;
+		std::expected<JavaStatusView, McError> status =
+		    JavaStatusView::try_parse(std::move(raw_status->buffer), raw_status->offset, raw_status->size);
+		online = status.has_value();
+
+		std::lock_guard lock{mutex};
+		if (status) {
+			status->latency = latency;
+			writer->write(address, *status);
+		} else {
+			writer->write(address, status.error());
+		}
+	}
+
+	// Throws if anything couldn't be written
+	void finish() {
+		if (writer) {
+			writer->flush();
+		} else {
+			results.write(path);
+		}
+	}
+
+private:
+	std::string path;
+	bool store;
+	int fd{-1};
+
+	std::mutex mutex{};
+	std::optional<StatusWriter> writer{};
+	ResultStoreWriter results{};
+};
+
+struct Stats {
+	std::atomic<std::uint64_t> done{0};
+	std::atomic<std::uint64_t> online{0};
+	std::atomic<std::uint64_t> in_flight{0};
+};
+
+// Runs on the resolver pool, the optional is only there because co_spawn needs a default constructible result
+boost::asio::awaitable<std::optional<JavaServer>> lookup(std::string address) {
+	McServer::result_t<JavaServer> server = JavaServer::try_lookup(address);
+
+	if (!server) {
+		co_return std::nullopt;
+	}
+	co_return std::move(*server);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+	std::string input_path;
+	std::string output_path;
+	bool store = false;
+	std::vector<port_type> ports;
+	std::size_t concurrency = 256;
+	std::size_t threads = 1;
+	std::size_t resolvers = 16;
+	std::chrono::milliseconds timeout{McServer::DEFAULT_TIMEOUT};
+	RetryPolicy retry_policy{.max_attempts = 1};
+	std::optional<std::chrono::duration<double>> deadline;
+	bool quiet = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string_view arg{argv[i]};
+
+		if (arg.starts_with("--input=")) {
+			input_path = arg.substr(8);
+		} else if (arg.starts_with("--output=")) {
+			output_path = arg.substr(9);
+		} else if ((arg == "--format=ndjson") || (arg == "--format=store")) {
+			store = arg == "--format=store";
+		} else if (arg.starts_with("--ports=")) {
+			for (std::string_view list = arg.substr(8); !list.empty();) {
+				const std::size_t comma = list.find(',');
+				const std::optional<port_type> port = parse_port(list.substr(0, comma));
+				if (!port) {
+					std::cerr << "Invalid port in " << arg << "\n";
+					return 1;
+				}
+				ports.push_back(*port);
+				list.remove_prefix((comma == std::string_view::npos) ? list.size() : comma + 1);
+			}
+		} else if (arg.starts_with("--concurrency=")) {
+			if (!parse_option<std::size_t>(arg, 1, concurrency)) {
+				return 1;
+			}
+		} else if (arg.starts_with("--threads=")) {
+			if (!parse_option<std::size_t>(arg, 1, threads)) {
+				return 1;
+			}
+		} else if (arg.starts_with("--resolvers=")) {
+			if (!parse_option<std::size_t>(arg, 1, resolvers)) {
+				return 1;
+			}
+		} else if (arg.starts_with("--timeout=")) {
+			std::chrono::milliseconds::rep milliseconds = 0;
+			if (!parse_option<std::chrono::milliseconds::rep>(arg, 0, milliseconds)) {
+				return 1;
+			}
+			timeout = std::chrono::milliseconds{milliseconds};
+		} else if (arg.starts_with("--attempts=")) {
+			if (!parse_option<std::size_t>(arg, 1, retry_policy.max_attempts)) {
+				return 1;
+			}
+		} else if (arg.starts_with("--deadline=")) {
+			double seconds = 0.0;
+			if (!parse_option<double>(arg, 0.0, seconds)) {
+				return 1;
+			}
+			deadline = std::chrono::duration<double>{seconds};
+		} else if (arg == "--quiet") {
+			quiet = true;
+		} else {
+			std::cerr << "Unknown option " << arg << "\n";
+			return 1;
+		}
+	}
+
+	if (ports.empty()) {
+		ports.push_back(JavaServer::DEFAULT_PORT);
+	}
+	threads = std::min(threads, concurrency);
+	std::ios::sync_with_stdio(false);
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	const std::chrono::steady_clock::time_point stop =
+	    deadline ? start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(*deadline)
+	             : std::chrono::steady_clock::time_point::max();
+
+	std::optional<Targets> targets;
+	std::optional<Output> output;
+	try {
+		targets.emplace(input_path, ports, stop);
+		output.emplace(output_path, store);
+	} catch (const std::runtime_error& error) {
+		std::cerr << error.what() << "\n";
+		return 1;
+	}
+
+	boost::asio::thread_pool resolver_pool{resolvers};
+	Stats stats;
+	std::mutex exception_mutex;
+	std::exception_ptr exception;
+
+	// Every worker takes the next target as soon as its previous query is done
+	const auto worker = [&]() -> boost::asio::awaitable<void> {
+		while (std::optional<Target> target = co_await targets->next()) {
+			++stats.in_flight;
+
+			std::optional<JavaServer> server;
+			if (target->endpoint) {
+				server.emplace(*target->endpoint);
+			} else {
+				server = co_await boost::asio::co_spawn(resolver_pool, lookup(target->address),
+				                                        boost::asio::use_awaitable);
+			}
+
+			McServer::result_t<JavaServer::RawStatus> raw_status{std::unexpected{McError::resolve_failed}};
+			if (server) {
+				raw_status = co_await server->async_try_status_raw(timeout, retry_policy);
+			}
+
+			bool online = false;
+			output->write(target->address, std::move(raw_status), online);
+
+			--stats.in_flight;
+			++stats.done;
+			stats.online += online ? 1 : 0;
+		}
+	};
+
+	std::vector<std::thread> io_threads;
+	for (std::size_t thread = 0; thread < threads; ++thread) {
+		// The remainder of the concurrency goes to the first threads
+		const std::size_t workers = (concurrency / threads) + ((thread < (concurrency % threads)) ? 1 : 0);
+
+		io_threads.emplace_back([&, workers] {
+			boost::asio::io_context io_context{1};
+
+			for (std::size_t i = 0; i < workers; ++i) {
+				boost::asio::co_spawn(io_context, worker(), [&](std::exception_ptr worker_exception) {
+					std::lock_guard lock{exception_mutex};
+					if (worker_exception && !exception) {
+						exception = worker_exception;
+					}
+				});
+			}
+			io_context.run();
+		});
+	}
+
+	const auto report = [&](std::string_view label) {
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		const std::uint64_t done = stats.done;
+
+		std::cerr << std::fixed << std::setprecision(1) << label << elapsed.count() << "s: " << done << " done, "
+		          << stats.online << " online, " << stats.in_flight << " in flight, "
+		          << static_cast<double>(done) / std::max(elapsed.count(), 1e-9) << " targets/s\n";
+	};
+
+	// The io threads only end once every target is done, until then there's a progress line every second
+	std::mutex finished_mutex;
+	std::condition_variable finished_condition;
+	bool finished = false;
+	std::thread progress{[&] {
+		std::unique_lock lock{finished_mutex};
+		while (!finished_condition.wait_for(lock, std::chrono::seconds{1}, [&] { return finished; })) {
+			if (!quiet) {
+				report("");
+			}
+		}
+	}};
+
+	for (std::thread& io_thread : io_threads) {
+		io_thread.join();
+	}
+	{
+		std::lock_guard lock{finished_mutex};
+		finished = true;
+	}
+	finished_condition.notify_one();
+	progress.join();
+	resolver_pool.join();
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+
+	try {
+		output->finish();
+	} catch (const std::exception& error) {
+		std::cerr << error.what() << "\n";
+		return 1;
+	}
+
+	report("Finished after ");
+	if (const std::size_t invalid = targets->invalid(); invalid > 0) {
+		std::cerr << invalid << " invalid targets skipped\n";
+	}
+
+	return 0;
+}